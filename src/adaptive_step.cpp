@@ -0,0 +1,136 @@
+//
+//
+// Santiago Quintana Moreno A01571222
+// Created on: 18/10/2026.
+#include "adaptive_step.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+// Attempts per step before the last one is kept as is (an error that does not come down at
+// min_dt_sec, or a crossing that keeps moving)
+static const int MAX_ATTEMPTS = 24;
+
+float landingBand(float Sensors::* field) {
+    if (field == &Sensors::altitude_ft) return 0.5f;
+    if (field == &Sensors::ias_knots) return 0.05f;
+    if (field == &Sensors::vs_fpm) return 5.0f;
+    if (field == &Sensors::mach) return 0.0002f;
+    if (field == &Sensors::nz) return 0.002f;
+    return 0.02f;                       // Angles in degrees, TAT
+}
+
+// Float step from 't' that ends at or just past 'target': stepSimulation() adds a float dt
+// to the double clock, and a step that stops a rounding error short would leave the event
+// at 'target' for a needless tiny step
+static float stepTo(double t, double target) {
+    float dt = (float)(target - t);
+    while (t + dt < target) dt = std::nextafter(dt, std::numeric_limits<float>::infinity());
+    return dt;
+}
+
+void AdaptiveStepper::configure(const AdaptiveStepConfig& config) {
+    config_ = config;
+    reset();
+}
+
+void AdaptiveStepper::reset() {
+    stats_ = AdaptiveStepStats{};
+    dt_ = std::clamp((double)config_.initial_dt_sec, (double)config_.min_dt_sec, (double)config_.max_dt_sec);
+}
+
+void AdaptiveStepper::restart() {
+    dt_ = std::min(dt_, std::clamp((double)config_.initial_dt_sec, (double)config_.min_dt_sec, (double)config_.max_dt_sec));
+}
+
+double AdaptiveStepper::errorRatio(const Sensors& full, const Sensors& halves) const {
+    float heading = std::abs(full.heading_deg - halves.heading_deg);
+    heading = std::min(heading, 360.0f - heading);
+    double attitude = std::max({std::abs(full.pitch_deg - halves.pitch_deg), std::abs(full.roll_deg - halves.roll_deg),
+                                std::abs(full.aoa_deg - halves.aoa_deg), heading});
+
+    double tol = config_.tolerance;
+    double ratio = attitude / (config_.attitude_deg * tol);
+    ratio = std::max(ratio, std::abs(full.altitude_ft - halves.altitude_ft) / (config_.altitude_ft * tol));
+    ratio = std::max(ratio, std::abs(full.ias_knots - halves.ias_knots) / (config_.ias_knots * tol));
+    ratio = std::max(ratio, std::abs(full.vs_fpm - halves.vs_fpm) / (config_.vs_fpm * tol));
+    return ratio;
+}
+
+// Share of the step after which it should end to land half a band past the earliest
+// threshold it crossed (linear in between), 1 if none needs landing on
+double AdaptiveStepper::crossingFraction(const Sensors& start, const Sensors& end,
+                                         const std::vector<SensorThreshold>& thresholds) const {
+    double fraction = 1.0;
+    for (const SensorThreshold& t : thresholds) {
+        double g0 = start.*t.field - t.value;
+        double g1 = end.*t.field - t.value;
+        if ((g0 > 0.0) == (g1 > 0.0)) continue;
+        double band = landingBand(t.field);
+        if (std::abs(g1) <= band) continue;
+        fraction = std::min(fraction, (std::abs(g0) + 0.5 * band) / std::abs(g0 - g1));
+    }
+    return fraction;
+}
+
+double AdaptiveStepper::step(SimState& sim, double until_sec, const std::vector<SensorThreshold>* extra) {
+    const double t0 = sim.time_sec;
+    double end = until_sec;
+    double timer = sim.timers.nextExpiry();
+    if (timer > t0) end = std::min(end, timer);
+    if (end <= t0) return 0.0;
+
+    copySimState(saved_, sim);
+    double h = std::min(dt_, end - t0);
+    bool shortened = h < dt_;           // By the end time or a crossing, not by the error
+    bool located = false;
+    double error = 0.0;
+
+    for (int attempt = 1;; ++attempt) {
+        bool last = attempt >= MAX_ATTEMPTS || h <= config_.min_dt_sec;
+        float full = (t0 + h >= end) ? stepTo(t0, end) : (float)h;
+
+        stepSimulation(sim, full);
+        Sensors full_result = sim.sensors;
+        copySimState(sim, saved_);
+        stepSimulation(sim, 0.5f * full);
+        stepSimulation(sim, stepTo(sim.time_sec, t0 + full));
+        stats_.model_steps += 3;
+
+        error = errorRatio(full_result, sim.sensors);
+        if (error > 1.0 && !last) {
+            copySimState(sim, saved_);
+            h = std::max((double)config_.min_dt_sec, h * std::max(0.2, 0.9 / std::sqrt(error)));
+            dt_ = h;
+            shortened = false;
+            ++stats_.rejected;
+            continue;
+        }
+
+        double fraction = crossingFraction(saved_.sensors, sim.sensors, primSensorThresholds());
+        if (extra) fraction = std::min(fraction, crossingFraction(saved_.sensors, sim.sensors, *extra));
+        if (fraction < 1.0 && !last) {
+            copySimState(sim, saved_);
+            h = std::max((double)config_.min_dt_sec, h * fraction);
+            shortened = true;
+            located = true;
+            ++stats_.located;
+            continue;
+        }
+        break;
+    }
+
+    double taken = sim.time_sec - t0;
+    stats_.min_dt_sec = stats_.steps ? std::min(stats_.min_dt_sec, taken) : taken;
+    stats_.max_dt_sec = std::max(stats_.max_dt_sec, taken);
+    ++stats_.steps;
+
+    // A step cut short for an event says nothing about how long the next one can be
+    double proposal = h * ((error > 0.0) ? std::clamp(0.9 / std::sqrt(error), 0.2, 2.0) : 2.0);
+    dt_ = shortened ? std::max(dt_, proposal) : proposal;
+    dt_ = std::clamp(dt_, (double)config_.min_dt_sec, (double)config_.max_dt_sec);
+
+    // The crossing switches the discrete logic at the start of the next step
+    if (located) restart();
+    return taken;
+}
@@ -0,0 +1,85 @@
+//
+//
+// Santiago Quintana Moreno A01571222
+// Created on: 18/10/2026.
+#pragma once
+#include "sim_state.h"
+#include <cstdint>
+#include <vector>
+
+// ========== Adaptive Fast-Time Stepping ==========
+// Variable-step alternative to a fixed dt for long fast-time runs (cruise segments, descent
+// predictions). The model is unchanged. Every attempt is made of stepSimulation() calls, so
+// the smoothing filters, the autothrust integrator and the control laws each see the dt
+// they were stepped with.
+//
+// Error control is by step doubling. A step of h is taken, then the state is rolled back
+// and the same interval is run as two steps of h/2. The difference in the watched sensors
+// estimates the local error of the half steps, which are the ones kept. If the error
+// exceeds its limit, the step is rolled back and retried shorter. The model is first
+// order, so the next step is scaled by sqrt(limit / error).
+//
+// Event location: a step that carries a sensor across a threshold is rolled back and
+// retried to end just past it (within landingBand() of the threshold). The thresholds are
+// primSensorThresholds() (alert and protection limits, GPWS callout heights, flight phase
+// boundaries) plus any the caller passes, such as scenario 'when' triggers. The discrete
+// logic therefore switches at the same state as in a fixed-step run. Steps also end
+// exactly on the next pending timer (gear transit completion, callout expiry) and on the
+// caller's 'until' time (the next scripted event). After a located crossing or a
+// restart() the next step starts at initial_dt_sec, so alerts and mode changes come out
+// within one short step of where a fixed-step run has them.
+//
+// Each attempt costs three model steps and two state copies. Steady flight runs at the
+// longest step, and transients and threshold crossings come down as far as min_dt_sec.
+
+struct AdaptiveStepConfig {
+    float tolerance = 1.0f;             // Scales every error limit below
+    float altitude_ft = 0.5f;           // Local error limits per step at tolerance 1
+    float ias_knots = 0.02f;
+    float vs_fpm = 2.0f;
+    float attitude_deg = 0.01f;         // Pitch, roll, heading and AoA
+    float min_dt_sec = 0.001f;
+    float max_dt_sec = 1.0f;
+    float initial_dt_sec = 0.01f;
+};
+
+struct AdaptiveStepStats {
+    uint64_t steps = 0;                 // Accepted steps
+    uint64_t rejected = 0;              // Rolled back on the error estimate
+    uint64_t located = 0;               // Rolled back to end on a threshold
+    uint64_t model_steps = 0;           // stepSimulation() calls
+    double min_dt_sec = 0.0;            // Accepted step lengths
+    double max_dt_sec = 0.0;
+};
+
+// How close to a threshold on 'field' a located step has to end
+float landingBand(float Sensors::* field);
+
+class AdaptiveStepper {
+public:
+    void configure(const AdaptiveStepConfig& config);
+    const AdaptiveStepConfig& config() const { return config_; }
+
+    // One accepted step, ending no later than until_sec. 'extra' thresholds are located like
+    // the PRIM ones. Returns the step length, 0 once sim.time_sec has reached until_sec.
+    double step(SimState& sim, double until_sec, const std::vector<SensorThreshold>* extra = nullptr);
+
+    const AdaptiveStepStats& stats() const { return stats_; }
+    double nextStep() const { return dt_; }
+
+    // Forget the step length learned so far (after initSimulation / a scenario restart)
+    void reset();
+
+    // Start the next step no longer than initial_dt_sec, after a discontinuity such as a
+    // scripted action (the error estimate would only find it after a rejected step)
+    void restart();
+
+private:
+    double errorRatio(const Sensors& full, const Sensors& halves) const;
+    double crossingFraction(const Sensors& start, const Sensors& end, const std::vector<SensorThreshold>& thresholds) const;
+
+    AdaptiveStepConfig config_;
+    AdaptiveStepStats stats_;
+    double dt_ = 0.01;                  // Next step to try
+    SimState saved_;                    // Start of the step being tried
+};
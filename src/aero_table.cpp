@@ -0,0 +1,366 @@
+//
+//
+// Santiago Quintana Moreno A01571222
+// Created on: 18/10/2026.
+#include "aero_table.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+// ========== GridTable ==========
+
+bool GridTable::configure(const std::vector<TableAxis>& axes, int channels, std::string& error) {
+    if (axes.empty() || (int)axes.size() > TABLE_MAX_AXES) {
+        error = "table: 1 to " + std::to_string(TABLE_MAX_AXES) + " axes";
+        return false;
+    }
+    if (channels < 1 || channels > TABLE_LANES) {
+        error = "table: 1 to " + std::to_string(TABLE_LANES) + " channels";
+        return false;
+    }
+    size_t nodes = 1;
+    for (const TableAxis& a : axes) {
+        if (a.breakpoints.size() < 2) {
+            error = "axis " + a.name + ": needs at least two breakpoints";
+            return false;
+        }
+        for (size_t i = 1; i < a.breakpoints.size(); ++i) {
+            if (!(a.breakpoints[i] > a.breakpoints[i - 1])) {
+                error = "axis " + a.name + ": breakpoints must increase";
+                return false;
+            }
+        }
+        nodes *= a.breakpoints.size();
+    }
+
+    axes_ = axes;
+    channels_ = channels;
+    // Last axis varies fastest
+    size_t stride = 1;
+    for (int a = (int)axes_.size() - 1; a >= 0; --a) {
+        strides_[a] = stride;
+        stride *= axes_[a].breakpoints.size();
+    }
+    nodes_.assign(nodes * TABLE_LANES, 0.0f);
+    return true;
+}
+
+size_t GridTable::nodeIndex(const int* index) const {
+    size_t flat = 0;
+    for (int a = 0; a < axisCount(); ++a) flat += (size_t)index[a] * strides_[a];
+    return flat;
+}
+
+int GridTable::locate(int axis, float x, TableCursor& cursor) const {
+    const std::vector<float>& bp = axes_[axis].breakpoints;
+    int last_cell = (int)bp.size() - 2;
+    int c = std::min(std::max(cursor.cell[axis], 0), last_cell);
+
+    // Hunt: the same cell or one either side covers a smoothly moving state
+    for (int step = 0; step < 2; ++step) {
+        if (x < bp[c]) {
+            if (c == 0) break;
+            --c;
+        } else if (x >= bp[c + 1] && c < last_cell) {
+            ++c;
+        } else {
+            cursor.cell[axis] = c;
+            return c;
+        }
+    }
+    if ((x >= bp[c] || c == 0) && (x < bp[c + 1] || c == last_cell)) {
+        cursor.cell[axis] = c;
+        return c;
+    }
+
+    ++cursor.searches;
+    c = (int)(std::upper_bound(bp.begin(), bp.end(), x) - bp.begin()) - 1;
+    c = std::min(std::max(c, 0), last_cell);
+    cursor.cell[axis] = c;
+    return c;
+}
+
+struct Lanes {
+    float v[TABLE_LANES];
+};
+
+// Multilinear blend over axes A..AXES-1 of the cell whose lower corner is 'offset': the lower
+// and upper halves along axis A, each blended over the remaining axes, then one lerp. With
+// the axis count fixed this inlines into 2^AXES four-wide loads and 2^AXES - 1 four-wide
+// lerps, with no loop bookkeeping in between.
+template <int A, int AXES>
+static inline Lanes blendCell(const float* nodes, size_t offset, const size_t* strides, const float* t) {
+    if constexpr (A == AXES) {
+        Lanes n;
+        for (int l = 0; l < TABLE_LANES; ++l) n.v[l] = nodes[offset * TABLE_LANES + l];
+        return n;
+    } else {
+        Lanes lo = blendCell<A + 1, AXES>(nodes, offset, strides, t);
+        Lanes hi = blendCell<A + 1, AXES>(nodes, offset + strides[A], strides, t);
+        for (int l = 0; l < TABLE_LANES; ++l) lo.v[l] += (hi.v[l] - lo.v[l]) * t[A];
+        return lo;
+    }
+}
+
+void GridTable::lookup(const float* point, TableCursor& cursor, float* out) const {
+    const int axes = axisCount();
+    size_t base = 0;
+    float t[TABLE_MAX_AXES];
+    for (int a = 0; a < axes; ++a) {
+        const std::vector<float>& bp = axes_[a].breakpoints;
+        int c = locate(a, point[a], cursor);
+        float x = std::min(std::max(point[a], bp[c]), bp[c + 1]);
+        t[a] = (x - bp[c]) / (bp[c + 1] - bp[c]);
+        base += (size_t)c * strides_[a];
+    }
+    ++cursor.lookups;
+
+    Lanes v;
+    switch (axes) {
+        case 1:  v = blendCell<0, 1>(nodes_.data(), base, strides_, t); break;
+        case 2:  v = blendCell<0, 2>(nodes_.data(), base, strides_, t); break;
+        case 3:  v = blendCell<0, 3>(nodes_.data(), base, strides_, t); break;
+        default: v = blendCell<0, 4>(nodes_.data(), base, strides_, t); break;
+    }
+    for (int l = 0; l < TABLE_LANES; ++l) out[l] = v.v[l];
+}
+
+void GridTable::lookupBatch(const float* points, size_t count, TableCursor& cursor, float* out) const {
+    const int axes = axisCount();
+    for (size_t i = 0; i < count; ++i) lookup(points + i * axes, cursor, out + i * TABLE_LANES);
+}
+
+// ========== AeroDatabase parsing ==========
+
+static const char* const AXIS_NAMES[(int)AeroAxis::COUNT] = {"aoa", "mach", "flaps", "gear"};
+
+static std::vector<std::string> tokenize(const std::string& line) {
+    std::vector<std::string> tokens;
+    size_t i = 0;
+    while (i < line.size()) {
+        while (i < line.size() && (line[i] == ' ' || line[i] == '\t' || line[i] == '\r')) ++i;
+        if (i >= line.size() || line[i] == '#') break;
+        size_t start = i;
+        while (i < line.size() && line[i] != ' ' && line[i] != '\t' && line[i] != '\r' && line[i] != '#') ++i;
+        tokens.push_back(line.substr(start, i - start));
+    }
+    return tokens;
+}
+
+static bool parseFloat(const std::string& tok, float& out) {
+    if (tok.empty()) return false;
+    char* end = nullptr;
+    out = std::strtof(tok.c_str(), &end);
+    return end && *end == '\0';
+}
+
+// Index of the breakpoint 'v' names (to within rounding of the printed value), or -1
+static int breakpointIndex(const std::vector<float>& bp, float v) {
+    auto it = std::lower_bound(bp.begin(), bp.end(), v - 1e-4f * std::max(1.0f, std::abs(v)));
+    if (it == bp.end() || std::abs(*it - v) > 1e-4f * std::max(1.0f, std::abs(v))) return -1;
+    return (int)(it - bp.begin());
+}
+
+bool AeroDatabase::parse(const std::string& text, std::string& error) {
+    name_.clear();
+    reference_ = AeroReference{};
+    for (int& a : axis_of_) a = -1;
+
+    std::vector<TableAxis> axes;
+    std::vector<uint8_t> filled;
+    size_t filled_count = 0;
+    bool in_data = false;
+    size_t line_no = 0;
+    size_t pos = 0;
+
+    while (pos <= text.size()) {
+        size_t eol = text.find('\n', pos);
+        if (eol == std::string::npos) eol = text.size();
+        std::string line = text.substr(pos, eol - pos);
+        pos = eol + 1;
+        ++line_no;
+
+        std::vector<std::string> t = tokenize(line);
+        if (t.empty()) continue;
+
+        std::string why;
+        bool ok = true;
+        const std::string& kw = t[0];
+
+        if (in_data) {
+            int axes_n = table_.axisCount();
+            ok = (int)t.size() == axes_n + 3;
+            int index[TABLE_MAX_AXES] = {};
+            for (int a = 0; ok && a < axes_n; ++a) {
+                float v = 0.0f;
+                ok = parseFloat(t[a], v) && (index[a] = breakpointIndex(table_.axis(a).breakpoints, v)) >= 0;
+                if (!ok) why = "'" + t[a] + "' is not a breakpoint of axis " + table_.axis(a).name;
+            }
+            float coeffs[3] = {};
+            for (int c = 0; ok && c < 3; ++c) {
+                ok = parseFloat(t[axes_n + c], coeffs[c]);
+                if (!ok) why = "bad coefficient '" + t[axes_n + c] + "'";
+            }
+            if (ok) {
+                size_t flat = table_.nodeIndex(index);
+                if (filled[flat]) {
+                    ok = false;
+                    why = "node listed twice";
+                } else {
+                    filled[flat] = 1;
+                    ++filled_count;
+                    float* n = table_.node(flat);
+                    for (int c = 0; c < 3; ++c) n[c] = coeffs[c];
+                }
+            } else if (why.empty()) {
+                why = "expected " + std::to_string(axes_n) + " axis values then CL CD Cm";
+            }
+        } else if (kw == "name") {
+            size_t start = line.find("name") + 4;
+            size_t hash = line.find('#', start);
+            name_ = line.substr(start, hash == std::string::npos ? std::string::npos : hash - start);
+            name_.erase(0, name_.find_first_not_of(" \t"));
+            name_.erase(name_.find_last_not_of(" \t\r") + 1);
+        } else if (kw == "mass_kg" || kw == "wing_m2" || kw == "chord_m") {
+            float* field = kw == "mass_kg" ? &reference_.mass_kg : kw == "wing_m2" ? &reference_.wing_area_m2 : &reference_.chord_m;
+            ok = t.size() == 2 && parseFloat(t[1], *field) && *field > 0.0f;
+            if (!ok) why = "expected '" + kw + " <positive value>'";
+        } else if (kw == "axis") {
+            int which = -1;
+            for (int i = 0; t.size() >= 2 && i < (int)AeroAxis::COUNT; ++i) {
+                if (t[1] == AXIS_NAMES[i]) which = i;
+            }
+            ok = which >= 0 && axis_of_[which] < 0 && t.size() >= 4;
+            if (!ok) why = "expected 'axis aoa|mach|flaps|gear <breakpoints...>' (each axis once, two values or more)";
+            TableAxis axis;
+            axis.name = ok ? t[1] : std::string();
+            for (size_t i = 2; ok && i < t.size(); ++i) {
+                float v = 0.0f;
+                ok = parseFloat(t[i], v);
+                if (!ok) why = "bad breakpoint '" + t[i] + "'";
+                axis.breakpoints.push_back(v);
+            }
+            if (ok) {
+                axis_of_[which] = (int)axes.size();
+                axes.push_back(axis);
+            }
+        } else if (kw == "data") {
+            ok = t.size() == 1 && table_.configure(axes, 3, why);
+            if (t.size() != 1) why = "'data' takes no arguments";
+            if (ok) {
+                filled.assign(table_.nodeCount(), 0);
+                in_data = true;
+            }
+        } else {
+            ok = false;
+            why = "unknown statement '" + kw + "'";
+        }
+
+        if (!ok) {
+            error = "line " + std::to_string(line_no) + ": " + why;
+            return false;
+        }
+    }
+
+    if (!in_data) {
+        error = "no 'data' section";
+        return false;
+    }
+    if (filled_count != table_.nodeCount()) {
+        error = std::to_string(table_.nodeCount() - filled_count) + " of " + std::to_string(table_.nodeCount()) + " nodes missing";
+        return false;
+    }
+    return true;
+}
+
+bool AeroDatabase::load(const char* path, std::string& error) {
+    FILE* f = std::fopen(path, "rb");
+    if (!f) {
+        error = std::string("cannot open ") + path;
+        return false;
+    }
+    std::string text;
+    char buf[4096];
+    size_t n;
+    while ((n = std::fread(buf, 1, sizeof(buf), f)) > 0) text.append(buf, n);
+    std::fclose(f);
+
+    if (!parse(text, error)) {
+        error = std::string(path) + ": " + error;
+        return false;
+    }
+    if (name_.empty()) name_ = path;
+    return true;
+}
+
+// ========== AeroDatabase evaluation ==========
+
+void AeroDatabase::gather(const AeroPoint& p, float* point) const {
+    const float values[(int)AeroAxis::COUNT] = {p.aoa_deg, p.mach, p.flaps, p.gear};
+    for (int i = 0; i < (int)AeroAxis::COUNT; ++i) {
+        if (axis_of_[i] >= 0) point[axis_of_[i]] = values[i];
+    }
+}
+
+AeroCoefficients AeroDatabase::evaluate(const AeroPoint& p, AeroCursor& cursor) const {
+    float point[TABLE_MAX_AXES];
+    gather(p, point);
+    float v[TABLE_LANES];
+    table_.lookup(point, cursor.table, v);
+    return AeroCoefficients{v[0], v[1], v[2]};
+}
+
+void AeroDatabase::evaluateBatch(const AeroPoint* points, size_t count, AeroCursor& cursor, AeroCoefficients* out) const {
+    // Gather into table order in blocks, then one batched table pass per block
+    const size_t BLOCK = 64;
+    const int axes = table_.axisCount();
+    float coords[BLOCK * TABLE_MAX_AXES];
+    float values[BLOCK * TABLE_LANES];
+    for (size_t start = 0; start < count; start += BLOCK) {
+        size_t n = std::min(BLOCK, count - start);
+        for (size_t i = 0; i < n; ++i) gather(points[start + i], coords + i * axes);
+        table_.lookupBatch(coords, n, cursor.table, values);
+        for (size_t i = 0; i < n; ++i) {
+            const float* v = values + i * TABLE_LANES;
+            out[start + i] = AeroCoefficients{v[0], v[1], v[2]};
+        }
+    }
+}
+
+float AeroDatabase::aoaForLift(float cl, AeroPoint at, AeroCursor& cursor) const {
+    int axis = axis_of_[(int)AeroAxis::AOA];
+    if (axis < 0) return at.aoa_deg;
+    const std::vector<float>& bp = table_.axis(axis).breakpoints;
+    const int last_cell = (int)bp.size() - 2;
+
+    auto liftAt = [&](int i) {
+        at.aoa_deg = bp[i];
+        return evaluate(at, cursor).cl;
+    };
+
+    int c = std::min(std::max(cursor.lift_cell, 0), last_cell);
+    float lo = liftAt(c);
+    float hi = liftAt(c + 1);
+    for (int guard = 0; guard <= 2 * last_cell + 2; ++guard) {
+        if ((hi <= lo || cl < lo) && c > 0) {
+            // Falling side of the lift curve, or below this cell: step down
+            --c;
+            hi = lo;
+            lo = liftAt(c);
+        } else if (cl > hi && hi > lo && c < last_cell) {
+            float next = liftAt(c + 2);
+            if (next <= hi) break;      // CLmax at bp[c + 1]
+            ++c;
+            lo = hi;
+            hi = next;
+        } else {
+            break;
+        }
+    }
+    cursor.lift_cell = c;
+
+    if (hi <= lo) return bp[c];
+    float t = std::min(std::max((cl - lo) / (hi - lo), 0.0f), 1.0f);
+    return bp[c] + (bp[c + 1] - bp[c]) * t;
+}
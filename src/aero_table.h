@@ -0,0 +1,138 @@
+//
+//
+// Santiago Quintana Moreno A01571222
+// Created on: 18/10/2026.
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// ========== N-D Table Interpolation ==========
+// Rectilinear grid over up to TABLE_MAX_AXES axes, multilinear interpolation, clamped at the
+// edges. Every node holds TABLE_LANES floats (unused lanes are zero), so one lookup blends
+// all channels at once as 4-wide vectors: 2^axes corner loads and 2^axes - 1 lerps,
+// whatever the number of channels.
+//
+// Finding the cell is the only part that depends on the table size. A TableCursor remembers
+// the last cell on every axis; successive lookups from a smoothly moving state land in the
+// same or a neighbouring cell, so the search is a couple of compares instead of a binary
+// search. Keep one cursor per aircraft (per thread); the table itself is read-only.
+
+constexpr int TABLE_MAX_AXES = 4;
+constexpr int TABLE_LANES = 4;
+
+struct TableAxis {
+    std::string name;
+    std::vector<float> breakpoints;     // Strictly increasing, at least two
+};
+
+struct TableCursor {
+    int cell[TABLE_MAX_AXES] = {};      // Last cell per axis; lookups start searching here
+    uint64_t lookups = 0;
+    uint64_t searches = 0;              // Axis lookups that had to fall back to a binary search
+};
+
+class GridTable {
+public:
+    bool configure(const std::vector<TableAxis>& axes, int channels, std::string& error);
+
+    int axisCount() const { return (int)axes_.size(); }
+    const TableAxis& axis(int a) const { return axes_[a]; }
+    int channels() const { return channels_; }
+    size_t nodeCount() const { return nodes_.size() / TABLE_LANES; }
+
+    // Node at per-axis breakpoint indices, TABLE_LANES floats (for filling the table)
+    size_t nodeIndex(const int* index) const;
+    float* node(size_t node_index) { return &nodes_[node_index * TABLE_LANES]; }
+
+    // 'point' has one coordinate per axis; writes TABLE_LANES values to 'out'
+    void lookup(const float* point, TableCursor& cursor, float* out) const;
+    // 'count' points of axisCount() coordinates each; TABLE_LANES values per point to 'out'
+    void lookupBatch(const float* points, size_t count, TableCursor& cursor, float* out) const;
+
+private:
+    int locate(int axis, float x, TableCursor& cursor) const;
+
+    std::vector<TableAxis> axes_;
+    size_t strides_[TABLE_MAX_AXES] = {};   // In nodes
+    std::vector<float> nodes_;
+    int channels_ = 0;
+};
+
+// ========== Aero Database ==========
+// Lift, drag and pitching moment coefficients over AoA, Mach, flaps and gear, loaded from a
+// text file (see aero/a320.aero):
+//
+//   name      A320-200 (approximate)
+//   mass_kg   64000                    reference mass, wing area and chord
+//   wing_m2   122.6
+//   chord_m   4.19
+//   axis      aoa   -4 -2 0 2 ...      any subset of aoa / mach / flaps / gear, in any order;
+//   axis      mach  0.1 0.3 ...        an omitted axis is constant
+//   axis      flaps 0 1 2 3 4          FlapsPosition index (0 clean .. 4 FULL)
+//   axis      gear  0 1                0 up, 1 down
+//   data                               then one line per node: the axis values in 'axis'
+//   -4 0.1 0 0   -0.18 0.0225 0.078    order, then CL CD Cm
+//
+// Every node must be listed exactly once.
+
+enum class AeroAxis : uint8_t {
+    AOA,
+    MACH,
+    FLAPS,
+    GEAR,
+    COUNT
+};
+
+struct AeroPoint {
+    float aoa_deg = 0.0f;
+    float mach = 0.0f;
+    float flaps = 0.0f;                 // 0 .. 4, fractional while the flaps run
+    float gear = 0.0f;                  // 0 up, 1 down, in between in transit
+};
+
+struct AeroCoefficients {
+    float cl = 0.0f;
+    float cd = 0.0f;
+    float cm = 0.0f;
+};
+
+struct AeroReference {
+    float mass_kg = 64000.0f;
+    float wing_area_m2 = 122.6f;
+    float chord_m = 4.19f;
+};
+
+// Per-aircraft lookup state
+struct AeroCursor {
+    TableCursor table;
+    int lift_cell = 0;                  // AoA cell of the last aoaForLift() solution
+};
+
+class AeroDatabase {
+public:
+    // On failure 'error' holds "line N: reason"
+    bool parse(const std::string& text, std::string& error);
+    bool load(const char* path, std::string& error);
+
+    const std::string& name() const { return name_; }
+    const AeroReference& reference() const { return reference_; }
+    const GridTable& table() const { return table_; }
+
+    AeroCoefficients evaluate(const AeroPoint& p, AeroCursor& cursor) const;
+    void evaluateBatch(const AeroPoint* points, size_t count, AeroCursor& cursor, AeroCoefficients* out) const;
+
+    // AoA at which CL reaches 'cl' with the other coordinates of 'at', on the rising part of
+    // the lift curve: the stall AoA when 'cl' is beyond CLmax. Walks AoA cells from the last
+    // solution, so it costs a few lookups per call.
+    float aoaForLift(float cl, AeroPoint at, AeroCursor& cursor) const;
+
+private:
+    void gather(const AeroPoint& p, float* point) const;
+
+    std::string name_;
+    AeroReference reference_;
+    GridTable table_;
+    int axis_of_[(int)AeroAxis::COUNT] = {-1, -1, -1, -1};    // Table axis per AeroAxis, -1 if omitted
+};
@@ -3,6 +3,7 @@
 // Santiago Quintana Moreno A01571222
 // Created on: 24/12/2025.
 #include "alerts.h"
+#include <algorithm>
 
 AlertEdge AlertManager::set(int id, AlertLevel level, const std::string& text, bool condition_active, bool latch_when_active) {
     return set(id, level, text, condition_active, latch_when_active, {});
@@ -85,3 +86,13 @@ std::vector<const Alert*> AlertManager::getShownSorted(AlertLevel lvl) const {
     }
     return out;
 }
+
+uint64_t AlertManager::shownMask() const {
+    uint64_t mask = 0;
+    size_t n = std::min(alerts_.size(), (size_t)64);
+    for (size_t i = 0; i < n; ++i) {
+        const auto& a = alerts_[i];
+        if (a.active || a.latched) mask |= uint64_t(1) << i;
+    }
+    return mask;
+}
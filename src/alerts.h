@@ -3,6 +3,7 @@
 // Santiago Quintana Moreno A01571222
 // Created on: 24/12/2025.
 #pragma once
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -38,6 +39,10 @@ public:
 
     std::vector<const Alert*> getShownSorted(AlertLevel lvl) const;
 
+    // Bit i set when all()[i] is shown. Slots follow the order alerts are first published,
+    // which is fixed by PrimCore::update, so masks are comparable between runs (max 64 slots).
+    uint64_t shownMask() const;
+
     const std::vector<Alert>& all() const { return alerts_; }
 
 private:
@@ -0,0 +1,198 @@
+//
+//
+// Santiago Quintana Moreno A01571222
+// Created on: 18/10/2026.
+#include "atmosphere.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+// ========== Constants ==========
+
+static constexpr double T0_K = 288.15;
+static constexpr double P0_PA = 101325.0;
+static constexpr double RHO0 = 1.225;
+static constexpr double LAPSE_K_PER_M = 0.0065;
+static constexpr double G0 = 9.80665;
+static constexpr double R_AIR = 287.05287;
+static constexpr double TROPOPAUSE_M = 11000.0;
+static constexpr double FT_TO_M = 0.3048;
+
+// ========== Compile-time math ==========
+// std::exp / std::log / std::sqrt are not constexpr, so the tables are built with these.
+// Plain series, accurate to double rounding over the ranges the tables need.
+
+static constexpr double cexp(double x) {
+    int halvings = 0;
+    while (x > 0.5 || x < -0.5) {
+        x *= 0.5;
+        ++halvings;
+    }
+    double sum = 1.0;
+    double term = 1.0;
+    for (int n = 1; n < 20; ++n) {
+        term *= x / n;
+        sum += term;
+    }
+    for (int i = 0; i < halvings; ++i) sum *= sum;
+    return sum;
+}
+
+// ln(x) = 2 atanh((x - 1) / (x + 1)), fine for the ratios used here (0.1 .. 10)
+static constexpr double clog(double x) {
+    double y = (x - 1.0) / (x + 1.0);
+    double y2 = y * y;
+    double sum = 0.0;
+    double power = y;
+    for (int n = 1; n < 200; n += 2) {
+        sum += power / n;
+        power *= y2;
+    }
+    return 2.0 * sum;
+}
+
+static constexpr double cpow(double base, double exponent) {
+    return cexp(exponent * clog(base));
+}
+
+static constexpr double csqrt(double x) {
+    if (x <= 0.0) return 0.0;
+    double r = x > 1.0 ? x : 1.0;
+    for (int i = 0; i < 60; ++i) r = 0.5 * (r + x / r);
+    return r;
+}
+
+// ========== Pressure table ==========
+// Temperature is piecewise linear and cheap to evaluate directly; density and speed of sound
+// follow from it. Only the pressure ratio needs exp/pow, so that is what gets tabulated.
+
+static constexpr float ALT_STEP_FT = 250.0f;
+static constexpr int ALT_ROWS = (int)(ISA_MAX_ALTITUDE_FT / ALT_STEP_FT) + 1;
+
+static constexpr double temperatureK(double altitude_m) {
+    return T0_K - LAPSE_K_PER_M * std::min(altitude_m, TROPOPAUSE_M);
+}
+
+static constexpr double pressureRatio(double altitude_ft) {
+    double h = altitude_ft * FT_TO_M;
+    double t = temperatureK(h);
+    double delta = cpow(t / T0_K, G0 / (LAPSE_K_PER_M * R_AIR));
+    if (h > TROPOPAUSE_M) delta *= cexp(-G0 * (h - TROPOPAUSE_M) / (R_AIR * t));
+    return delta;
+}
+
+static constexpr std::array<float, ALT_ROWS> buildPressureTable() {
+    std::array<float, ALT_ROWS> table{};
+    for (int i = 0; i < ALT_ROWS; ++i) table[i] = (float)pressureRatio((double)i * ALT_STEP_FT);
+    return table;
+}
+
+static constexpr std::array<float, ALT_ROWS> PRESSURE_TABLE = buildPressureTable();
+
+// ========== Pitot table ==========
+// Subsonic pitot relation: qc / p = (1 + 0.2 M^2)^3.5 - 1. The forward direction is cheap
+// (a cube and a square root). The inverse needs a 2/7 power, so it is tabulated against
+// s = sqrt(qc / p), in which Mach is almost linear (M ~ 1.195 s at low speed).
+
+static constexpr double impactRatio(double mach) {
+    double t = 1.0 + 0.2 * mach * mach;
+    return t * t * t * csqrt(t) - 1.0;
+}
+
+static constexpr int PITOT_INTERVALS = 256;
+static constexpr double PITOT_S_MAX = csqrt(impactRatio(1.0));
+
+static constexpr std::array<float, PITOT_INTERVALS + 1> buildPitotTable() {
+    std::array<float, PITOT_INTERVALS + 1> table{};
+    for (int i = 0; i <= PITOT_INTERVALS; ++i) {
+        double s = PITOT_S_MAX * i / PITOT_INTERVALS;
+        double ratio = s * s;
+        table[i] = (float)csqrt(5.0 * (cpow(ratio + 1.0, 2.0 / 7.0) - 1.0));
+    }
+    return table;
+}
+
+static constexpr std::array<float, PITOT_INTERVALS + 1> PITOT_TABLE = buildPitotTable();
+
+// ========== Lookups ==========
+
+static float clampAltitude(float altitude_ft) {
+    return std::clamp(altitude_ft, 0.0f, ISA_MAX_ALTITUDE_FT);
+}
+
+static float lookupTemperatureK(float altitude_ft) {
+    return (float)temperatureK(clampAltitude(altitude_ft) * FT_TO_M);
+}
+
+static float lookupDelta(float altitude_ft) {
+    float x = clampAltitude(altitude_ft) / ALT_STEP_FT;
+    int i = std::min((int)x, ALT_ROWS - 2);
+    float t = x - (float)i;
+    return PRESSURE_TABLE[i] + (PRESSURE_TABLE[i + 1] - PRESSURE_TABLE[i]) * t;
+}
+
+static float soundSpeedKt(float temperature_k) {
+    return ISA_SEA_LEVEL_SOUND_KT * std::sqrt(temperature_k / (float)T0_K);
+}
+
+static float machFromImpactRatio(float ratio) {
+    float x = std::sqrt(std::max(ratio, 0.0f)) * (float)(PITOT_INTERVALS / PITOT_S_MAX);
+    if (x >= (float)PITOT_INTERVALS) return 1.0f;
+    int i = (int)x;
+    float t = x - (float)i;
+    return PITOT_TABLE[i] + (PITOT_TABLE[i + 1] - PITOT_TABLE[i]) * t;
+}
+
+// In double: at low Mach the result is a small difference of numbers near 1, and in float
+// it would move in steps of ~1e-3 kt of IAS
+static float impactRatioF(float mach) {
+    double t = 1.0 + 0.2 * (double)mach * mach;
+    return (float)(t * t * t * std::sqrt(t) - 1.0);
+}
+
+// ========== Public API ==========
+
+AtmosphereState isaAtmosphere(float altitude_ft) {
+    AtmosphereState out;
+    out.temperature_k = lookupTemperatureK(altitude_ft);
+    out.delta = lookupDelta(altitude_ft);
+    out.sigma = out.delta * (float)T0_K / out.temperature_k;
+    out.pressure_pa = out.delta * (float)P0_PA;
+    out.density_kgm3 = out.sigma * (float)RHO0;
+    out.speed_of_sound_kt = soundSpeedKt(out.temperature_k);
+    return out;
+}
+
+float isaTemperatureC(float altitude_ft) {
+    return lookupTemperatureK(altitude_ft) - 273.15f;
+}
+
+float casToMach(float cas_kt, float altitude_ft) {
+    float qc_p0 = impactRatioF(std::max(cas_kt, 0.0f) / ISA_SEA_LEVEL_SOUND_KT);
+    return machFromImpactRatio(qc_p0 / lookupDelta(altitude_ft));
+}
+
+float machToCas(float mach, float altitude_ft) {
+    float qc_p0 = impactRatioF(std::clamp(mach, 0.0f, 1.0f)) * lookupDelta(altitude_ft);
+    return machFromImpactRatio(qc_p0) * ISA_SEA_LEVEL_SOUND_KT;
+}
+
+float machToTas(float mach, float altitude_ft) {
+    return mach * soundSpeedKt(lookupTemperatureK(altitude_ft));
+}
+
+float tasToMach(float tas_kt, float altitude_ft) {
+    return tas_kt / soundSpeedKt(lookupTemperatureK(altitude_ft));
+}
+
+float casToTas(float cas_kt, float altitude_ft) {
+    return machToTas(casToMach(cas_kt, altitude_ft), altitude_ft);
+}
+
+float tasToCas(float tas_kt, float altitude_ft) {
+    return machToCas(tasToMach(tas_kt, altitude_ft), altitude_ft);
+}
+
+float totalAirTemperatureC(float static_temp_c, float mach) {
+    return (static_temp_c + 273.15f) * (1.0f + 0.2f * mach * mach) - 273.15f;
+}
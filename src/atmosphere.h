@@ -0,0 +1,41 @@
+//
+//
+// Santiago Quintana Moreno A01571222
+// Created on: 18/10/2026.
+#pragma once
+
+// ========== ISA Atmosphere ==========
+// International Standard Atmosphere, standard day: troposphere (-1.98 K / 1000 ft) and the
+// isothermal lower stratosphere above 36089 ft, up to ISA_MAX_ALTITUDE_FT.
+//
+// Nothing here calls pow/exp at run time. The pressure ratio comes from a table over altitude
+// and the inverse of the pitot relation (impact pressure to Mach) from a table over
+// sqrt(qc / p); temperature, density and speed of sound follow directly. Both tables are
+// built by constexpr code at compile time and read with linear interpolation, within 1e-4
+// (relative) of the exact formulas. Airspeeds are subsonic: Mach results are capped at 1.
+
+constexpr float ISA_MAX_ALTITUDE_FT = 50000.0f;   // Altitudes are clamped to [0, this]
+constexpr float ISA_SEA_LEVEL_SOUND_KT = 661.4786f;
+
+struct AtmosphereState {
+    float temperature_k = 288.15f;
+    float pressure_pa = 101325.0f;
+    float density_kgm3 = 1.225f;
+    float speed_of_sound_kt = ISA_SEA_LEVEL_SOUND_KT;
+    float delta = 1.0f;                 // Pressure ratio p / p0
+    float sigma = 1.0f;                 // Density ratio rho / rho0
+};
+
+AtmosphereState isaAtmosphere(float altitude_ft);
+float isaTemperatureC(float altitude_ft);
+
+// Airspeed conversions at a pressure altitude. CAS and TAS in knots.
+float casToMach(float cas_kt, float altitude_ft);
+float machToCas(float mach, float altitude_ft);
+float machToTas(float mach, float altitude_ft);
+float tasToMach(float tas_kt, float altitude_ft);
+float casToTas(float cas_kt, float altitude_ft);
+float tasToCas(float tas_kt, float altitude_ft);
+
+// Total (ram) air temperature seen by a probe with full recovery
+float totalAirTemperatureC(float static_temp_c, float mach);
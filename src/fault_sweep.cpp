@@ -0,0 +1,256 @@
+//
+//
+// Santiago Quintana Moreno A01571222
+// Created on: 18/10/2026.
+#include "fault_sweep.h"
+#include "trim_solver.h"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <thread>
+
+const char* sweepStartName(SweepStart start) {
+    switch (start) {
+        case SweepStart::CRUISE_10000FT: return "cruise10k";
+        case SweepStart::CRUISE_37000FT: return "cruise37k";
+        case SweepStart::APPROACH:       return "approach";
+    }
+    return "unknown";
+}
+
+bool sweepStartFromName(const char* name, SweepStart& out) {
+    for (SweepStart s : { SweepStart::CRUISE_10000FT, SweepStart::CRUISE_37000FT, SweepStart::APPROACH }) {
+        if (std::strcmp(sweepStartName(s), name) == 0) {
+            out = s;
+            return true;
+        }
+    }
+    return false;
+}
+
+void applySweepStart(SimState& sim, SweepStart start) {
+    switch (start) {
+        case SweepStart::CRUISE_10000FT:
+            initSimulation(sim, StartupScenario::CRUISE_10000FT);
+            break;
+        case SweepStart::CRUISE_37000FT:
+            initSimulation(sim, StartupScenario::CRUISE_37000FT);
+            break;
+        case SweepStart::APPROACH:
+        {
+            // Stabilised approach, trimmed for a ~3 degree descent. CONF 2: the point-mass AoA
+            // puts a CONF 3 trim at 160 kt above alpha-prot, which trimSimulation() refuses
+            resetSimulation(sim, StartupScenario::CRUISE_10000FT);
+            TrimCondition cond;
+            cond.altitude_ft = 3000.0f;
+            cond.ias_knots = 160.0f;
+            cond.flaps = FlapsPosition::CONF_2;
+            cond.gear = GearPosition::DOWN;
+            cond.vs_fpm = -700.0f;
+            std::string error;
+            trimSimulation(sim, cond, error);
+            break;
+        }
+    }
+}
+
+std::vector<FaultSet> enumerateFaultCombinations(FaultSet candidates, int max_order) {
+    std::vector<FaultId> ids;
+    candidates.forEach([&](FaultId id) { ids.push_back(id); });
+
+    std::vector<FaultSet> out;
+    int n = (int)ids.size();
+    for (int order = 1; order <= std::min(max_order, n); ++order) {
+        // Lexicographic walk over index combinations of size 'order'
+        std::vector<int> idx(order);
+        for (int i = 0; i < order; ++i) idx[i] = i;
+        while (true) {
+            FaultSet set;
+            for (int i : idx) set.set(ids[i]);
+            out.push_back(set);
+
+            int pos = order - 1;
+            while (pos >= 0 && idx[pos] == n - order + pos) --pos;
+            if (pos < 0) break;
+            ++idx[pos];
+            for (int i = pos + 1; i < order; ++i) idx[i] = idx[i - 1] + 1;
+        }
+    }
+    return out;
+}
+
+std::vector<FaultSet> buildCoveringArray(FaultSet candidates, int strength, uint32_t seed) {
+    std::vector<FaultId> ids;
+    candidates.forEach([&](FaultId id) { ids.push_back(id); });
+    int k = (int)ids.size();
+    int t = std::clamp(strength, 1, 3);
+    if (k == 0) return {};
+    t = std::min(t, k);
+
+    // All t-subsets of factor indices, each with a mask of still-uncovered on/off assignments
+    std::vector<uint8_t> tuples;  // t factor indices per tuple
+    std::vector<uint8_t> uncovered;
+    {
+        std::vector<int> idx(t);
+        for (int i = 0; i < t; ++i) idx[i] = i;
+        while (true) {
+            for (int i : idx) tuples.push_back((uint8_t)i);
+            uncovered.push_back((uint8_t)((1u << (1u << t)) - 1u));
+
+            int pos = t - 1;
+            while (pos >= 0 && idx[pos] == k - t + pos) --pos;
+            if (pos < 0) break;
+            ++idx[pos];
+            for (int i = pos + 1; i < t; ++i) idx[i] = idx[i - 1] + 1;
+        }
+    }
+
+    size_t tuple_count = uncovered.size();
+    size_t remaining = tuple_count * (1u << t);
+
+    auto assignment = [&](uint64_t row, size_t tuple) {
+        unsigned v = 0;
+        for (int i = 0; i < t; ++i) v |= (unsigned)((row >> tuples[tuple * t + i]) & 1u) << i;
+        return v;
+    };
+    auto gain = [&](uint64_t row) {
+        size_t g = 0;
+        for (size_t j = 0; j < tuple_count; ++j) g += (uncovered[j] >> assignment(row, j)) & 1u;
+        return g;
+    };
+
+    std::mt19937_64 rng(seed);
+    uint64_t factor_mask = (k == 64) ? ~uint64_t(0) : ((uint64_t(1) << k) - 1);
+    const int CANDIDATES_PER_ROW = 64;
+
+    std::vector<uint64_t> rows;
+    while (remaining > 0) {
+        uint64_t best_row = 0;
+        size_t best_gain = 0;
+        for (int c = 0; c < CANDIDATES_PER_ROW; ++c) {
+            uint64_t row = rng() & factor_mask;
+            size_t g = gain(row);
+            if (g > best_gain) { best_gain = g; best_row = row; }
+        }
+
+        if (best_gain == 0) {
+            // Random rows stopped helping: build one that covers the first open assignment
+            size_t j = 0;
+            while (uncovered[j] == 0) ++j;
+            unsigned v = (unsigned)std::countr_zero((unsigned)uncovered[j]);
+            best_row = rng() & factor_mask;
+            for (int i = 0; i < t; ++i) {
+                uint64_t bit = uint64_t(1) << tuples[j * t + i];
+                best_row = ((v >> i) & 1u) ? (best_row | bit) : (best_row & ~bit);
+            }
+        }
+
+        for (size_t j = 0; j < tuple_count; ++j) {
+            uint8_t bit = (uint8_t)(1u << assignment(best_row, j));
+            if (uncovered[j] & bit) {
+                uncovered[j] &= (uint8_t)~bit;
+                --remaining;
+            }
+        }
+        rows.push_back(best_row);
+    }
+
+    std::vector<FaultSet> out;
+    out.reserve(rows.size());
+    for (uint64_t row : rows) {
+        FaultSet set;
+        for (int i = 0; i < k; ++i) {
+            if ((row >> i) & 1u) set.set(ids[i]);
+        }
+        out.push_back(set);
+    }
+    return out;
+}
+
+SweepOutcome runSweepCase(const SweepCase& sweep_case, const SweepConfig& config) {
+    SimState sim;
+    applySweepStart(sim, sweep_case.start);
+    sim.faults = Faults::fromBits(sweep_case.faults);
+
+    SweepOutcome out;
+    out.input = sweep_case;
+
+    float start_alt = sim.sensors.altitude_ft;
+    float min_alt = start_alt;
+    float max_aoa = std::abs(sim.sensors.aoa_deg);
+    uint64_t raised = 0;
+
+    int steps = (int)std::lround(config.duration_sec / config.dt_sec);
+    for (int i = 0; i < steps; ++i) {
+        stepSimulation(sim, config.dt_sec);
+        min_alt = std::min(min_alt, sim.sensors.altitude_ft);
+        max_aoa = std::max(max_aoa, std::abs(sim.sensors.aoa_deg));
+        raised |= sim.alerts.shownMask();
+    }
+
+    out.final_law = sim.prim.fctl_status().law;
+    out.alerts_raised = raised;
+    out.max_abs_aoa_deg = max_aoa;
+    out.altitude_lost_ft = start_alt - min_alt;
+    return out;
+}
+
+std::vector<SweepOutcome> runFaultSweep(const std::vector<SweepCase>& cases, const SweepConfig& config) {
+    std::vector<SweepOutcome> outcomes(cases.size());
+
+    int threads = config.threads > 0 ? config.threads : (int)std::thread::hardware_concurrency();
+    threads = std::max(1, std::min(threads, (int)cases.size()));
+
+    // Cases vary in cost, so workers pull the next index instead of taking fixed chunks
+    std::atomic<size_t> next{0};
+    auto worker = [&]() {
+        for (size_t i = next.fetch_add(1); i < cases.size(); i = next.fetch_add(1)) {
+            outcomes[i] = runSweepCase(cases[i], config);
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (int i = 1; i < threads; ++i) pool.emplace_back(worker);
+    worker();
+    for (auto& th : pool) th.join();
+
+    return outcomes;
+}
+
+static const char* lawName(ControlLaw law) {
+    switch (law) {
+        case ControlLaw::NORMAL:    return "NORMAL";
+        case ControlLaw::ALTERNATE: return "ALTN";
+        case ControlLaw::DIRECT:    return "DIRECT";
+    }
+    return "?";
+}
+
+void writeOutcomeMatrix(FILE* out, const std::vector<SweepOutcome>& outcomes) {
+    // Alert slots are fixed by the publish order in PrimCore::update, so a single step of
+    // any scenario gives the bit -> alert legend
+    SimState probe;
+    initSimulation(probe, StartupScenario::CRUISE_10000FT);
+    stepSimulation(probe, 0.01f);
+    const auto& slots = probe.alerts.all();
+    for (size_t i = 0; i < slots.size() && i < 64; ++i) {
+        std::fprintf(out, "# alert bit %zu = %d %s\n", i, slots[i].id, slots[i].text.c_str());
+    }
+
+    std::fprintf(out, "start,faults,law,alerts,max_aoa_deg,alt_lost_ft\n");
+    for (const auto& o : outcomes) {
+        std::string names;
+        o.input.faults.forEach([&](FaultId id) {
+            if (!names.empty()) names += '+';
+            names += faultName(id);
+        });
+        if (names.empty()) names = "none";
+
+        std::fprintf(out, "%s,%s,%s,%016llx,%.1f,%.0f\n",
+                     sweepStartName(o.input.start), names.c_str(), lawName(o.final_law),
+                     (unsigned long long)o.alerts_raised, o.max_abs_aoa_deg, o.altitude_lost_ft);
+    }
+}
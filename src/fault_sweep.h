@@ -0,0 +1,55 @@
+//
+//
+// Santiago Quintana Moreno A01571222
+// Created on: 18/10/2026.
+#pragma once
+#include "sim_state.h"
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// Initial conditions a fault combination can be injected from
+enum class SweepStart {
+    CRUISE_10000FT,
+    CRUISE_37000FT,
+    APPROACH   // 3000 ft, 160 kt, CONF 2, gear down, ~700 fpm descent
+};
+
+const char* sweepStartName(SweepStart start);
+bool sweepStartFromName(const char* name, SweepStart& out);
+void applySweepStart(SimState& sim, SweepStart start);
+
+struct SweepCase {
+    SweepStart start = SweepStart::CRUISE_10000FT;
+    FaultSet faults{};
+};
+
+struct SweepOutcome {
+    SweepCase input{};
+    ControlLaw final_law = ControlLaw::NORMAL;
+    uint64_t alerts_raised = 0;      // AlertManager::shownMask() OR'ed over the whole run
+    float max_abs_aoa_deg = 0.0f;
+    float altitude_lost_ft = 0.0f;   // Start altitude minus lowest altitude reached
+};
+
+struct SweepConfig {
+    float duration_sec = 60.0f;
+    float dt_sec = 0.01f;
+    int threads = 0;                 // 0 = one per hardware thread
+};
+
+// Every combination of 1..max_order faults drawn from 'candidates'
+std::vector<FaultSet> enumerateFaultCombinations(FaultSet candidates, int max_order);
+
+// Greedy binary covering array: every 'strength'-tuple of candidate faults appears in every
+// on/off assignment in at least one row. Far fewer rows than exhaustive enumeration.
+std::vector<FaultSet> buildCoveringArray(FaultSet candidates, int strength, uint32_t seed = 1);
+
+SweepOutcome runSweepCase(const SweepCase& sweep_case, const SweepConfig& config);
+
+// Runs all cases headless, spread over worker threads. Output order matches 'cases'.
+std::vector<SweepOutcome> runFaultSweep(const std::vector<SweepCase>& cases, const SweepConfig& config);
+
+// Compact CSV outcome matrix, preceded by '#' lines mapping alert bits to alert texts
+void writeOutcomeMatrix(FILE* out, const std::vector<SweepOutcome>& outcomes);
@@ -0,0 +1,59 @@
+//
+//
+// Santiago Quintana Moreno A01571222
+// Created on: 18/10/2026.
+#include "fctl_reconfig.h"
+
+uint32_t reconfigKey(const Faults& f) {
+    uint32_t key = 0;
+    for (size_t i = 0; i < sizeof(RECONFIG_INPUTS) / sizeof(RECONFIG_INPUTS[0]); ++i) {
+        key |= uint32_t(f.get(RECONFIG_INPUTS[i])) << i;
+    }
+    return key;
+}
+
+FlightControlReconfig computeReconfig(const Faults& f) {
+    FlightControlReconfig r;
+
+    // ========== Hydraulic Systems ==========
+    r.green_avail = !f.green_hyd_fail;
+    r.blue_avail = !f.blue_hyd_fail;
+    r.yellow_avail = !f.yellow_hyd_fail;
+
+    // Need at least one hydraulic system for flight controls
+    bool hydraulics_ok = r.green_avail || r.blue_avail || r.yellow_avail;
+
+    r.elac1_avail = !f.elac1_fail && hydraulics_ok;
+    r.elac2_avail = !f.elac2_fail && hydraulics_ok;
+    r.sec1_avail = !f.sec1_fail && hydraulics_ok;
+
+    // Determine control law based on failures
+    // NORMAL LAW: All ELACs and SECs operational
+    // ALTERNATE LAW: One or more ELAC failures
+    // DIRECT LAW: Multiple critical failures (simplified)
+    if (f.elac1_fail && f.elac2_fail) {
+        r.law = ControlLaw::DIRECT;
+    } else if (f.elac1_fail || f.elac2_fail || f.sec1_fail) {
+        r.law = ControlLaw::ALTERNATE;
+    } else {
+        r.law = ControlLaw::NORMAL;
+    }
+
+    // Authority reduction based on control law
+    switch (r.law) {
+        case ControlLaw::NORMAL:
+            r.elevator_authority = 1.0f;
+            r.aileron_authority = 1.0f;
+            break;
+        case ControlLaw::ALTERNATE:
+            r.elevator_authority = 0.65f; // Reduced authority
+            r.aileron_authority = 0.70f;
+            break;
+        case ControlLaw::DIRECT:
+            r.elevator_authority = 0.45f; // Minimal authority
+            r.aileron_authority = 0.50f;
+            break;
+    }
+
+    return r;
+}
@@ -0,0 +1,66 @@
+//
+//
+// Santiago Quintana Moreno A01571222
+// Created on: 18/10/2026.
+#pragma once
+#include "sim_types.h"
+#include <cstdint>
+
+// Flight control reconfiguration for a given fault state: which computers and hydraulic
+// systems are available, the resulting control law and the surface authority it allows.
+// Only depends on Faults, so it is recomputed when the relevant faults change, not every step.
+struct FlightControlReconfig {
+    ControlLaw law = ControlLaw::NORMAL;
+
+    bool green_avail = true;
+    bool blue_avail = true;
+    bool yellow_avail = true;
+
+    bool elac1_avail = true;
+    bool elac2_avail = true;
+    bool sec1_avail = true;
+    bool sec2_avail = true;
+    bool sec3_avail = true;
+
+    float elevator_authority = 1.0f;  // Fraction of full elevator command available
+    float aileron_authority = 1.0f;
+};
+
+// Faults the reconfiguration logic reads. Anything not listed here must not affect the
+// result, otherwise the cache would hand back stale entries.
+inline constexpr FaultId RECONFIG_INPUTS[] = {
+    FaultId::elac1_fail,
+    FaultId::elac2_fail,
+    FaultId::sec1_fail,
+    FaultId::green_hyd_fail,
+    FaultId::blue_hyd_fail,
+    FaultId::yellow_hyd_fail,
+};
+
+static_assert(sizeof(RECONFIG_INPUTS) / sizeof(RECONFIG_INPUTS[0]) <= 32, "reconfig key is 32 bits wide");
+
+// Packs the RECONFIG_INPUTS bits of 'f' (bit i = RECONFIG_INPUTS[i])
+uint32_t reconfigKey(const Faults& f);
+
+// Full (slow path) evaluation of the reconfiguration rules
+FlightControlReconfig computeReconfig(const Faults& f);
+
+// Keeps the reconfiguration for the last fault state seen; lookup() only re-runs
+// computeReconfig() when the packed key changes.
+class ReconfigCache {
+public:
+    const FlightControlReconfig& lookup(const Faults& f) {
+        uint32_t key = reconfigKey(f);
+        if (key != key_ || !valid_) {
+            current_ = computeReconfig(f);
+            key_ = key;
+            valid_ = true;
+        }
+        return current_;
+    }
+
+private:
+    FlightControlReconfig current_{};
+    uint32_t key_ = 0;
+    bool valid_ = false;
+};
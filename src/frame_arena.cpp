@@ -0,0 +1,54 @@
+//
+//
+// Santiago Quintana Moreno A01571222
+// Created on: 18/10/2026.
+#include "frame_arena.h"
+#include <algorithm>
+#include <cstdint>
+
+static size_t alignUp(size_t v, size_t align) { return (v + align - 1) & ~(align - 1); }
+
+FrameArena::FrameArena(size_t capacity_bytes)
+    : buffer_(new unsigned char[capacity_bytes]), capacity_(capacity_bytes) {}
+
+FrameArena::~FrameArena() {
+    for (auto* block : overflow_blocks_) delete[] block;
+    delete[] buffer_;
+}
+
+void* FrameArena::alloc(size_t bytes, size_t align) {
+    if (bytes == 0) bytes = 1;
+
+    size_t start = alignUp(offset_, align);
+    if (start + bytes <= capacity_) {
+        offset_ = start + bytes;
+        return buffer_ + start;
+    }
+
+    // Main block exhausted: serve from a dedicated heap block for the rest of this frame
+    unsigned char* block = new unsigned char[bytes + align];
+    overflow_blocks_.push_back(block);
+    overflow_bytes_ += bytes + align;
+
+    uintptr_t p = reinterpret_cast<uintptr_t>(block);
+    return reinterpret_cast<void*>(alignUp(p, align));
+}
+
+void FrameArena::reset() {
+    size_t frame_bytes = used();
+    high_water_ = std::max(high_water_, frame_bytes);
+
+    if (!overflow_blocks_.empty()) {
+        for (auto* block : overflow_blocks_) delete[] block;
+        overflow_blocks_.clear();
+
+        // Grow once with headroom so steady-state frames stay inside a single block
+        size_t new_capacity = std::max(capacity_ * 2, frame_bytes + frame_bytes / 2);
+        delete[] buffer_;
+        buffer_ = new unsigned char[new_capacity];
+        capacity_ = new_capacity;
+    }
+
+    offset_ = 0;
+    overflow_bytes_ = 0;
+}
@@ -0,0 +1,89 @@
+//
+//
+// Santiago Quintana Moreno A01571222
+// Created on: 18/10/2026.
+#pragma once
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+// Bump allocator for data that only lives for one UI frame (alert lists, scratch arrays).
+// Everything handed out is released at once by reset(), which is called right after ImGui::NewFrame().
+class FrameArena {
+public:
+    explicit FrameArena(size_t capacity_bytes = 64 * 1024);
+    ~FrameArena();
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    void* alloc(size_t bytes, size_t align = alignof(std::max_align_t));
+
+    template <typename T>
+    T* allocArray(size_t count) {
+        static_assert(std::is_trivially_destructible_v<T>, "FrameArena never runs destructors");
+        return static_cast<T*>(alloc(sizeof(T) * count, alignof(T)));
+    }
+
+    // Release everything allocated this frame. If the frame spilled into overflow blocks,
+    // the main block grows so the next frames fit without touching the heap again.
+    void reset();
+
+    size_t used() const { return offset_ + overflow_bytes_; }
+    size_t capacity() const { return capacity_; }
+    size_t highWater() const { return high_water_; }
+
+private:
+    unsigned char* buffer_ = nullptr;
+    size_t capacity_ = 0;
+    size_t offset_ = 0;
+    size_t high_water_ = 0;
+
+    // Blocks allocated when a frame outgrows the main buffer (freed on reset)
+    std::vector<unsigned char*> overflow_blocks_;
+    size_t overflow_bytes_ = 0;
+};
+
+// Arena-backed growable array for trivially copyable UI data (e.g. const Alert* lists).
+// Growth reallocates inside the arena; the old storage is simply abandoned until reset().
+template <typename T>
+class FrameVector {
+    static_assert(std::is_trivially_copyable_v<T>, "FrameVector only holds trivially copyable types");
+
+public:
+    explicit FrameVector(FrameArena& arena, size_t initial_capacity = 16)
+        : arena_(&arena), data_(arena.allocArray<T>(initial_capacity)), capacity_(initial_capacity) {}
+
+    void push_back(const T& value) {
+        if (size_ == capacity_) grow();
+        data_[size_++] = value;
+    }
+
+    void clear() { size_ = 0; }
+
+    T& operator[](size_t i) { return data_[i]; }
+    const T& operator[](size_t i) const { return data_[i]; }
+
+    T* begin() { return data_; }
+    T* end() { return data_ + size_; }
+    const T* begin() const { return data_; }
+    const T* end() const { return data_ + size_; }
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+private:
+    void grow() {
+        size_t new_capacity = capacity_ ? capacity_ * 2 : 16;
+        T* new_data = arena_->allocArray<T>(new_capacity);
+        if (size_ > 0) std::memcpy(new_data, data_, sizeof(T) * size_);
+        data_ = new_data;
+        capacity_ = new_capacity;
+    }
+
+    FrameArena* arena_;
+    T* data_;
+    size_t size_ = 0;
+    size_t capacity_;
+};
@@ -0,0 +1,395 @@
+//
+//
+// Santiago Quintana Moreno A01571222
+// Created on: 18/10/2026.
+#include "frame_export.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+
+bool parseImageFormat(const char* name, ImageFormat& format) {
+    if (std::strcmp(name, "qoi") == 0) {
+        format = ImageFormat::QOI;
+        return true;
+    }
+    if (std::strcmp(name, "png") == 0) {
+        format = ImageFormat::PNG;
+        return true;
+    }
+    return false;
+}
+
+const char* imageExtension(ImageFormat format) {
+    return format == ImageFormat::PNG ? "png" : "qoi";
+}
+
+static void putBE32(std::vector<uint8_t>& out, uint32_t v) {
+    out.push_back((uint8_t)(v >> 24));
+    out.push_back((uint8_t)(v >> 16));
+    out.push_back((uint8_t)(v >> 8));
+    out.push_back((uint8_t)v);
+}
+
+// ========== QOI ==========
+// https://qoiformat.org/qoi-specification.pdf
+
+void encodeQoi(const uint8_t* rgba, int width, int height, std::vector<uint8_t>& out) {
+    enum : uint8_t { OP_INDEX = 0x00, OP_DIFF = 0x40, OP_LUMA = 0x80, OP_RUN = 0xC0, OP_RGB = 0xFE, OP_RGBA = 0xFF };
+
+    out.clear();
+    out.reserve((size_t)width * height + 22);
+    out.insert(out.end(), {'q', 'o', 'i', 'f'});
+    putBE32(out, (uint32_t)width);
+    putBE32(out, (uint32_t)height);
+    out.push_back(4);       // RGBA
+    out.push_back(0);       // sRGB
+
+    uint8_t index[64][4] = {};
+    uint8_t prev[4] = {0, 0, 0, 255};
+    int run = 0;
+    size_t pixels = (size_t)width * height;
+
+    for (size_t i = 0; i < pixels; ++i) {
+        const uint8_t* px = rgba + i * 4;
+        if (std::memcmp(px, prev, 4) == 0) {
+            if (++run == 62 || i + 1 == pixels) {
+                out.push_back((uint8_t)(OP_RUN | (run - 1)));
+                run = 0;
+            }
+            continue;
+        }
+        if (run > 0) {
+            out.push_back((uint8_t)(OP_RUN | (run - 1)));
+            run = 0;
+        }
+
+        int slot = (px[0] * 3 + px[1] * 5 + px[2] * 7 + px[3] * 11) % 64;
+        if (std::memcmp(index[slot], px, 4) == 0) {
+            out.push_back((uint8_t)(OP_INDEX | slot));
+        } else {
+            std::memcpy(index[slot], px, 4);
+            if (px[3] == prev[3]) {
+                int8_t dr = (int8_t)(px[0] - prev[0]);
+                int8_t dg = (int8_t)(px[1] - prev[1]);
+                int8_t db = (int8_t)(px[2] - prev[2]);
+                int8_t dr_dg = (int8_t)(dr - dg);
+                int8_t db_dg = (int8_t)(db - dg);
+                if (dr >= -2 && dr <= 1 && dg >= -2 && dg <= 1 && db >= -2 && db <= 1) {
+                    out.push_back((uint8_t)(OP_DIFF | (dr + 2) << 4 | (dg + 2) << 2 | (db + 2)));
+                } else if (dg >= -32 && dg <= 31 && dr_dg >= -8 && dr_dg <= 7 && db_dg >= -8 && db_dg <= 7) {
+                    out.push_back((uint8_t)(OP_LUMA | (dg + 32)));
+                    out.push_back((uint8_t)((dr_dg + 8) << 4 | (db_dg + 8)));
+                } else {
+                    out.insert(out.end(), {OP_RGB, px[0], px[1], px[2]});
+                }
+            } else {
+                out.insert(out.end(), {OP_RGBA, px[0], px[1], px[2], px[3]});
+            }
+        }
+        std::memcpy(prev, px, 4);
+    }
+    out.insert(out.end(), {0, 0, 0, 0, 0, 0, 0, 1});
+}
+
+// ========== PNG ==========
+// One IDAT with a single fixed-Huffman deflate block. Matches are only tried against the
+// previous pixel and the pixel above, which is where flat panel backgrounds repeat. Larger
+// files than zlib would make, but cheap and with no dependency.
+
+struct CrcTable {
+    uint32_t entry[256];
+};
+
+static CrcTable buildCrcTable() {
+    CrcTable table;
+    for (uint32_t n = 0; n < 256; ++n) {
+        uint32_t c = n;
+        for (int k = 0; k < 8; ++k) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+        table.entry[n] = c;
+    }
+    return table;
+}
+
+static const CrcTable CRC = buildCrcTable();
+
+static uint32_t crc32(const uint8_t* data, size_t size) {
+    uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < size; ++i) crc = CRC.entry[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    return ~crc;
+}
+
+static uint32_t adler32(const uint8_t* data, size_t size) {
+    uint32_t a = 1, b = 0;
+    while (size > 0) {
+        size_t chunk = std::min<size_t>(size, 5552);       // Largest run without overflow
+        for (size_t i = 0; i < chunk; ++i) {
+            a += data[i];
+            b += a;
+        }
+        a %= 65521;
+        b %= 65521;
+        data += chunk;
+        size -= chunk;
+    }
+    return (b << 16) | a;
+}
+
+// LSB-first bit stream, as deflate wants it
+struct BitWriter {
+    std::vector<uint8_t>& out;
+    uint64_t bits = 0;
+    int count = 0;
+
+    void put(uint32_t value, int n) {
+        bits |= (uint64_t)value << count;
+        count += n;
+        while (count >= 8) {
+            out.push_back((uint8_t)bits);
+            bits >>= 8;
+            count -= 8;
+        }
+    }
+    void flush() {
+        if (count > 0) out.push_back((uint8_t)bits);
+        bits = 0;
+        count = 0;
+    }
+};
+
+// Fixed Huffman codes (RFC 1951 3.2.6), bit-reversed once since Huffman codes are sent
+// MSB-first in an LSB-first stream
+struct FixedCodes {
+    uint16_t literal[288];
+    uint8_t literal_bits[288];
+    uint16_t distance[30];
+};
+
+static uint16_t reverseBits(uint32_t code, int n) {
+    uint32_t reversed = 0;
+    for (int i = 0; i < n; ++i) reversed |= ((code >> i) & 1) << (n - 1 - i);
+    return (uint16_t)reversed;
+}
+
+static FixedCodes buildFixedCodes() {
+    FixedCodes codes;
+    for (int symbol = 0; symbol < 288; ++symbol) {
+        uint32_t code;
+        int bits;
+        if (symbol < 144) { code = 0x30 + symbol; bits = 8; }
+        else if (symbol < 256) { code = 0x190 + symbol - 144; bits = 9; }
+        else if (symbol < 280) { code = symbol - 256; bits = 7; }
+        else { code = 0xC0 + symbol - 280; bits = 8; }
+        codes.literal[symbol] = reverseBits(code, bits);
+        codes.literal_bits[symbol] = (uint8_t)bits;
+    }
+    for (int d = 0; d < 30; ++d) codes.distance[d] = reverseBits(d, 5);
+    return codes;
+}
+
+static const FixedCodes FIXED = buildFixedCodes();
+
+static void putFixedLiteral(BitWriter& w, int symbol) {
+    w.put(FIXED.literal[symbol], FIXED.literal_bits[symbol]);
+}
+
+static const uint16_t LENGTH_BASE[29] = {3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+                                         35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+static const uint8_t LENGTH_EXTRA[29] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+static const uint16_t DIST_BASE[30] = {1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769,
+                                       1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577};
+static const uint8_t DIST_EXTRA[30] = {0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+
+static void putMatch(BitWriter& w, int length, int distance) {
+    int l = 28;
+    while (LENGTH_BASE[l] > length) --l;
+    putFixedLiteral(w, 257 + l);
+    w.put(length - LENGTH_BASE[l], LENGTH_EXTRA[l]);
+    int d = 29;
+    while (DIST_BASE[d] > distance) --d;
+    w.put(FIXED.distance[d], 5);
+    w.put(distance - DIST_BASE[d], DIST_EXTRA[d]);
+}
+
+static size_t matchLength(const uint8_t* data, size_t at, size_t size, size_t distance) {
+    if (distance > at) return 0;
+    size_t limit = std::min<size_t>(258, size - at);
+    size_t n = 0;
+    while (n < limit && data[at + n] == data[at + n - distance]) ++n;
+    return n;
+}
+
+static void putChunk(std::vector<uint8_t>& out, const char* type, const uint8_t* data, size_t size) {
+    putBE32(out, (uint32_t)size);
+    size_t start = out.size();
+    out.insert(out.end(), type, type + 4);
+    if (size) out.insert(out.end(), data, data + size);
+    putBE32(out, crc32(out.data() + start, out.size() - start));
+}
+
+void encodePng(const uint8_t* rgba, int width, int height, std::vector<uint8_t>& out) {
+    // Scanlines with filter type 0 (None)
+    size_t stride = (size_t)width * 4 + 1;
+    std::vector<uint8_t> raw(stride * height);
+    for (int y = 0; y < height; ++y) {
+        raw[y * stride] = 0;
+        std::memcpy(&raw[y * stride + 1], rgba + (size_t)y * width * 4, (size_t)width * 4);
+    }
+
+    std::vector<uint8_t> z;
+    z.reserve(raw.size() / 4 + 64);
+    z.push_back(0x78);      // zlib: deflate, 32K window
+    z.push_back(0x01);
+    BitWriter w{z};
+    w.put(1, 1);            // BFINAL
+    w.put(1, 2);            // Fixed Huffman
+
+    bool up_ok = stride <= 32768;
+    for (size_t i = 0; i < raw.size();) {
+        size_t left = matchLength(raw.data(), i, raw.size(), 4);
+        size_t up = up_ok ? matchLength(raw.data(), i, raw.size(), stride) : 0;
+        size_t best = std::max(left, up);
+        if (best >= 3) {
+            putMatch(w, (int)best, (int)(up >= left ? stride : 4));
+            i += best;
+        } else {
+            putFixedLiteral(w, raw[i]);
+            ++i;
+        }
+    }
+    putFixedLiteral(w, 256);
+    w.flush();
+    putBE32(z, adler32(raw.data(), raw.size()));
+
+    out.clear();
+    static const uint8_t SIGNATURE[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    out.insert(out.end(), SIGNATURE, SIGNATURE + 8);
+    std::vector<uint8_t> ihdr;
+    putBE32(ihdr, (uint32_t)width);
+    putBE32(ihdr, (uint32_t)height);
+    ihdr.insert(ihdr.end(), {8, 6, 0, 0, 0});      // 8-bit RGBA, deflate, no interlace
+    putChunk(out, "IHDR", ihdr.data(), ihdr.size());
+    putChunk(out, "IDAT", z.data(), z.size());
+    putChunk(out, "IEND", nullptr, 0);
+}
+
+// ========== FrameEncoderPool ==========
+
+FrameEncoderPool::~FrameEncoderPool() {
+    finish();
+}
+
+bool FrameEncoderPool::start(const std::string& directory, ImageFormat format, int width, int height, int threads, int buffers,
+                             std::string& error) {
+    if (width <= 0 || height <= 0) {
+        error = "export: empty frame size";
+        return false;
+    }
+    std::error_code ec;
+    std::filesystem::create_directories(directory, ec);
+    if (ec) {
+        error = "export: cannot create " + directory + ": " + ec.message();
+        return false;
+    }
+
+    directory_ = directory;
+    format_ = format;
+    width_ = width;
+    height_ = height;
+    if (threads <= 0) threads = std::max(1, (int)std::thread::hardware_concurrency() - 1);
+    buffers = std::max(buffers, threads + 1);
+
+    size_t frame_bytes = (size_t)width * height * 4;
+    for (int i = 0; i < buffers; ++i) {
+        storage_.emplace_back(new uint8_t[frame_bytes]);
+        free_.push_back(storage_.back().get());
+    }
+    stopping_ = false;
+    for (int i = 0; i < threads; ++i) workers_.emplace_back(&FrameEncoderPool::workerLoop, this);
+    return true;
+}
+
+uint8_t* FrameEncoderPool::acquire() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (free_.empty()) {
+        ++stats_.producer_waits;
+        buffer_free_.wait(lock, [this] { return !free_.empty(); });
+    }
+    uint8_t* frame = free_.back();
+    free_.pop_back();
+    return frame;
+}
+
+void FrameEncoderPool::submit(uint8_t* frame, uint64_t index) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        queue_.push_back({frame, index});
+    }
+    work_ready_.notify_one();
+}
+
+void FrameEncoderPool::release(uint8_t* frame) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        free_.push_back(frame);
+    }
+    buffer_free_.notify_one();
+}
+
+void FrameEncoderPool::finish() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    work_ready_.notify_all();
+    for (std::thread& worker : workers_) worker.join();
+    workers_.clear();
+}
+
+ExportStats FrameEncoderPool::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+void FrameEncoderPool::workerLoop() {
+    std::vector<uint8_t> encoded;
+    char path[1024];
+    for (;;) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            work_ready_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+            if (queue_.empty()) return;         // Stopping and drained
+            job = queue_.front();
+            queue_.pop_front();
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        if (format_ == ImageFormat::PNG) encodePng(job.frame, width_, height_, encoded);
+        else encodeQoi(job.frame, width_, height_, encoded);
+
+        // The pixels are no longer needed once encoded
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            free_.push_back(job.frame);
+        }
+        buffer_free_.notify_one();
+
+        std::snprintf(path, sizeof(path), "%s/frame_%06llu.%s", directory_.c_str(), (unsigned long long)job.index,
+                      imageExtension(format_));
+        FILE* file = std::fopen(path, "wb");
+        bool ok = file && std::fwrite(encoded.data(), 1, encoded.size(), file) == encoded.size();
+        if (file && std::fclose(file) != 0) ok = false;
+        double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats_.encode_sec += sec;
+        if (ok) {
+            ++stats_.frames;
+            stats_.bytes += encoded.size();
+        } else {
+            ++stats_.write_errors;
+        }
+    }
+}
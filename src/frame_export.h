@@ -0,0 +1,91 @@
+//
+//
+// Santiago Quintana Moreno A01571222
+// Created on: 18/10/2026.
+#pragma once
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// ========== Frame Export ==========
+// Image sequences from offscreen replays (debrief videos, visual regression). Frames are
+// RGBA8 in R, G, B, A byte order with tightly packed rows.
+//
+// Encoding runs on a pool of worker threads. The renderer takes a buffer from the pool,
+// fills it and submits it, and keeps going; it only waits when every buffer is queued.
+
+enum class ImageFormat : uint8_t {
+    QOI,                                // "Quite OK Image": lossless, several times faster than PNG
+    PNG,                                // Deflate with fixed Huffman codes and run matches only
+};
+
+// "qoi" or "png"
+bool parseImageFormat(const char* name, ImageFormat& format);
+const char* imageExtension(ImageFormat format);
+
+void encodeQoi(const uint8_t* rgba, int width, int height, std::vector<uint8_t>& out);
+void encodePng(const uint8_t* rgba, int width, int height, std::vector<uint8_t>& out);
+
+struct ExportStats {
+    uint64_t frames = 0;                // Frames written
+    uint64_t bytes = 0;                 // File bytes written
+    uint64_t write_errors = 0;
+    uint64_t producer_waits = 0;        // acquire() calls that found no free buffer
+    double encode_sec = 0.0;            // Encoding + writing, summed over workers
+};
+
+class FrameEncoderPool {
+public:
+    FrameEncoderPool() = default;
+    ~FrameEncoderPool();
+
+    FrameEncoderPool(const FrameEncoderPool&) = delete;
+    FrameEncoderPool& operator=(const FrameEncoderPool&) = delete;
+
+    // Frames go to 'directory'/frame_NNNNNN.<ext>. threads <= 0: one per core but one (the
+    // renderer keeps a core); 'buffers' frames can be in flight at once.
+    bool start(const std::string& directory, ImageFormat format, int width, int height, int threads, int buffers,
+               std::string& error);
+
+    // A free width * height * 4 byte frame; blocks while all buffers are queued
+    uint8_t* acquire();
+    // Queues an acquired buffer as frame 'index'
+    void submit(uint8_t* frame, uint64_t index);
+    // Hands an acquired buffer back unused (the frame could not be captured)
+    void release(uint8_t* frame);
+
+    // Writes everything queued and joins the workers
+    void finish();
+
+    ExportStats stats() const;
+    int threads() const { return (int)workers_.size(); }
+
+private:
+    struct Job {
+        uint8_t* frame;
+        uint64_t index;
+    };
+
+    void workerLoop();
+
+    std::string directory_;
+    ImageFormat format_ = ImageFormat::QOI;
+    int width_ = 0;
+    int height_ = 0;
+
+    mutable std::mutex mutex_;
+    std::condition_variable work_ready_;
+    std::condition_variable buffer_free_;
+    std::vector<std::unique_ptr<uint8_t[]>> storage_;
+    std::vector<uint8_t*> free_;
+    std::deque<Job> queue_;
+    bool stopping_ = false;
+    ExportStats stats_;
+
+    std::vector<std::thread> workers_;
+};
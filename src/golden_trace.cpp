@@ -0,0 +1,305 @@
+//
+//
+// Santiago Quintana Moreno A01571222
+// Created on: 18/10/2026.
+#include "golden_trace.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <thread>
+
+static const char* const CHANNEL_NAMES[(int)GoldenChannel::COUNT] = {
+    "altitude_ft", "ias_knots", "vs_fpm", "pitch_deg", "roll_deg", "aoa_deg", "heading_deg",
+    "mach", "nz", "thrust", "elevator_deg", "aileron_deg", "law", "alerts", "length",
+};
+
+// Loose enough for last-digit differences between compilers, tight enough that a changed
+// gain or threshold shows up within a few seconds of flight
+static const double DEFAULT_TOLERANCES[GOLDEN_NUMERIC_CHANNELS] = {
+    1.0,     // altitude_ft
+    0.1,     // ias_knots
+    5.0,     // vs_fpm
+    0.02,    // pitch_deg
+    0.02,    // roll_deg
+    0.02,    // aoa_deg
+    0.02,    // heading_deg
+    0.0005,  // mach
+    0.005,   // nz
+    0.001,   // thrust
+    0.05,    // elevator_deg
+    0.05,    // aileron_deg
+};
+
+const char* goldenChannelName(GoldenChannel channel) {
+    return (int)channel < (int)GoldenChannel::COUNT ? CHANNEL_NAMES[(int)channel] : "?";
+}
+
+bool goldenChannelFromName(const char* name, GoldenChannel& out) {
+    for (int i = 0; i < (int)GoldenChannel::COUNT; ++i) {
+        if (std::strcmp(CHANNEL_NAMES[i], name) == 0) {
+            out = (GoldenChannel)i;
+            return true;
+        }
+    }
+    return false;
+}
+
+double goldenDefaultTolerance(GoldenChannel channel) {
+    return (int)channel < GOLDEN_NUMERIC_CHANNELS ? DEFAULT_TOLERANCES[(int)channel] : 0.0;
+}
+
+GoldenTrace::GoldenTrace() {
+    std::copy(std::begin(DEFAULT_TOLERANCES), std::end(DEFAULT_TOLERANCES), tolerance);
+}
+
+// ========== File I/O ==========
+
+bool loadGoldenTrace(const char* path, GoldenTrace& out, std::string& error) {
+    FILE* f = std::fopen(path, "rb");
+    if (!f) {
+        error = std::string("cannot open ") + path;
+        return false;
+    }
+
+    out = GoldenTrace{};
+    char line[1024];
+    int line_no = 0;
+    bool in_data = false;
+    auto fail = [&](const char* reason) {
+        error = std::string(path) + ": line " + std::to_string(line_no) + ": " + reason;
+        std::fclose(f);
+        return false;
+    };
+
+    while (std::fgets(line, sizeof(line), f)) {
+        ++line_no;
+        line[std::strcspn(line, "\r\n")] = '\0';
+        if (line[0] == '\0' || line[0] == '#') continue;
+
+        if (!in_data) {
+            char key[32] = {};
+            char arg1[512] = {};
+            char arg2[64] = {};
+            int n = std::sscanf(line, "%31s %511s %63s", key, arg1, arg2);
+            if (std::strcmp(key, "data") == 0) {
+                in_data = true;
+            } else if (std::strcmp(key, "scenario") == 0 && n >= 2) {
+                out.scenario_path = arg1;
+            } else if (std::strcmp(key, "every") == 0 && n >= 2) {
+                out.every = std::max(1, std::atoi(arg1));
+            } else if (std::strcmp(key, "duration") == 0 && n >= 2) {
+                out.duration_sec = (float)std::atof(arg1);
+            } else if (std::strcmp(key, "tol") == 0 && n == 3) {
+                GoldenChannel ch;
+                if (!goldenChannelFromName(arg1, ch) || (int)ch >= GOLDEN_NUMERIC_CHANNELS) return fail("unknown numeric channel");
+                out.tolerance[(int)ch] = std::atof(arg2);
+            } else {
+                return fail("unknown header line");
+            }
+            continue;
+        }
+
+        if (std::strncmp(line, "step,", 5) == 0) continue;      // Column names
+
+        GoldenSample s;
+        char* p = line;
+        s.step = std::strtol(p, &p, 10);
+        if (*p++ != ',') return fail("bad sample row");
+        s.time_sec = std::strtod(p, &p);
+        for (double& v : s.values) {
+            if (*p++ != ',') return fail("bad sample row");
+            v = std::strtod(p, &p);
+        }
+        if (*p++ != ',') return fail("bad sample row");
+        s.law = (int)std::strtol(p, &p, 10);
+        if (*p++ != ',') return fail("bad sample row");
+        s.alerts = std::strtoull(p, &p, 16);
+        out.samples.push_back(s);
+    }
+    std::fclose(f);
+
+    if (out.scenario_path.empty()) {
+        error = std::string(path) + ": no scenario line";
+        return false;
+    }
+    return true;
+}
+
+bool saveGoldenTrace(const char* path, const GoldenTrace& trace, std::string& error) {
+    FILE* f = std::fopen(path, "w");
+    if (!f) {
+        error = std::string("cannot write ") + path;
+        return false;
+    }
+
+    std::fprintf(f, "# Golden trajectory, regenerate with PRIM_golden --update\n");
+    std::fprintf(f, "scenario %s\n", trace.scenario_path.c_str());
+    std::fprintf(f, "every    %d\n", trace.every);
+    std::fprintf(f, "duration %g\n", trace.duration_sec);
+    for (int i = 0; i < GOLDEN_NUMERIC_CHANNELS; ++i) {
+        if (trace.tolerance[i] != DEFAULT_TOLERANCES[i]) std::fprintf(f, "tol      %s %g\n", CHANNEL_NAMES[i], trace.tolerance[i]);
+    }
+    std::fprintf(f, "data\nstep,time_sec");
+    for (int i = 0; i < GOLDEN_NUMERIC_CHANNELS; ++i) std::fprintf(f, ",%s", CHANNEL_NAMES[i]);
+    std::fprintf(f, ",law,alerts\n");
+
+    for (const GoldenSample& s : trace.samples) {
+        std::fprintf(f, "%ld,%.6f", s.step, s.time_sec);
+        for (double v : s.values) std::fprintf(f, ",%.9g", v);     // Round-trips a float exactly
+        std::fprintf(f, ",%d,%016llx\n", s.law, (unsigned long long)s.alerts);
+    }
+
+    bool ok = std::ferror(f) == 0;
+    if (std::fclose(f) != 0) ok = false;
+    if (!ok) error = std::string("error writing ") + path;
+    return ok;
+}
+
+// ========== Record / Compare ==========
+
+static GoldenSample takeSample(const SimState& sim, long step) {
+    GoldenSample s;
+    s.step = step;
+    s.time_sec = sim.time_sec;
+    double* v = s.values;
+    v[(int)GoldenChannel::ALTITUDE_FT] = sim.sensors.altitude_ft;
+    v[(int)GoldenChannel::IAS_KNOTS] = sim.sensors.ias_knots;
+    v[(int)GoldenChannel::VS_FPM] = sim.sensors.vs_fpm;
+    v[(int)GoldenChannel::PITCH_DEG] = sim.sensors.pitch_deg;
+    v[(int)GoldenChannel::ROLL_DEG] = sim.sensors.roll_deg;
+    v[(int)GoldenChannel::AOA_DEG] = sim.sensors.aoa_deg;
+    v[(int)GoldenChannel::HEADING_DEG] = sim.sensors.heading_deg;
+    v[(int)GoldenChannel::MACH] = sim.sensors.mach;
+    v[(int)GoldenChannel::NZ] = sim.sensors.nz;
+    v[(int)GoldenChannel::THRUST] = sim.pilot.thrust;
+    v[(int)GoldenChannel::ELEVATOR_DEG] = sim.prim.surfaces().elevator_deg;
+    v[(int)GoldenChannel::AILERON_DEG] = sim.prim.surfaces().aileron_deg;
+    s.law = (int)sim.prim.fctl_status().law;
+    s.alerts = sim.alerts.shownMask();
+    return s;
+}
+
+bool recordGoldenTrace(const Scenario& scenario, GoldenTrace& trace, std::string& error) {
+    trace.samples.clear();
+
+    SimState sim;
+    ScenarioRunner runner;
+    if (!runner.start(scenario, sim, error)) return false;
+
+    long step = 0;
+    trace.samples.push_back(takeSample(sim, step));
+    while (sim.time_sec < trace.duration_sec) {
+        if (!runner.step(sim)) break;
+        if (++step % trace.every == 0) trace.samples.push_back(takeSample(sim, step));
+    }
+    if (step % trace.every != 0) trace.samples.push_back(takeSample(sim, step));    // Always keep the end state
+    return true;
+}
+
+static double channelError(GoldenChannel channel, double expected, double actual) {
+    double err = std::fabs(actual - expected);
+    if (channel == GoldenChannel::HEADING_DEG) err = std::min(err, 360.0 - std::fmod(err, 360.0));
+    return err;
+}
+
+GoldenComparison compareGoldenTrace(const GoldenTrace& golden, const GoldenTrace& actual) {
+    GoldenComparison cmp;
+    auto diverge = [&cmp](const GoldenSample& g, GoldenChannel ch, double expected, double got) {
+        if (!cmp.passed) return;
+        cmp.passed = false;
+        cmp.step = g.step;
+        cmp.time_sec = g.time_sec;
+        cmp.channel = ch;
+        cmp.expected = expected;
+        cmp.actual = got;
+    };
+
+    size_t n = std::min(golden.samples.size(), actual.samples.size());
+    for (size_t i = 0; i < n; ++i) {
+        const GoldenSample& g = golden.samples[i];
+        const GoldenSample& a = actual.samples[i];
+        ++cmp.samples_compared;
+
+        if (g.step != a.step) {
+            diverge(g, GoldenChannel::LENGTH, (double)g.step, (double)a.step);
+            ++cmp.samples_diverged;
+            break;      // Sampling no longer lines up
+        }
+
+        bool sample_ok = true;
+        for (int c = 0; c < GOLDEN_NUMERIC_CHANNELS; ++c) {
+            double err = channelError((GoldenChannel)c, g.values[c], a.values[c]);
+            cmp.max_error[c] = std::max(cmp.max_error[c], err);
+            if (!(err <= golden.tolerance[c])) {        // NaN counts as out of tolerance
+                diverge(g, (GoldenChannel)c, g.values[c], a.values[c]);
+                sample_ok = false;
+            }
+        }
+        if (g.law != a.law) {
+            diverge(g, GoldenChannel::LAW, g.law, a.law);
+            sample_ok = false;
+        }
+        if (g.alerts != a.alerts) {
+            diverge(g, GoldenChannel::ALERTS, (double)g.alerts, (double)a.alerts);
+            sample_ok = false;
+        }
+        if (!sample_ok) ++cmp.samples_diverged;
+    }
+
+    if (cmp.passed && golden.samples.size() != actual.samples.size()) {
+        // First sample that only one of the traces has
+        const GoldenSample& g = golden.samples.size() > n ? golden.samples[n] : actual.samples[n];
+        double golden_end = golden.samples.empty() ? 0.0 : (double)golden.samples.back().step;
+        double actual_end = actual.samples.empty() ? 0.0 : (double)actual.samples.back().step;
+        diverge(g, GoldenChannel::LENGTH, golden_end, actual_end);
+    }
+    return cmp;
+}
+
+// ========== Suite ==========
+
+bool loadGoldenCase(const char* golden_path, GoldenCase& out, std::string& error) {
+    out.golden_path = golden_path;
+    if (!loadGoldenTrace(golden_path, out.golden, error)) return false;
+
+    std::filesystem::path scenario = std::filesystem::path(golden_path).parent_path() / out.golden.scenario_path;
+    return loadScenarioFile(scenario.string().c_str(), out.scenario, error);
+}
+
+std::vector<GoldenResult> runGoldenSuite(const std::vector<GoldenCase>& cases, int threads) {
+    std::vector<GoldenResult> results(cases.size());
+
+    threads = threads > 0 ? threads : (int)std::thread::hardware_concurrency();
+    threads = std::max(1, std::min(threads, (int)cases.size()));
+
+    // Scenarios differ a lot in length, so workers pull the next case
+    std::atomic<size_t> next{0};
+    auto worker = [&]() {
+        for (size_t i = next.fetch_add(1); i < cases.size(); i = next.fetch_add(1)) {
+            auto start = std::chrono::steady_clock::now();
+            GoldenResult& r = results[i];
+            r.actual.scenario_path = cases[i].golden.scenario_path;
+            r.actual.every = cases[i].golden.every;
+            r.actual.duration_sec = cases[i].golden.duration_sec;
+            std::copy(std::begin(cases[i].golden.tolerance), std::end(cases[i].golden.tolerance), r.actual.tolerance);
+            if (recordGoldenTrace(cases[i].scenario, r.actual, r.error)) {
+                r.comparison = compareGoldenTrace(cases[i].golden, r.actual);
+            } else {
+                r.comparison.passed = false;
+            }
+            r.wall_sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (int i = 1; i < threads; ++i) pool.emplace_back(worker);
+    worker();
+    for (auto& th : pool) th.join();
+
+    return results;
+}
@@ -0,0 +1,113 @@
+//
+//
+// Santiago Quintana Moreno A01571222
+// Created on: 18/10/2026.
+#pragma once
+#include "scenario.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// ========== Golden Trajectories ==========
+// Regression check for the aircraft model and control laws: a scenario is replayed headless
+// and its trajectory compared, sample by sample, against a stored golden trace. Every
+// numeric channel has its own absolute tolerance; the control law and the alert mask must
+// match exactly. The report names the first step and channel that left tolerance.
+//
+// File format (text, one per scenario, conventionally scenarios/golden/<name>.golden):
+//
+//   # comment
+//   scenario ../dual_engine_failure.scn    scenario file, relative to the golden file
+//   every    25                            one sample every N steps (step 0 included)
+//   duration 300                           simulated seconds, unless the script ends first
+//   tol      altitude_ft 1.0               optional tolerance overrides, one per line
+//   data                                   samples follow, one CSV row each:
+//   step,time_sec,<numeric channels in GoldenChannel order>,law,alerts_hex
+
+enum class GoldenChannel : uint8_t {
+    ALTITUDE_FT,
+    IAS_KNOTS,
+    VS_FPM,
+    PITCH_DEG,
+    ROLL_DEG,
+    AOA_DEG,
+    HEADING_DEG,        // Compared modulo 360
+    MACH,
+    NZ,
+    THRUST,
+    ELEVATOR_DEG,
+    AILERON_DEG,
+    NUMERIC_COUNT,      // Channels below are compared exactly
+    LAW = NUMERIC_COUNT,
+    ALERTS,
+    LENGTH,             // Trace ended at a different step
+    COUNT
+};
+
+constexpr int GOLDEN_NUMERIC_CHANNELS = (int)GoldenChannel::NUMERIC_COUNT;
+
+const char* goldenChannelName(GoldenChannel channel);
+bool goldenChannelFromName(const char* name, GoldenChannel& out);
+double goldenDefaultTolerance(GoldenChannel channel);
+
+struct GoldenSample {
+    long step = 0;
+    double time_sec = 0.0;
+    double values[GOLDEN_NUMERIC_CHANNELS] = {};
+    int law = 0;
+    uint64_t alerts = 0;
+};
+
+struct GoldenTrace {
+    std::string scenario_path;           // As written in the file (relative to it)
+    int every = 25;
+    float duration_sec = 300.0f;
+    double tolerance[GOLDEN_NUMERIC_CHANNELS] = {};
+    std::vector<GoldenSample> samples;
+
+    GoldenTrace();
+};
+
+bool loadGoldenTrace(const char* path, GoldenTrace& out, std::string& error);
+bool saveGoldenTrace(const char* path, const GoldenTrace& trace, std::string& error);
+
+// Plays 'scenario' with the trace's every/duration and fills trace.samples. False if the
+// scenario cannot start (see ScenarioRunner::start), with no samples.
+bool recordGoldenTrace(const Scenario& scenario, GoldenTrace& trace, std::string& error);
+
+struct GoldenComparison {
+    bool passed = true;
+    size_t samples_compared = 0;
+    size_t samples_diverged = 0;
+
+    // First divergence (valid when !passed)
+    long step = 0;
+    double time_sec = 0.0;
+    GoldenChannel channel = GoldenChannel::LENGTH;
+    double expected = 0.0;
+    double actual = 0.0;
+
+    double max_error[GOLDEN_NUMERIC_CHANNELS] = {};
+};
+
+GoldenComparison compareGoldenTrace(const GoldenTrace& golden, const GoldenTrace& actual);
+
+struct GoldenCase {
+    std::string golden_path;
+    GoldenTrace golden;
+    Scenario scenario;
+};
+
+struct GoldenResult {
+    std::string error;                  // Why the scenario could not start; nothing else is valid then
+    GoldenTrace actual;
+    GoldenComparison comparison;
+    double wall_sec = 0.0;
+};
+
+// Loads a golden file and the scenario it refers to
+bool loadGoldenCase(const char* golden_path, GoldenCase& out, std::string& error);
+
+// Replays every case spread over worker threads (0 = one per hardware thread) and compares
+// it to its golden trace. Output order matches 'cases'.
+std::vector<GoldenResult> runGoldenSuite(const std::vector<GoldenCase>& cases, int threads);
@@ -0,0 +1,109 @@
+//
+//
+// Santiago Quintana Moreno A01571222
+// Created on: 18/10/2026.
+#include "input_ring.h"
+#include "shm_region.h"
+#include <cstring>
+
+static constexpr uint64_t SLOT_MASK = INPUT_RING_CAPACITY - 1;
+
+static uint32_t magicWord() {
+    uint32_t word;
+    std::memcpy(&word, INPUT_RING_MAGIC, sizeof(word));
+    return word;
+}
+
+// ========== Consumer (sim) ==========
+
+bool InputRingConsumer::open(const char* name, std::string& error) {
+    close();
+
+    void* p = shmCreate(name, sizeof(InputRingRegion), error);
+    if (!p) return false;
+
+    region_ = static_cast<InputRingRegion*>(p);
+    region_->magic.store(0, std::memory_order_relaxed);
+    region_->version = INPUT_RING_VERSION;
+    region_->capacity = INPUT_RING_CAPACITY;
+    region_->command_size = sizeof(InputCommand);
+    region_->consumer_pid = shmProcessId();
+    region_->head.store(0, std::memory_order_relaxed);
+    region_->tail.store(0, std::memory_order_relaxed);
+    region_->rejected.store(0, std::memory_order_relaxed);
+
+    region_->magic.store(magicWord(), std::memory_order_release);
+
+    name_ = name;
+    return true;
+}
+
+void InputRingConsumer::close() {
+    if (!region_) return;
+    shmUnmap(region_, sizeof(InputRingRegion));
+    shmRemove(name_.c_str());
+    region_ = nullptr;
+    name_.clear();
+}
+
+size_t InputRingConsumer::drain(InputCommand* out, size_t max) {
+    if (!region_) return 0;
+
+    uint64_t tail = region_->tail.load(std::memory_order_relaxed);
+    uint64_t head = region_->head.load(std::memory_order_acquire);
+    size_t n = 0;
+    while (tail != head && n < max) {
+        out[n++] = region_->slots[tail & SLOT_MASK];
+        ++tail;
+    }
+    // Hand the slots back to the producer only after they were copied
+    region_->tail.store(tail, std::memory_order_release);
+    return n;
+}
+
+// ========== Producer (external process) ==========
+
+bool InputRingProducer::open(const char* name, std::string& error) {
+    close();
+
+    void* p = shmAttach(name, sizeof(InputRingRegion), true, error);
+    if (!p) return false;
+
+    InputRingRegion* r = static_cast<InputRingRegion*>(p);
+    if (r->magic.load(std::memory_order_acquire) != magicWord()) {
+        error = std::string(name) + ": bad magic, sim not initialised";
+    } else if (r->version != INPUT_RING_VERSION || r->capacity != INPUT_RING_CAPACITY ||
+               r->command_size != sizeof(InputCommand)) {
+        error = std::string(name) + ": ring version " + std::to_string(r->version) +
+                ", this producer expects " + std::to_string(INPUT_RING_VERSION);
+    } else {
+        region_ = r;
+        return true;
+    }
+
+    shmUnmap(p, sizeof(InputRingRegion));
+    return false;
+}
+
+void InputRingProducer::close() {
+    if (!region_) return;
+    shmUnmap(region_, sizeof(InputRingRegion));
+    region_ = nullptr;
+}
+
+bool InputRingProducer::push(InputCommand& cmd) {
+    if (!region_) return false;
+
+    uint64_t head = region_->head.load(std::memory_order_relaxed);
+    uint64_t tail = region_->tail.load(std::memory_order_acquire);
+    if (head - tail >= INPUT_RING_CAPACITY) {
+        region_->rejected.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    cmd.seq = head + 1;
+    cmd.sent_ns = monotonicNanos();
+    region_->slots[head & SLOT_MASK] = cmd;
+    region_->head.store(head + 1, std::memory_order_release);
+    return true;
+}
@@ -0,0 +1,138 @@
+//
+//
+// Santiago Quintana Moreno A01571222
+// Created on: 18/10/2026.
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+// ========== Input Injection Ring ==========
+// External processes (yoke/throttle emulators, automated test drivers) feed pilot inputs,
+// FCU targets and fault toggles through a single-producer / single-consumer ring in a POSIX
+// shared-memory object (default "/prim_input"). The sim creates the object and drains it once
+// per step; one producer process attaches to it.
+//
+// Every command carries the producer's sequence number and a CLOCK_MONOTONIC timestamp
+// (steady_clock, comparable across processes on the same host). The sim echoes the last
+// applied command through the live state export, so a producer can measure input-to-apply
+// and input-to-surface latency.
+//
+// Layout, version 1 (host byte order):
+//
+//   offset 0    char[4]   magic "PINP" (one atomic 32-bit word, stored last by the sim)
+//          4    uint32    version
+//          8    uint32    capacity (slots, power of two)
+//         12    uint32    sizeof(InputCommand)
+//         16    uint32    consumer (sim) process id
+//         64    uint64    head: commands pushed (written by the producer)
+//        128    uint64    tail: commands drained (written by the sim)
+//        192    uint64    rejected: pushes refused because the ring was full
+//        256    InputCommand[capacity]
+
+constexpr uint32_t INPUT_RING_VERSION = 1;
+constexpr uint32_t INPUT_RING_CAPACITY = 1024;
+constexpr char INPUT_RING_MAGIC[4] = { 'P', 'I', 'N', 'P' };
+constexpr const char* INPUT_RING_DEFAULT_NAME = "/prim_input";
+
+enum class InputCommandType : uint16_t {
+    PILOT,      // values = pitch, roll, thrust
+    FCU,        // index = FcuField, values[0] = target or 0/1 for modes
+    FAULT,      // index = FaultId, values[0] = 0/1
+};
+
+enum class FcuField : uint16_t {
+    SPEED_KNOTS,
+    HEADING_DEG,
+    ALTITUDE_FT,
+    VS_FPM,
+    SPD_MODE,
+    HDG_MODE,
+    ALT_MODE,
+    VS_MODE,
+    AUTOTHRUST,
+};
+
+struct InputCommand {
+    uint64_t seq = 0;            // Assigned by push(): ring position + 1. Gap-free: a refused push
+                                 // takes no seq and only counts in 'rejected'
+    uint64_t sent_ns = 0;        // Assigned by push(), monotonicNanos()
+    InputCommandType type = InputCommandType::PILOT;
+    uint16_t index = 0;
+    uint32_t reserved = 0;
+    float values[4] = {};
+};
+
+static_assert(sizeof(InputCommand) == 40, "InputCommand layout changed, bump INPUT_RING_VERSION");
+static_assert(std::is_trivially_copyable_v<InputCommand>, "InputCommand is copied as raw bytes");
+
+inline uint64_t monotonicNanos() {
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+struct InputRingRegion {
+    std::atomic<uint32_t> magic;                 // The bytes of INPUT_RING_MAGIC once the header is valid
+    uint32_t version;
+    uint32_t capacity;
+    uint32_t command_size;
+    uint32_t consumer_pid;
+    alignas(64) std::atomic<uint64_t> head;      // Separate cache lines: each side writes one
+    alignas(64) std::atomic<uint64_t> tail;
+    alignas(64) std::atomic<uint64_t> rejected;
+    alignas(64) InputCommand slots[INPUT_RING_CAPACITY];
+};
+
+static_assert((INPUT_RING_CAPACITY & (INPUT_RING_CAPACITY - 1)) == 0, "capacity must be a power of two");
+static_assert(offsetof(InputRingRegion, slots) == 256, "input ring header layout changed");
+static_assert(std::atomic<uint32_t>::is_always_lock_free && sizeof(std::atomic<uint32_t>) == 4,
+              "magic word must be usable across processes");
+
+// Sim side: creates the object and drains it. Call drain() from the sim thread only.
+class InputRingConsumer {
+public:
+    InputRingConsumer() = default;
+    ~InputRingConsumer() { close(); }
+
+    InputRingConsumer(const InputRingConsumer&) = delete;
+    InputRingConsumer& operator=(const InputRingConsumer&) = delete;
+
+    bool open(const char* name, std::string& error);
+    void close();                    // Unmaps and removes the object
+
+    // Copies up to 'max' pending commands in push order; returns how many
+    size_t drain(InputCommand* out, size_t max);
+
+    uint64_t rejected() const { return region_ ? region_->rejected.load(std::memory_order_relaxed) : 0; }
+    bool isOpen() const { return region_ != nullptr; }
+
+private:
+    InputRingRegion* region_ = nullptr;
+    std::string name_;
+};
+
+// Producer side, for the external process. Only one producer may be attached at a time.
+class InputRingProducer {
+public:
+    InputRingProducer() = default;
+    ~InputRingProducer() { close(); }
+
+    InputRingProducer(const InputRingProducer&) = delete;
+    InputRingProducer& operator=(const InputRingProducer&) = delete;
+
+    bool open(const char* name, std::string& error);
+    void close();
+
+    // Stamps seq and sent_ns into 'cmd' and enqueues it. Never blocks: returns false
+    // (and counts it in the region) when the sim has fallen a full ring behind.
+    bool push(InputCommand& cmd);
+
+    uint32_t consumerPid() const { return region_ ? region_->consumer_pid : 0; }
+    bool isOpen() const { return region_ != nullptr; }
+
+private:
+    InputRingRegion* region_ = nullptr;
+};
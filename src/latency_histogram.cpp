@@ -0,0 +1,69 @@
+//
+//
+// Santiago Quintana Moreno A01571222
+// Created on: 18/10/2026.
+#include "latency_histogram.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+LatencyHistogram::LatencyHistogram() : counts_((BUCKET_COUNT + 1) * HALF_SUB_BUCKETS, 0) {}
+
+uint32_t LatencyHistogram::indexFor(uint64_t value) {
+    int bucket = std::max(0, (int)std::bit_width(value) - SUB_BUCKET_BITS);
+    if (bucket == 0) return (uint32_t)value;
+    // value >> bucket lands in [64, 128): the upper half of a sub-bucket range
+    return (uint32_t)bucket * HALF_SUB_BUCKETS + (uint32_t)(value >> bucket);
+}
+
+uint64_t LatencyHistogram::highestEquivalent(uint32_t index) {
+    if (index < SUB_BUCKETS) return index;
+    uint32_t bucket = index / HALF_SUB_BUCKETS - 1;
+    uint64_t sub = index - bucket * HALF_SUB_BUCKETS;
+    return ((sub + 1) << bucket) - 1;       // Wraps to UINT64_MAX for the very last bucket
+}
+
+void LatencyHistogram::record(uint64_t value_ns) {
+    ++counts_[indexFor(value_ns)];
+    ++total_;
+    sum_ += value_ns;
+    if (value_ns < min_) min_ = value_ns;
+    if (value_ns > max_) max_ = value_ns;
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other) {
+    for (size_t i = 0; i < counts_.size(); ++i) counts_[i] += other.counts_[i];
+    total_ += other.total_;
+    sum_ += other.sum_;
+    min_ = std::min(min_, other.min_);
+    max_ = std::max(max_, other.max_);
+}
+
+void LatencyHistogram::clear() {
+    std::fill(counts_.begin(), counts_.end(), 0);
+    total_ = 0;
+    min_ = UINT64_MAX;
+    max_ = 0;
+    sum_ = 0;
+}
+
+uint64_t LatencyHistogram::valueAtPercentile(double percentile) const {
+    if (total_ == 0) return 0;
+    double fraction = std::clamp(percentile, 0.0, 100.0) / 100.0;
+    uint64_t rank = std::max<uint64_t>(1, (uint64_t)std::ceil(fraction * (double)total_));
+
+    uint64_t seen = 0;
+    for (uint32_t i = 0; i < counts_.size(); ++i) {
+        seen += counts_[i];
+        if (seen >= rank) return std::min(highestEquivalent(i), max_);
+    }
+    return max_;
+}
+
+uint64_t LatencyHistogram::countAbove(uint64_t value_ns) const {
+    uint32_t start = indexFor(value_ns);
+    if (highestEquivalent(start) <= value_ns) ++start;
+    uint64_t n = 0;
+    for (uint32_t i = start; i < counts_.size(); ++i) n += counts_[i];
+    return n;
+}
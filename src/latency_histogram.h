@@ -0,0 +1,52 @@
+//
+//
+// Santiago Quintana Moreno A01571222
+// Created on: 18/10/2026.
+#pragma once
+#include <cstdint>
+#include <vector>
+
+// ========== Latency Histogram ==========
+// HDR-style log-linear histogram of nanosecond latencies. Values below 128 ns get their own
+// bucket; above that each power-of-two range is split into 64 linear sub-buckets, so any
+// recorded value is known to within 1/64 (~1.6%) at every magnitude, from 1 ns to hours,
+// in a fixed ~30 KB table. record() is a few shifts and an increment, cheap enough to run
+// on every sim step.
+//
+// Percentiles report the top of the bucket they fall in (never below the true value), and
+// the exact min and max are kept separately.
+
+class LatencyHistogram {
+public:
+    static constexpr int SUB_BUCKET_BITS = 7;
+    static constexpr uint32_t SUB_BUCKETS = 1u << SUB_BUCKET_BITS;       // 128
+    static constexpr uint32_t HALF_SUB_BUCKETS = SUB_BUCKETS / 2;        // 64
+    static constexpr uint32_t BUCKET_COUNT = 64 - SUB_BUCKET_BITS + 1;   // Covers all of uint64
+
+    LatencyHistogram();
+
+    void record(uint64_t value_ns);
+    void merge(const LatencyHistogram& other);
+    void clear();
+
+    uint64_t count() const { return total_; }
+    uint64_t min() const { return total_ ? min_ : 0; }
+    uint64_t max() const { return max_; }
+    double mean() const { return total_ ? (double)sum_ / (double)total_ : 0.0; }
+
+    // Smallest bucket top such that at least 'percentile' % of the samples are at or below it
+    uint64_t valueAtPercentile(double percentile) const;
+
+    // Samples strictly above 'value_ns' (exact only at bucket boundaries; rounds toward more)
+    uint64_t countAbove(uint64_t value_ns) const;
+
+private:
+    static uint32_t indexFor(uint64_t value);
+    static uint64_t highestEquivalent(uint32_t index);
+
+    std::vector<uint64_t> counts_;
+    uint64_t total_ = 0;
+    uint64_t min_ = UINT64_MAX;
+    uint64_t max_ = 0;
+    uint64_t sum_ = 0;
+};
@@ -0,0 +1,106 @@
+//
+//
+// Santiago Quintana Moreno A01571222
+// Created on: 18/10/2026.
+#include "live_state.h"
+#include "shm_region.h"
+#include <cstring>
+
+static uint32_t magicWord() {
+    uint32_t word;
+    std::memcpy(&word, LIVE_STATE_MAGIC, sizeof(word));
+    return word;
+}
+
+// ========== Writer ==========
+
+bool LiveStateWriter::open(const char* name, std::string& error) {
+    close();
+
+    void* p = shmCreate(name, sizeof(LiveStateRegion), error);
+    if (!p) return false;
+
+    region_ = static_cast<LiveStateRegion*>(p);
+    region_->magic.store(0, std::memory_order_relaxed);
+    region_->version = LIVE_STATE_VERSION;
+    region_->frame_size = sizeof(LiveStateFrame);
+    region_->writer_pid = shmProcessId();
+    region_->sequence.store(0, std::memory_order_relaxed);
+    region_->frame = LiveStateFrame{};
+
+    // Magic last: a reader that sees it also sees a valid header
+    region_->magic.store(magicWord(), std::memory_order_release);
+
+    name_ = name;
+    return true;
+}
+
+void LiveStateWriter::close() {
+    if (!region_) return;
+    shmUnmap(region_, sizeof(LiveStateRegion));
+    shmRemove(name_.c_str());
+    region_ = nullptr;
+    name_.clear();
+}
+
+void LiveStateWriter::publish(const LiveStateFrame& frame) {
+    if (!region_) return;
+
+    uint64_t seq = region_->sequence.load(std::memory_order_relaxed);
+    region_->sequence.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    std::memcpy(&region_->frame, &frame, sizeof(LiveStateFrame));
+
+    region_->sequence.store(seq + 2, std::memory_order_release);
+}
+
+// ========== Reader ==========
+
+bool LiveStateReader::open(const char* name, std::string& error) {
+    close();
+
+    void* p = shmAttach(name, sizeof(LiveStateRegion), false, error);
+    if (!p) return false;
+
+    // One acquire load of the magic, then the header it publishes; read() only runs the seqlock
+    const LiveStateRegion* r = static_cast<const LiveStateRegion*>(p);
+    if (r->magic.load(std::memory_order_acquire) != magicWord()) {
+        error = std::string(name) + ": bad magic, writer not initialised";
+    } else if (r->version != LIVE_STATE_VERSION || r->frame_size != sizeof(LiveStateFrame)) {
+        error = std::string(name) + ": layout version " + std::to_string(r->version) +
+                ", this reader expects " + std::to_string(LIVE_STATE_VERSION);
+    } else {
+        region_ = r;
+        return true;
+    }
+
+    shmUnmap(p, sizeof(LiveStateRegion));
+    return false;
+}
+
+void LiveStateReader::close() {
+    if (!region_) return;
+    shmUnmap(region_, sizeof(LiveStateRegion));
+    region_ = nullptr;
+}
+
+bool LiveStateReader::read(LiveStateFrame& out, int max_attempts) const {
+    if (!region_) return false;
+
+    for (int attempt = 0; attempt < max_attempts; ++attempt) {
+        uint64_t before = region_->sequence.load(std::memory_order_acquire);
+        if (before == 0) return false;         // Nothing published yet
+        if (before & 1) continue;              // Writer mid-copy
+
+        std::memcpy(&out, &region_->frame, sizeof(LiveStateFrame));
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (region_->sequence.load(std::memory_order_relaxed) == before) return true;
+    }
+    return false;
+}
+
+uint64_t LiveStateReader::framesPublished() const {
+    return region_ ? region_->sequence.load(std::memory_order_acquire) / 2 : 0;
+}
@@ -0,0 +1,118 @@
+//
+//
+// Santiago Quintana Moreno A01571222
+// Created on: 18/10/2026.
+#pragma once
+#include "sim_types.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+// ========== Live State Export ==========
+// The sim publishes its state every step into a POSIX shared-memory object (default
+// "/prim_live") for external displays, loggers and test rigs. Layout, version 2:
+//
+//   offset 0   char[4]   magic "PLIV" (one atomic 32-bit word, stored last by the writer)
+//          4   uint32    version
+//          8   uint32    sizeof(LiveStateFrame)
+//         12   uint32    writer process id
+//         16   uint64    sequence (atomic seqlock counter)
+//         24   LiveStateFrame
+//
+// Host byte order; the frame is the plain structs below, so readers must be built from
+// the same sim_types.h. Any change to those structs bumps LIVE_STATE_VERSION.
+//
+// Seqlock: the writer makes the sequence odd, copies the frame, then makes it even again.
+// Readers copy the frame between two sequence loads and retry if they differ or were odd.
+// The writer never waits on readers; sequence / 2 is the number of frames published.
+
+constexpr uint32_t LIVE_STATE_VERSION = 2;
+constexpr char LIVE_STATE_MAGIC[4] = { 'P', 'L', 'I', 'V' };
+constexpr const char* LIVE_STATE_DEFAULT_NAME = "/prim_live";
+
+struct LiveStateFrame {
+    double time_sec = 0.0;
+    Sensors sensors{};
+    Surfaces surfaces{};
+    FlightControlStatus fctl{};
+    EngineData engine{};
+    AutopilotState autopilot{};
+
+    // Bit i refers to AlertManager::all()[i] (publication order, see AlertManager::shownMask)
+    uint64_t alerts_shown = 0;
+    uint64_t alerts_warning = 0;     // Shown and WARNING level
+    uint64_t alerts_caution = 0;     // Shown and CAUTION level
+    bool master_warning = false;
+    bool master_caution = false;
+
+    // Latency echo for the input injection ring (input_ring.h), all monotonicNanos()
+    uint64_t input_seq = 0;          // Last injected command applied
+    uint64_t input_sent_ns = 0;
+    uint64_t input_applied_ns = 0;
+    uint64_t published_ns = 0;       // When this frame was published
+};
+
+struct LiveStateRegion {
+    std::atomic<uint32_t> magic;     // The bytes of LIVE_STATE_MAGIC once the header is valid
+    uint32_t version;
+    uint32_t frame_size;
+    uint32_t writer_pid;
+    std::atomic<uint64_t> sequence;
+    LiveStateFrame frame;
+};
+
+static_assert(std::is_trivially_copyable_v<LiveStateFrame>, "LiveStateFrame is copied as raw bytes");
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "seqlock counter must be usable across processes");
+static_assert(std::atomic<uint32_t>::is_always_lock_free && sizeof(std::atomic<uint32_t>) == 4,
+              "magic word must be usable across processes");
+static_assert(offsetof(LiveStateRegion, frame) == 24, "live state header layout changed");
+
+// Sim side: creates the shared-memory object and publishes frames. Not thread-safe;
+// publish from the sim thread only.
+class LiveStateWriter {
+public:
+    LiveStateWriter() = default;
+    ~LiveStateWriter() { close(); }
+
+    LiveStateWriter(const LiveStateWriter&) = delete;
+    LiveStateWriter& operator=(const LiveStateWriter&) = delete;
+
+    bool open(const char* name, std::string& error);
+    void publish(const LiveStateFrame& frame);
+    void close();                    // Unmaps and removes the object
+
+    bool isOpen() const { return region_ != nullptr; }
+
+private:
+    LiveStateRegion* region_ = nullptr;
+    std::string name_;
+};
+
+// Reader library for external processes: maps the object read-only.
+class LiveStateReader {
+public:
+    LiveStateReader() = default;
+    ~LiveStateReader() { close(); }
+
+    LiveStateReader(const LiveStateReader&) = delete;
+    LiveStateReader& operator=(const LiveStateReader&) = delete;
+
+    // Fails when the object does not exist yet or was written by an incompatible build
+    bool open(const char* name, std::string& error);
+    void close();
+
+    // Consistent copy of the latest frame. False if nothing was published yet, or the
+    // writer kept overwriting it for max_attempts tries.
+    bool read(LiveStateFrame& out, int max_attempts = 100) const;
+
+    // Frames published so far; poll it to detect new data without copying the frame
+    uint64_t framesPublished() const;
+    uint32_t writerPid() const { return region_ ? region_->writer_pid : 0; }
+
+    bool isOpen() const { return region_ != nullptr; }
+
+private:
+    const LiveStateRegion* region_ = nullptr;
+};
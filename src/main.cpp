@@ -7,14 +7,154 @@
 #include "sim_types.h"
 #include "alerts.h"
 #include "prim_core.h"
+#include "sim_state.h"
+#include "scenario.h"
+#include "live_state.h"
+#include "input_ring.h"
+#include "telemetry.h"
+#include "rate_executive.h"
+#include "realtime.h"
+#include "panel_scheduler.h"
+#include "param_history.h"
+#include "static_layer.h"
 #include "ui_panels.h"
 
 #include <algorithm>
+#include <chrono>
 #include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
 
 static float clampf(float v, float lo, float hi) { return std::max(lo, std::min(hi, v)); }
 
-int main(int, char**) {
+int main(int argc, char** argv) {
+    // Optional scenario script: PRIM_sim --scenario scenarios/qf72_adr_spikes.scn
+    Scenario script;
+    bool have_script = false;
+    for (int i = 1; i + 1 < argc; ++i) {
+        if (std::strcmp(argv[i], "--scenario") == 0) {
+            std::string error;
+            if (!loadScenarioFile(argv[i + 1], script, error)) {
+                std::fprintf(stderr, "%s\n", error.c_str());
+                return 1;
+            }
+            have_script = true;
+        }
+    }
+
+    // Free flight aircraft model: PRIM_sim --aero aero/a320.aero --dynamics 6dof (scripts name their own)
+    AeroDatabase aero;
+    FlightModel free_flight_model;
+    for (int i = 1; i + 1 < argc; ++i) {
+        if (std::strcmp(argv[i], "--aero") == 0) {
+            std::string error;
+            if (!aero.load(argv[i + 1], error)) {
+                std::fprintf(stderr, "%s\n", error.c_str());
+                return 1;
+            }
+            free_flight_model.aero = &aero;
+        } else if (std::strcmp(argv[i], "--dynamics") == 0 && !parseDynamicsModel(argv[i + 1], free_flight_model.dynamics)) {
+            std::fprintf(stderr, "--dynamics: expected point or 6dof\n");
+            return 1;
+        }
+    }
+
+    // Optional live state export, input injection and UDP telemetry for external tools:
+    // PRIM_sim --shm [/prim_live] --inject [/prim_input] --udp 127.0.0.1:49100 --udp-every 1
+    LiveStateWriter live_export;
+    InputRingConsumer input_ring;
+    TelemetryStreamer telemetry;
+    TelemetryConfig telemetry_config;
+    bool want_telemetry = false;
+    for (int i = 1; i < argc; ++i) {
+        std::string error;
+        if (std::strcmp(argv[i], "--udp") == 0 && i + 1 < argc) {
+            if (!parseTelemetryTarget(argv[i + 1], telemetry_config, error)) {
+                std::fprintf(stderr, "%s\n", error.c_str());
+                return 1;
+            }
+            want_telemetry = true;
+            continue;
+        }
+        if (std::strcmp(argv[i], "--udp-every") == 0 && i + 1 < argc) {
+            telemetry_config.decimation = std::max(1, std::atoi(argv[i + 1]));
+            continue;
+        }
+
+        bool shm = std::strcmp(argv[i], "--shm") == 0;
+        bool inject = std::strcmp(argv[i], "--inject") == 0;
+        if (!shm && !inject) continue;
+
+        const char* name = (i + 1 < argc && argv[i + 1][0] == '/') ? argv[i + 1]
+                         : (shm ? LIVE_STATE_DEFAULT_NAME : INPUT_RING_DEFAULT_NAME);
+        if (shm ? !live_export.open(name, error) : !input_ring.open(name, error)) {
+            std::fprintf(stderr, "%s\n", error.c_str());
+            return 1;
+        }
+    }
+    if (want_telemetry) {
+        std::string error;
+        if (!telemetry.start(telemetry_config, error)) {
+            std::fprintf(stderr, "%s\n", error.c_str());
+            return 1;
+        }
+    }
+
+    // Free flight runs on the multi-rate executive: PRIM_sim --rates 400,100,20 (dynamics, PRIM, GPWS Hz).
+    // Scripts keep their own fixed dt so they match PRIM_run.
+    RateConfig rate_config;
+    rate_config.max_catchup_sec = 0.05f;     // Same bound as the old per-frame dt clamp; the rest is dropped
+    for (int i = 1; i + 1 < argc; ++i) {
+        std::string error;
+        if (std::strcmp(argv[i], "--rates") == 0 && !parseRateConfig(argv[i + 1], rate_config, error)) {
+            std::fprintf(stderr, "%s\n", error.c_str());
+            return 1;
+        }
+    }
+    RateExecutive executive;
+    {
+        std::string error;
+        if (!executive.configure(rate_config, error)) {
+            std::fprintf(stderr, "%s\n", error.c_str());
+            return 1;
+        }
+    }
+
+    // Opt-in real-time mode: PRIM_sim --rt [CPU] [--rt-prio 80]. The main loop (sim + UI) is pinned,
+    // runs SCHED_FIFO with locked memory and paces itself on absolute deadlines instead of vsync.
+    RealtimeConfig rt_config;
+    bool realtime = false;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--rt") == 0) {
+            realtime = true;
+            if (i + 1 < argc && argv[i + 1][0] >= '0' && argv[i + 1][0] <= '9') rt_config.cpu = std::atoi(argv[i + 1]);
+        } else if (std::strcmp(argv[i], "--rt-prio") == 0 && i + 1 < argc) {
+            rt_config.priority = std::atoi(argv[i + 1]);
+        }
+    }
+
+    // Debrief strip charts: PRIM_sim --history 10,30 (samples per second, minutes kept). Memory is
+    // fixed up front: five channels of raw samples plus their min/max pyramids.
+    ParamHistory history;
+    for (int i = 1; i + 1 < argc; ++i) {
+        std::string error;
+        HistoryConfig history_config;
+        if (std::strcmp(argv[i], "--history") == 0 &&
+            (!parseHistoryConfig(argv[i + 1], history_config, error) || !history.configure(history_config, error))) {
+            std::fprintf(stderr, "%s\n", error.c_str());
+            return 1;
+        }
+    }
+
+    // Panels redraw on their own policies and idle frames are skipped; PRIM_sim --redraw-all
+    // rebuilds every panel on every frame as before
+    PanelScheduler panels;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--redraw-all") == 0) panels.setEnabled(false);
+    }
+
     if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_TIMER) != 0) return 1;
 
     SDL_Window* window = SDL_CreateWindow(
@@ -25,7 +165,8 @@ int main(int, char**) {
     );
     if (!window) return 1;
 
-    SDL_Renderer* renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
+    SDL_Renderer* renderer = SDL_CreateRenderer(window, -1, realtime ? SDL_RENDERER_ACCELERATED
+                                                                     : SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
     if (!renderer) return 1;
 
     IMGUI_CHECKVERSION();
@@ -34,125 +175,230 @@ int main(int, char**) {
 
     ImGui_ImplSDL2_InitForSDLRenderer(window, renderer);
     ImGui_ImplSDLRenderer2_Init(renderer);
+    SetStaticLayerRenderer(renderer);       // Cached PFD backgrounds (render-target textures)
 
     bool running = true;
+    bool paused = false;                    // Pause key (or P): sim holds, the UI sleeps until input
 
-    PilotInput pilot{};
-    Sensors sensors{};
-    Faults faults{};
-    AlertManager alerts{};
-    PrimCore prim{};
-    SimulationSettings sim_settings{};
-    FlapsPosition flaps = FlapsPosition::RETRACTED;
-    AutopilotState autopilot{};
-    TrimSystem trim{};
-    Speedbrakes speedbrakes{};
-    LandingGear gear{};
-    FlightPhase flight_phase = FlightPhase::PREFLIGHT;
-    HydraulicSystem hydraulics{};
-    EngineState engines{};
-    APUState apu{};
-    Weather weather{};
+    SimState sim{};
 
     // Startup scenario selection
     bool scenario_selected = false;
     StartupScenario selected_scenario = StartupScenario::CRUISE_10000FT;
 
+    // Scripts run at their own fixed dt (same as PRIM_run), decoupled from the frame rate
+    ScenarioRunner runner;
+    double script_accum_sec = 0.0;
+    if (have_script) {
+        std::string error;
+        scenario_selected = runner.start(script, sim, error);
+        if (!scenario_selected) std::fprintf(stderr, "PRIM_sim: %s\n", error.c_str());
+    }
+
     uint64_t lastCounter = SDL_GetPerformanceCounter();
     const double freq = (double)SDL_GetPerformanceFrequency();
 
+    // UI rate group: building and submitting a frame must fit in one display refresh
+    RateGroupStats display_stats;
+    display_stats.name = "DISPLAY";
+    SDL_DisplayMode display_mode;
+    display_stats.rate_hz = (SDL_GetCurrentDisplayMode(SDL_GetWindowDisplayIndex(window), &display_mode) == 0 && display_mode.refresh_rate > 0)
+                          ? (float)display_mode.refresh_rate : 60.0f;
+
+    DeadlineClock frame_clock;
+    std::string rt_line;
+    const uint64_t max_logged_misses = 10;
+    if (realtime) {
+        RealtimeStatus rt_status;
+        std::string error;
+        if (!enterRealtime(rt_config, rt_status, error)) std::fprintf(stderr, "PRIM_sim: real-time setup incomplete: %s\n", error.c_str());
+        rt_line = describeRealtime(rt_status);
+        std::fprintf(stderr, "PRIM_sim: %s, frame deadline %.0f Hz\n", rt_line.c_str(), display_stats.rate_hz);
+        frame_clock.start((uint64_t)(1e9 / display_stats.rate_hz));
+    }
+
+    // Longest sleep while nothing needs drawing and the sim is not running. Startup dialog and
+    // pause only change on input, which wakes the wait anyway.
+    const int idle_wait_ms = 250;
+    const int frame_wait_ms = std::max(1, (int)(1000.0f / display_stats.rate_hz));
+    double last_frame_sec = -1e9;
+
+    auto handleEvent = [&](const SDL_Event& event) {
+        ImGui_ImplSDL2_ProcessEvent(&event);
+        if (event.type == SDL_QUIT) running = false;
+        // Target textures lose their contents when the device is reset (Direct3D)
+        if (event.type == SDL_RENDER_TARGETS_RESET || event.type == SDL_RENDER_DEVICE_RESET) InvalidateStaticLayers();
+        if (event.type == SDL_KEYDOWN && !event.key.repeat && scenario_selected &&
+            (event.key.keysym.scancode == SDL_SCANCODE_PAUSE ||
+             (event.key.keysym.scancode == SDL_SCANCODE_P && !ImGui::GetIO().WantCaptureKeyboard))) {
+            paused = !paused;
+        }
+        panels.noteInput((double)SDL_GetPerformanceCounter() / freq);
+    };
+
     while (running) {
         uint64_t now = SDL_GetPerformanceCounter();
         float dt = (float)((now - lastCounter) / freq);
         lastCounter = now;
-        dt = clampf(dt, 0.0f, 0.05f);
+        float script_dt = clampf(dt, 0.0f, 0.05f);
+        dt = clampf(dt, 0.0f, 1.0f);     // Executive caps catch-up and counts what it drops
 
         SDL_Event event;
-        while (SDL_PollEvent(&event)) {
-            ImGui_ImplSDL2_ProcessEvent(&event);
-            if (event.type == SDL_QUIT) running = false;
+        while (SDL_PollEvent(&event)) handleEvent(event);
+
+        // Only run simulation after scenario is selected
+        if (scenario_selected && !paused) {
+            if (runner.active() && !runner.finished()) {
+                script_accum_sec += script_dt;
+                while (script_accum_sec >= script.dt_sec) {
+                    drainInputCommands(input_ring, sim);
+                    if (!runner.step(sim)) break;
+                    script_accum_sec -= script.dt_sec;
+                    publishLiveState(sim, live_export, telemetry);
+                }
+            } else {
+                drainInputCommands(input_ring, sim);
+                executive.advance(sim, dt);
+                publishLiveState(sim, live_export, telemetry);
+            }
+            history.record(sim);
+        }
+
+        // Which panels need rebuilding this frame; the rest are replayed from their last build
+        double now_sec = (double)now / freq;
+        panels.beginFrame();
+        bool draw_master = false, draw_ecam = false, draw_pfd = false, draw_fctl = false, draw_controls = false;
+        bool draw_autopilot = false, draw_sim_op = false, draw_systems = false, draw_scenario = false, draw_executive = false;
+        bool draw_history = false;
+        bool show_executive = !runner.active() || runner.finished();
+        if (scenario_selected) {
+            uint64_t sim_clock = PanelVersion().addBytes(sim.time_sec).value();
+            draw_master = panels.due(Panel::MASTER, now_sec, MasterPanelVersion(sim.alerts));
+            draw_ecam = panels.due(Panel::ECAM, now_sec, EcamPanelVersion(sim.alerts, sim.prim, sim.flaps, sim.engines, sim.apu));
+            draw_pfd = panels.due(Panel::PFD, now_sec, PFDPanelVersion(sim.sensors, sim.prim, sim.pilot, sim.autopilot, sim.faults));
+            draw_fctl = panels.due(Panel::FCTL, now_sec, FctlPanelVersion(sim.prim, sim.faults));
+            draw_controls = panels.due(Panel::CONTROL_INPUT, now_sec, sim_clock);
+            draw_autopilot = panels.due(Panel::AUTOPILOT, now_sec, sim_clock);
+            draw_sim_op = panels.due(Panel::SIM_OPERATION, now_sec, sim_clock);
+            draw_systems = panels.due(Panel::AIRCRAFT_SYSTEMS, now_sec, sim_clock);
+            draw_scenario = runner.active() && panels.due(Panel::SCENARIO, now_sec, sim_clock);
+            draw_executive = show_executive && panels.due(Panel::EXECUTIVE, now_sec, sim_clock);
+            draw_history = panels.due(Panel::HISTORY, now_sec, history.samples());
         }
+        bool build_frame = scenario_selected ? panels.anyDue()
+                                             : panels.interacting(now_sec) || now_sec - last_frame_sec >= idle_wait_ms / 1000.0;
 
-        ImGui_ImplSDLRenderer2_NewFrame();
-        ImGui_ImplSDL2_NewFrame();
-        ImGui::NewFrame();
+        if (build_frame) {
+            last_frame_sec = now_sec;
+            auto ui_start = std::chrono::steady_clock::now();
+            ImGui_ImplSDLRenderer2_NewFrame();
+            ImGui_ImplSDL2_NewFrame();
+            ImGui::NewFrame();
+            BeginUiFrame();
 
-        // Show startup scenario selection dialog
-        if (!scenario_selected) {
-            ImGui::OpenPopup("Select Startup Scenario");
+            // Show startup scenario selection dialog
+            if (!scenario_selected) {
+                ImGui::OpenPopup("Select Startup Scenario");
 
-            ImVec2 center = ImGui::GetMainViewport()->GetCenter();
-            ImGui::SetNextWindowPos(center, ImGuiCond_Appearing, ImVec2(0.5f, 0.5f));
+                ImVec2 center = ImGui::GetMainViewport()->GetCenter();
+                ImGui::SetNextWindowPos(center, ImGuiCond_Appearing, ImVec2(0.5f, 0.5f));
 
-            if (ImGui::BeginPopupModal("Select Startup Scenario", nullptr, ImGuiWindowFlags_AlwaysAutoResize)) {
-                ImGui::Text("Choose initial flight conditions:");
-                ImGui::Separator();
-                ImGui::Spacing();
+                if (ImGui::BeginPopupModal("Select Startup Scenario", nullptr, ImGuiWindowFlags_AlwaysAutoResize)) {
+                    ImGui::Text("Choose initial flight conditions:");
+                    ImGui::Separator();
+                    ImGui::Spacing();
 
-                if (ImGui::Button("Ground Level - Parked", ImVec2(250, 40))) {
-                    selected_scenario = StartupScenario::GROUND_PARKED;
-                    applyStartupScenario(selected_scenario, sensors, pilot, autopilot, gear, engines);
-                    scenario_selected = true;
-                    ImGui::CloseCurrentPopup();
-                }
-                ImGui::Text("  Aircraft on ground, engines off");
-                ImGui::Spacing();
-                ImGui::Spacing();
-
-                if (ImGui::Button("10,000 ft - Cruise", ImVec2(250, 40))) {
-                    selected_scenario = StartupScenario::CRUISE_10000FT;
-                    applyStartupScenario(selected_scenario, sensors, pilot, autopilot, gear, engines);
-                    scenario_selected = true;
-                    ImGui::CloseCurrentPopup();
-                }
-                ImGui::Text("  In flight at 10,000 ft, 250 knots");
-                ImGui::Spacing();
-                ImGui::Spacing();
-
-                if (ImGui::Button("37,000 ft - High Altitude Cruise", ImVec2(250, 40))) {
-                    selected_scenario = StartupScenario::CRUISE_37000FT;
-                    applyStartupScenario(selected_scenario, sensors, pilot, autopilot, gear, engines);
-                    scenario_selected = true;
-                    ImGui::CloseCurrentPopup();
-                }
-                ImGui::Text("  In flight at 37,000 ft, Mach 0.78");
+                    if (ImGui::Button("Ground Level - Parked", ImVec2(250, 40))) {
+                        selected_scenario = StartupScenario::GROUND_PARKED;
+                        initSimulation(sim, selected_scenario, free_flight_model);
+                        executive.reset();
+                        scenario_selected = true;
+                        ImGui::CloseCurrentPopup();
+                    }
+                    ImGui::Text("  Aircraft on ground, engines off");
+                    ImGui::Spacing();
+                    ImGui::Spacing();
 
-                ImGui::EndPopup();
+                    if (ImGui::Button("10,000 ft - Cruise", ImVec2(250, 40))) {
+                        selected_scenario = StartupScenario::CRUISE_10000FT;
+                        initSimulation(sim, selected_scenario, free_flight_model);
+                        executive.reset();
+                        scenario_selected = true;
+                        ImGui::CloseCurrentPopup();
+                    }
+                    ImGui::Text("  In flight at 10,000 ft, 250 knots");
+                    ImGui::Spacing();
+                    ImGui::Spacing();
+
+                    if (ImGui::Button("37,000 ft - High Altitude Cruise", ImVec2(250, 40))) {
+                        selected_scenario = StartupScenario::CRUISE_37000FT;
+                        initSimulation(sim, selected_scenario, free_flight_model);
+                        executive.reset();
+                        scenario_selected = true;
+                        ImGui::CloseCurrentPopup();
+                    }
+                    ImGui::Text("  In flight at 37,000 ft, Mach 0.78");
+
+                    ImGui::EndPopup();
+                }
             }
-        }
 
-        // Only run simulation after scenario is selected
-        if (scenario_selected) {
-            // Detect flight phase
-            flight_phase = prim.detectFlightPhase(sensors, gear, engines);
+            if (draw_master) DrawMasterPanel(sim.alerts);
+            if (draw_ecam) DrawEcamPanel(sim.alerts, sim.sensors, sim.pilot, sim.faults, sim.prim, sim.flaps, sim.engines, sim.apu);
+            if (draw_pfd) DrawPFDPanel(sim.sensors, sim.prim, sim.pilot, sim.autopilot, sim.faults);
+            if (draw_fctl) DrawFctlPanel(sim.prim, sim.faults);
+            if (draw_controls) DrawControlInputPanel(sim.pilot, sim.sensors, sim.faults, sim.settings, sim.flaps);
+            if (draw_autopilot) DrawAutopilotPanel(sim.autopilot, sim.sensors);
+            if (draw_sim_op) DrawSimOperationPanel(sim.weather, sim.faults);
+            if (draw_systems) DrawAircraftSystemsPanel(sim.pilot, sim.flaps, sim.trim, sim.speedbrakes, sim.gear, sim.timers, sim.hydraulics, sim.engines, sim.apu, sim.alerts, sim.autopilot);
 
-            prim.update(pilot, sensors, faults, dt, alerts, autopilot, trim, gear, hydraulics, engines, apu);
+            if (draw_scenario && DrawScenarioPanel(runner, sim.time_sec)) {
+                std::string error;
+                if (!runner.start(script, sim, error)) std::fprintf(stderr, "PRIM_sim: %s\n", error.c_str());
+                script_accum_sec = 0.0;
+            }
+            if (draw_executive) {
+                DrawExecutivePanel(executive, display_stats, realtime ? rt_line.c_str() : nullptr,
+                                   realtime ? &frame_clock.stats() : nullptr);
+            }
+            if (draw_history) DrawHistoryPanel(history);
+            if (paused) DrawPausedBanner();
 
-            // Update flight dynamics unless in manual override mode (for QF72-style scenarios)
-            if (!sim_settings.manual_sensor_override) {
-                prim.updateFlightDynamics(sensors, pilot, flaps, dt, autopilot, speedbrakes, gear, weather, engines, trim);
+            ImGui::Render();
+            panels.endFrame(ImGui::GetDrawData());
+            // A held slider, text field or open combo keeps every panel live without new events
+            if (scenario_selected && (ImGui::IsAnyItemActive() || ImGui::IsPopupOpen("", ImGuiPopupFlags_AnyPopupId | ImGuiPopupFlags_AnyPopupLevel))) {
+                panels.noteInput(now_sec);
             }
+            SDL_SetRenderDrawColor(renderer, 12, 12, 12, 255);
+            SDL_RenderClear(renderer);
+            ImGui_ImplSDLRenderer2_RenderDrawData(ImGui::GetDrawData(), renderer);
+            display_stats.record(std::chrono::duration<double>(std::chrono::steady_clock::now() - ui_start).count());
+            SDL_RenderPresent(renderer);
+        }
 
-            // Update GPWS callouts
-            prim.updateGPWS(sensors, gear, weather, dt);
-
-            DrawMasterPanel(alerts);
-            DrawEcamPanel(alerts, sensors, pilot, faults, prim, flaps, engines, apu);
-            DrawPFDPanel(sensors, prim, pilot, autopilot, faults);
-            DrawFctlPanel(prim, faults);
-            DrawControlInputPanel(pilot, sensors, faults, sim_settings, flaps);
-            DrawAutopilotPanel(autopilot, sensors);
-            DrawSimOperationPanel(weather, faults);
-            DrawAircraftSystemsPanel(pilot, flaps, trim, speedbrakes, gear, hydraulics, engines, apu, alerts, autopilot);
+        uint64_t late_ns = 0;
+        if (realtime) {
+            if (!frame_clock.wait(&late_ns) && frame_clock.stats().misses <= max_logged_misses) {
+                std::fprintf(stderr, "PRIM_sim: frame deadline miss at t=%.2f s, %.1f us late%s\n", sim.time_sec, late_ns / 1000.0,
+                             frame_clock.stats().misses == max_logged_misses ? " (further misses not logged)" : "");
+            }
+        } else if (!build_frame) {
+            // No present to block on vsync: sleep until input, or one display period while the
+            // sim is running so it keeps stepping at the display rate
+            bool sim_running = scenario_selected && !paused;
+            if (SDL_WaitEventTimeout(&event, sim_running ? frame_wait_ms : idle_wait_ms)) handleEvent(event);
         }
+    }
 
-        ImGui::Render();
-        SDL_SetRenderDrawColor(renderer, 12, 12, 12, 255);
-        SDL_RenderClear(renderer);
-        ImGui_ImplSDLRenderer2_RenderDrawData(ImGui::GetDrawData(), renderer);
-        SDL_RenderPresent(renderer);
+    if (realtime) {
+        const DeadlineStats& ds = frame_clock.stats();
+        std::fprintf(stderr, "PRIM_sim: %llu frames, %llu deadline misses (%llu periods skipped), worst %.1f us late\n",
+                     (unsigned long long)ds.frames, (unsigned long long)ds.misses, (unsigned long long)ds.skipped_periods,
+                     ds.max_late_ns / 1000.0);
     }
 
+    ReleaseStaticLayers();
     ImGui_ImplSDLRenderer2_Shutdown();
     ImGui_ImplSDL2_Shutdown();
     ImGui::DestroyContext();
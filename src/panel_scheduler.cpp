@@ -0,0 +1,124 @@
+//
+//
+// Santiago Quintana Moreno A01571222
+// Created on: 18/10/2026.
+#include "panel_scheduler.h"
+#include "imgui.h"
+#include <cstring>
+
+// Must match the titles ui_panels.cpp passes to ImGui::Begin (it uses this table)
+static const char* const PANEL_TITLES[(int)Panel::COUNT] = {
+    "MASTER WARNING/CAUTION",
+    "ECAM E/WD",
+    "PRIMARY FLIGHT DISPLAY",
+    "F/CTL STATUS",
+    "SENSOR OVERRIDE",
+    "AUTOPILOT / FCU",
+    "SIM OPERATION",
+    "AIRCRAFT SYSTEMS AND CONTROL",
+    "SCENARIO",
+    "EXECUTIVE",
+    "PARAMETER HISTORY",
+};
+
+const char* panelTitle(Panel panel) {
+    return PANEL_TITLES[(int)panel];
+}
+
+bool drawListOwnedBy(const ImDrawList* list, const char* title) {
+    // Child windows are named "TITLE/Child_1234"
+    const char* owner = list->_OwnerName;
+    size_t n = std::strlen(title);
+    return owner && std::strncmp(owner, title, n) == 0 && (owner[n] == '\0' || owner[n] == '/');
+}
+
+static int panelOfList(const ImDrawList* list) {
+    for (int i = 0; i < (int)Panel::COUNT; ++i) {
+        if (drawListOwnedBy(list, PANEL_TITLES[i])) return i;
+    }
+    return -1;
+}
+
+PanelScheduler::PanelScheduler() {
+    // The PFD follows the aircraft at display rate, but only while something it shows moves
+    setPolicy(Panel::PFD, {0.0f, true});
+    // Status displays: no faster than a human reads them
+    setPolicy(Panel::MASTER, {10.0f, true});
+    setPolicy(Panel::ECAM, {10.0f, true});
+    setPolicy(Panel::FCTL, {10.0f, true});
+    // Control and bookkeeping panels show many sim values; they are versioned by the sim
+    // clock, so they hold still while the sim is paused
+    setPolicy(Panel::CONTROL_INPUT, {15.0f, true});
+    setPolicy(Panel::AUTOPILOT, {15.0f, true});
+    setPolicy(Panel::SIM_OPERATION, {15.0f, true});
+    setPolicy(Panel::AIRCRAFT_SYSTEMS, {15.0f, true});
+    setPolicy(Panel::SCENARIO, {4.0f, true});
+    setPolicy(Panel::EXECUTIVE, {4.0f, true});
+    // Strip charts move one sample at a time; versioned by the sample count
+    setPolicy(Panel::HISTORY, {4.0f, true});
+}
+
+PanelScheduler::~PanelScheduler() {
+    for (Slot& slot : panels_) clearCache(slot);
+}
+
+void PanelScheduler::clearCache(Slot& slot) {
+    for (ImDrawList* list : slot.cached) IM_DELETE(list);
+    slot.cached.clear();
+}
+
+void PanelScheduler::beginFrame() {
+    for (Slot& slot : panels_) slot.state = FrameState::IDLE;
+    any_due_ = false;
+}
+
+bool PanelScheduler::due(Panel panel, double now_sec, uint64_t version) {
+    Slot& slot = panels_[(int)panel];
+    bool changed = !slot.has_version || version != slot.version;
+
+    bool draw = interacting(now_sec) || slot.cached.empty();
+    if (!draw) {
+        bool cap_ok = slot.policy.max_hz <= 0.0f || now_sec - slot.last_draw_sec >= 1.0 / slot.policy.max_hz;
+        draw = cap_ok && (changed || !slot.policy.on_change);
+    }
+
+    if (!draw) {
+        slot.state = FrameState::SKIPPED;
+        return false;
+    }
+    slot.version = version;
+    slot.has_version = true;
+    slot.last_draw_sec = now_sec;
+    slot.state = FrameState::DRAWN;
+    any_due_ = true;
+    return true;
+}
+
+void PanelScheduler::endFrame(ImDrawData* draw_data) {
+    if (!draw_data) return;
+
+    // Keep what the rebuilt panels just produced
+    for (Slot& slot : panels_) {
+        if (slot.state == FrameState::DRAWN) clearCache(slot);
+    }
+    for (ImDrawList* list : draw_data->CmdLists) {
+        int panel = panelOfList(list);
+        if (panel >= 0 && panels_[panel].state == FrameState::DRAWN) panels_[panel].cached.push_back(list->CloneOutput());
+    }
+
+    // Replay the rest underneath. Skipped panels are not submitted, so ImGui no longer
+    // orders them; putting them first keeps popups and the window being dragged on top.
+    int insert_at = 0;
+    for (int i = 0; i < (int)Panel::COUNT; ++i) {
+        Slot& slot = panels_[i];
+        if (slot.state == FrameState::DRAWN) ++rebuilds_;
+        if (slot.state != FrameState::SKIPPED || slot.cached.empty()) continue;
+        ++replays_;
+        for (ImDrawList* list : slot.cached) {
+            draw_data->CmdLists.insert(draw_data->CmdLists.begin() + insert_at++, list);
+            draw_data->TotalVtxCount += list->VtxBuffer.Size;
+            draw_data->TotalIdxCount += list->IdxBuffer.Size;
+        }
+    }
+    draw_data->CmdListsCount = draw_data->CmdLists.Size;
+}
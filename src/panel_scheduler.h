@@ -0,0 +1,143 @@
+//
+//
+// Santiago Quintana Moreno A01571222
+// Created on: 18/10/2026.
+#pragma once
+#include <cmath>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+struct ImDrawData;
+struct ImDrawList;
+
+// ========== Panel Redraw Policies ==========
+// ImGui rebuilds every window every frame, but most panels change far less often than the
+// display refreshes. Each panel gets a policy: a redraw cap and, optionally, a data version
+// that must have changed. A panel that is not due is not submitted to ImGui at all; the draw
+// lists from its last rebuild are replayed into the frame so it stays on screen unchanged.
+// Any user input rebuilds every panel for a short hold time, so hover, clicks and window
+// drags work as usual. When nothing is due the caller skips the frame entirely and sleeps.
+
+enum class Panel : uint8_t {
+    MASTER,
+    ECAM,
+    PFD,
+    FCTL,
+    CONTROL_INPUT,
+    AUTOPILOT,
+    SIM_OPERATION,
+    AIRCRAFT_SYSTEMS,
+    SCENARIO,
+    EXECUTIVE,
+    HISTORY,
+    COUNT
+};
+
+// ImGui window title of a panel (ui_panels.cpp opens its windows with these)
+const char* panelTitle(Panel panel);
+
+// Whether a draw list comes from the window 'title' or one of its child windows
+bool drawListOwnedBy(const ImDrawList* list, const char* title);
+
+struct PanelPolicy {
+    float max_hz = 0.0f;                // Redraw cap (0 = no cap)
+    bool on_change = false;             // Only redraw when the data version changed
+};
+
+// Folds what a panel shows into a version number (FNV-1a). Floats are quantised to the
+// precision the panel prints, so changes below it do not cause a redraw.
+class PanelVersion {
+public:
+    PanelVersion& add(uint64_t value) {
+        for (int i = 0; i < 8; ++i) {
+            hash_ ^= (value >> (i * 8)) & 0xFF;
+            hash_ *= 1099511628211ull;
+        }
+        return *this;
+    }
+    PanelVersion& add(float value, float resolution) { return add((uint64_t)(int64_t)std::lround(value / resolution)); }
+    PanelVersion& add(const char* text) {
+        for (; *text; ++text) {
+            hash_ ^= (unsigned char)*text;
+            hash_ *= 1099511628211ull;
+        }
+        return add((uint64_t)0);
+    }
+    // Raw bytes of a plain struct: any change at all counts (for panels that run at display rate)
+    template <typename T>
+    PanelVersion& addBytes(const T& value) {
+        static_assert(std::is_trivially_copyable_v<T>, "addBytes needs a plain struct");
+        const unsigned char* bytes = reinterpret_cast<const unsigned char*>(&value);
+        for (size_t i = 0; i < sizeof(T); ++i) {
+            hash_ ^= bytes[i];
+            hash_ *= 1099511628211ull;
+        }
+        return *this;
+    }
+    uint64_t value() const { return hash_; }
+
+private:
+    uint64_t hash_ = 14695981039346656037ull;
+};
+
+class PanelScheduler {
+public:
+    PanelScheduler();
+    ~PanelScheduler();
+
+    PanelScheduler(const PanelScheduler&) = delete;
+    PanelScheduler& operator=(const PanelScheduler&) = delete;
+
+    void setPolicy(Panel panel, PanelPolicy policy) { panels_[(int)panel].policy = policy; }
+
+    // false: every panel is due every frame (no replay)
+    void setEnabled(bool enabled) { enabled_ = enabled; }
+    bool enabled() const { return enabled_; }
+
+    // Input arrived (or a widget is active): every panel is due until now + hold
+    void noteInput(double now_sec) { input_until_sec_ = now_sec + INPUT_HOLD_SEC; }
+    bool interacting(double now_sec) const { return !enabled_ || now_sec < input_until_sec_; }
+
+    // Start of a loop iteration
+    void beginFrame();
+
+    // Whether 'panel' must be rebuilt this frame given its current data version. A true
+    // answer is a commitment: the caller draws the panel if it builds the frame at all.
+    bool due(Panel panel, double now_sec, uint64_t version = 0);
+
+    // True when due() said yes to any panel this iteration
+    bool anyDue() const { return any_due_; }
+
+    // After ImGui::Render(): keeps the draw lists of the panels drawn this frame and replays
+    // the cached lists of the panels that were not (behind every live window)
+    void endFrame(ImDrawData* draw_data);
+
+    // Panels rebuilt / replayed since the last resetCounters()
+    uint64_t rebuilds() const { return rebuilds_; }
+    uint64_t replays() const { return replays_; }
+    void resetCounters() { rebuilds_ = replays_ = 0; }
+
+private:
+    static constexpr double INPUT_HOLD_SEC = 0.5;
+
+    enum class FrameState : uint8_t { IDLE, DRAWN, SKIPPED };
+
+    struct Slot {
+        PanelPolicy policy;
+        uint64_t version = 0;
+        bool has_version = false;
+        double last_draw_sec = -1e9;
+        FrameState state = FrameState::IDLE;
+        std::vector<ImDrawList*> cached;    // Clones of the window's draw lists (and its children)
+    };
+
+    void clearCache(Slot& slot);
+
+    Slot panels_[(int)Panel::COUNT];
+    bool enabled_ = true;
+    bool any_due_ = false;
+    double input_until_sec_ = 0.0;
+    uint64_t rebuilds_ = 0;
+    uint64_t replays_ = 0;
+};
@@ -0,0 +1,214 @@
+//
+//
+// Santiago Quintana Moreno A01571222
+// Created on: 18/10/2026.
+#include "param_history.h"
+#include "sim_state.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+// ========== MinMaxPyramid ==========
+
+void MinMaxPyramid::configure(size_t capacity) {
+    capacity_ = std::max<size_t>(capacity, 1);
+    raw_.assign(capacity_, 0.0f);
+    levels_.clear();
+
+    // Coarsen while a bucket still fits in the ring. One spare bucket per level: the newest
+    // may still be filling while the oldest still holds live samples.
+    for (uint64_t span = FANOUT; span <= capacity_; span *= FANOUT) {
+        Level level;
+        level.span = span;
+        size_t buckets = (size_t)((capacity_ + span - 1) / span) + 1;
+        level.min.assign(buckets, 0.0f);
+        level.max.assign(buckets, 0.0f);
+        levels_.push_back(std::move(level));
+    }
+    count_ = 0;
+}
+
+void MinMaxPyramid::clear() {
+    count_ = 0;
+}
+
+void MinMaxPyramid::push(float value) {
+    if (capacity_ == 0) return;
+    raw_[count_ % capacity_] = value;
+    for (Level& level : levels_) {
+        uint64_t bucket = count_ / level.span;
+        size_t slot = (size_t)(bucket % level.min.size());
+        if (count_ % level.span == 0) {
+            level.min[slot] = value;
+            level.max[slot] = value;
+        } else {
+            level.min[slot] = std::min(level.min[slot], value);
+            level.max[slot] = std::max(level.max[slot], value);
+        }
+    }
+    ++count_;
+}
+
+bool MinMaxPyramid::bucketHeld(const Level& level, uint64_t bucket) const {
+    uint64_t newest = (count_ - 1) / level.span;
+    return bucket + level.min.size() > newest;
+}
+
+HistoryRange MinMaxPyramid::range(uint64_t first, uint64_t last) const {
+    HistoryRange out;
+    first = std::max(first, oldest());
+    last = std::min(last, count_);
+    if (first >= last) return out;
+
+    out.min = out.max = raw_[first % capacity_];
+    out.valid = true;
+
+    // Greedy cover with aligned buckets: from 'first', take the coarsest bucket that starts
+    // there and ends inside the range, else one raw sample. The spans step up towards the
+    // middle of the range and back down, so a range costs O(FANOUT * levels) steps.
+    uint64_t at = first;
+    while (at < last) {
+        int k = (int)levels_.size() - 1;
+        for (; k >= 0; --k) {
+            const Level& level = levels_[k];
+            if (at % level.span == 0 && at + level.span <= last && bucketHeld(level, at / level.span)) break;
+        }
+        if (k < 0) {
+            float v = raw_[at % capacity_];
+            out.min = std::min(out.min, v);
+            out.max = std::max(out.max, v);
+            ++at;
+            continue;
+        }
+        const Level& level = levels_[k];
+        size_t slot = (size_t)((at / level.span) % level.min.size());
+        out.min = std::min(out.min, level.min[slot]);
+        out.max = std::max(out.max, level.max[slot]);
+        at += level.span;
+    }
+    return out;
+}
+
+size_t MinMaxPyramid::memoryBytes() const {
+    size_t bytes = raw_.capacity() * sizeof(float);
+    for (const Level& level : levels_) bytes += (level.min.capacity() + level.max.capacity()) * sizeof(float);
+    return bytes;
+}
+
+// ========== ParamHistory ==========
+
+static const char* const CHANNEL_NAMES[(int)HistoryChannel::COUNT] = {"IAS", "AOA", "ALT", "N1", "PITCH TRIM"};
+static const char* const CHANNEL_UNITS[(int)HistoryChannel::COUNT] = {"kt", "deg", "ft", "%", "deg"};
+
+const char* historyChannelName(HistoryChannel channel) {
+    return CHANNEL_NAMES[(int)channel];
+}
+
+const char* historyChannelUnit(HistoryChannel channel) {
+    return CHANNEL_UNITS[(int)channel];
+}
+
+bool parseHistoryConfig(const char* spec, HistoryConfig& config, std::string& error) {
+    float* fields[] = { &config.sample_hz, &config.span_min };
+    const char* p = spec;
+    for (float* field : fields) {
+        char* end = nullptr;
+        double v = std::strtod(p, &end);
+        if (end == p || v <= 0.0) {
+            error = std::string("history: bad spec '") + spec + "', expected HZ,MINUTES";
+            return false;
+        }
+        *field = (float)v;
+        if (*end == '\0') return true;
+        if (*end != ',') {
+            error = std::string("history: bad spec '") + spec + "', expected HZ,MINUTES";
+            return false;
+        }
+        p = end + 1;
+    }
+    error = std::string("history: too many fields in '") + spec + "'";
+    return false;
+}
+
+ParamHistory::ParamHistory() {
+    std::string error;
+    configure(HistoryConfig{}, error);
+}
+
+bool ParamHistory::configure(const HistoryConfig& config, std::string& error) {
+    double samples = (double)config.sample_hz * config.span_min * 60.0;
+    if (!(config.sample_hz > 0.0f) || !(samples >= 2.0)) {
+        error = "history: rate and span must give at least two samples";
+        return false;
+    }
+    if (samples > 64.0 * 1024 * 1024) {
+        error = "history: more than 64M samples per channel";
+        return false;
+    }
+    config_ = config;
+    for (MinMaxPyramid& channel : channels_) channel.configure((size_t)samples);
+    clear();
+    return true;
+}
+
+void ParamHistory::clear() {
+    for (MinMaxPyramid& channel : channels_) channel.clear();
+    next_period_ = -1;
+}
+
+void ParamHistory::record(const SimState& sim) {
+    int64_t period = (int64_t)std::floor(sim.time_sec * config_.sample_hz);
+    if (next_period_ >= 0 && period + 1 < next_period_) clear();     // Restarted
+    if (next_period_ < 0) next_period_ = period;
+    if (period < next_period_) return;
+
+    float values[(int)HistoryChannel::COUNT] = {
+        sim.sensors.ias_knots,
+        sim.sensors.aoa_deg,
+        sim.sensors.altitude_ft,
+        sim.prim.engine_data().n1_percent,
+        sim.trim.pitch_trim_deg,
+    };
+
+    // A gap longer than the ring only needs the last ring's worth
+    int64_t todo = period - next_period_ + 1;
+    int64_t keep = (int64_t)channels_[0].capacity();
+    if (todo > keep) {
+        for (MinMaxPyramid& channel : channels_) channel.clear();
+        todo = keep;
+    }
+    for (int64_t i = 0; i < todo; ++i) {
+        for (int c = 0; c < (int)HistoryChannel::COUNT; ++c) channels_[c].push(values[c]);
+    }
+    next_period_ = period + 1;
+}
+
+double ParamHistory::newestSec() const {
+    return next_period_ < 0 ? 0.0 : (double)(next_period_ - 1) / config_.sample_hz;
+}
+
+void ParamHistory::envelope(HistoryChannel c, double window_sec, int columns, HistoryRange* out) const {
+    const MinMaxPyramid& channel = channels_[(int)c];
+    double window_samples = window_sec * config_.sample_hz;
+    double end = (double)channel.count();
+    double start = end - window_samples;
+
+    for (int i = 0; i < columns; ++i) {
+        double a = start + window_samples * i / columns;
+        double b = start + window_samples * (i + 1) / columns;
+        if (b <= 0.0) {
+            out[i] = HistoryRange{};
+            continue;
+        }
+        // Columns narrower than a sample still show the sample they fall on
+        uint64_t first = (uint64_t)std::max(0.0, std::floor(a));
+        uint64_t last = std::max(first + 1, (uint64_t)std::ceil(b));
+        out[i] = channel.range(first, last);
+    }
+}
+
+size_t ParamHistory::memoryBytes() const {
+    size_t bytes = 0;
+    for (const MinMaxPyramid& channel : channels_) bytes += channel.memoryBytes();
+    return bytes;
+}
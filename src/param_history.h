@@ -0,0 +1,111 @@
+//
+//
+// Santiago Quintana Moreno A01571222
+// Created on: 18/10/2026.
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct SimState;
+
+// ========== Parameter History ==========
+// Long strip-chart history for debriefs: the last N minutes of a few flight parameters,
+// sampled at a fixed rate of sim time into fixed-size rings.
+//
+// Each channel keeps its raw samples plus a min/max pyramid: level k holds one [min, max]
+// bucket per FANOUT^k samples, updated as samples arrive (O(levels) per sample). Drawing a
+// window of any length folds whole buckets from the coarsest level that fits, so a 30 minute
+// chart costs about the same as a 30 second one: O(columns * levels), not O(samples).
+
+// Min / max of the samples behind one plot column (valid = false when there are none)
+struct HistoryRange {
+    float min = 0.0f;
+    float max = 0.0f;
+    bool valid = false;
+};
+
+class MinMaxPyramid {
+public:
+    static constexpr uint32_t FANOUT = 4;
+
+    // Keeps the last 'capacity' samples; drops everything recorded so far
+    void configure(size_t capacity);
+    void clear();
+
+    void push(float value);
+
+    uint64_t count() const { return count_; }                // Samples pushed since clear()
+    uint64_t oldest() const { return count_ > capacity_ ? count_ - capacity_ : 0; }
+    size_t capacity() const { return capacity_; }
+    float latest() const { return count_ ? raw_[(count_ - 1) % capacity_] : 0.0f; }
+
+    // Min / max of samples [first, last) (absolute indices, clamped to what is still held)
+    HistoryRange range(uint64_t first, uint64_t last) const;
+
+    size_t memoryBytes() const;
+
+private:
+    struct Level {
+        uint64_t span = 0;              // Samples per bucket
+        std::vector<float> min;         // Ring of buckets, bucket j at j % size()
+        std::vector<float> max;
+    };
+
+    bool bucketHeld(const Level& level, uint64_t bucket) const;
+
+    std::vector<float> raw_;
+    std::vector<Level> levels_;         // levels_[0].span == FANOUT
+    size_t capacity_ = 0;
+    uint64_t count_ = 0;
+};
+
+enum class HistoryChannel : uint8_t {
+    IAS,
+    AOA,
+    ALTITUDE,
+    N1,
+    PITCH_TRIM,
+    COUNT
+};
+
+const char* historyChannelName(HistoryChannel channel);
+const char* historyChannelUnit(HistoryChannel channel);
+
+struct HistoryConfig {
+    float sample_hz = 10.0f;            // Samples per second of sim time
+    float span_min = 30.0f;             // Minutes kept per channel
+};
+
+// "HZ,MINUTES", e.g. "10,30"; the span may be omitted
+bool parseHistoryConfig(const char* spec, HistoryConfig& config, std::string& error);
+
+class ParamHistory {
+public:
+    ParamHistory();
+
+    // Sizes every channel for config.span_min at config.sample_hz; drops the history
+    bool configure(const HistoryConfig& config, std::string& error);
+    const HistoryConfig& config() const { return config_; }
+    void clear();
+
+    // Call after advancing the sim. Records one sample per sample period that ended since the
+    // last call (current values held across a gap); sim time going backwards starts over.
+    void record(const SimState& sim);
+
+    const MinMaxPyramid& channel(HistoryChannel c) const { return channels_[(int)c]; }
+    uint64_t samples() const { return channels_[0].count(); }
+    double newestSec() const;           // Sim time of the newest sample
+
+    // The last 'window_sec' seconds split into 'columns' equal slices, oldest first. Slices
+    // before the start of the recording come back invalid.
+    void envelope(HistoryChannel c, double window_sec, int columns, HistoryRange* out) const;
+
+    size_t memoryBytes() const;
+
+private:
+    HistoryConfig config_;
+    MinMaxPyramid channels_[(int)HistoryChannel::COUNT];
+    int64_t next_period_ = -1;          // First period not recorded yet (-1 = nothing yet)
+};
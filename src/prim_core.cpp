@@ -4,46 +4,160 @@
 // Created on: 24/12/2025.
 
 #include "prim_core.h"
-#include <SDL2/SDL.h>
+#include "atmosphere.h"
 #include <algorithm>
 #include <cmath>
+#include <cstring>
 
 static float clampf(float v, float lo, float hi) { return std::max(lo, std::min(hi, v)); }
 static float lerpf(float a, float b, float t) { return a + (b - a) * t; }
+// First-order lag that lands on the target instead of stalling a few denormals short of it
+static float settlef(float a, float b, float t) {
+    float v = lerpf(a, b, t);
+    return std::fabs(v - b) < 1e-6f ? b : v;
+}
+
+// Clean-configuration speed limits (the SPD LIM line of SPD SENS FAULT)
+static const float VMO_KT = 320.0f;
+static const float MMO = 0.82f;
+
+// Alpha protection and alpha floor engage / disengage AoA (hysteresis), and alpha max
+static const float ALPHA_PROT_ENGAGE = 11.0f;
+static const float ALPHA_PROT_DISENGAGE = 9.0f;
+static const float ALPHA_FLOOR_ENGAGE = 14.0f;
+static const float ALPHA_FLOOR_DISENGAGE = 12.5f;
+static const float ALPHA_MAX_AOA = 15.0f;
+
+// Normal law bank angle limit, and the bank it rolls back to with the roll stick released
+static const float MAX_BANK_DEG = 67.0f;
+static const float NEUTRAL_STICK_BANK_DEG = 33.0f;
+static const float ROLL_STICK_NEUTRAL = 0.05f;
+
+// Airspeed switch points of the protections, alerts and ground logic
+static const float ALPHA_PROT_MAX_IAS_KT = 200.0f;   // Alpha protection only below this
+static const float FLAPS_ESTIMATE_IAS_KT = 180.0f;   // V-speeds and BUSS assume CONF 3 below this
+static const float ALPHA_FLOOR_MAX_IAS_KT = 160.0f;  // Alpha floor only below this
+static const float STALL_WARNING_IAS_KT = 140.0f;    // STALL: below this speed and above STALL_WARNING_AOA
+static const float STALL_WARNING_AOA = 12.0f;
+static const float GROUND_SPEED_KT = 80.0f;          // Weight on wheels and taxi below this
+static const float OVERSPEED_MARGIN_KT = 10.0f;      // OVERSPEED above VMO / MMO plus these
+static const float OVERSPEED_MARGIN_MACH = 0.01f;
+static const float HIGH_SPEED_PROT_MARGIN_KT = 20.0f;
+static const float HIGH_SPEED_PROT_MARGIN_MACH = 0.02f;
+
+// Height and vertical speed switch points
+static const float PULL_UP_MAX_ALT_FT = 2500.0f;     // PULL UP: below this and sinking faster than PULL_UP_VS_FPM
+static const float PULL_UP_VS_FPM = -1500.0f;
+static const float GEAR_NOT_DOWN_ALT_FT = 2000.0f;   // L/G NOT DOWN below this
+static const float WINDSHEAR_MAX_ALT_FT = 1500.0f;   // Windshear acts and is annunciated below this
+static const float PHASE_LOW_ALT_FT = 3000.0f;       // Takeoff / approach below, climb above
+static const float PHASE_HIGH_ALT_FT = 10000.0f;     // Cruise / descent above
+static const float PHASE_CLIMB_VS_FPM = 500.0f;      // Climbing above +this, descending below -this
+static const float CALLOUT_ARM_VS_FPM = -300.0f;     // Altitude callouts while sinking faster than this
+static const float CALLOUT_RESET_ALT_FT = 3000.0f;   // Callouts re-arm climbing above this
+static const float RETARD_TOP_FT = 20.0f;            // RETARD window once armed by the 20 ft callout
+static const float RETARD_BOTTOM_FT = 5.0f;
+static const float VMAX_FL100_ALT_FT = 10000.0f;     // 250 kt VMAX below this
+static const float BUSS_CRUISE_ALT_FT = 15000.0f;    // BUSS cruise targets above, climb targets below
+static const float INDUCED_DRAG_AOA = 5.0f;          // Built-in induced drag starts above this AoA
+
+// Radio altitude callouts: each fires once, descending through its window
+struct AltitudeCallout {
+    float top_ft;
+    float bottom_ft;
+    const char* text;
+    float duration_sec;
+    bool GPWSCallouts::* called;
+};
+
+static const AltitudeCallout ALTITUDE_CALLOUTS[] = {
+    { 2500.0f, 2400.0f, "2500", 1.5f, &GPWSCallouts::called_2500 },
+    { 1000.0f, 950.0f,  "1000", 1.5f, &GPWSCallouts::called_1000 },
+    { 500.0f,  480.0f,  "500",  1.0f, &GPWSCallouts::called_500 },
+    { 400.0f,  380.0f,  "400",  1.0f, &GPWSCallouts::called_400 },
+    { 300.0f,  280.0f,  "300",  1.0f, &GPWSCallouts::called_300 },
+    { 200.0f,  180.0f,  "200",  1.0f, &GPWSCallouts::called_200 },
+    { 100.0f,  90.0f,   "100",  1.0f, &GPWSCallouts::called_100 },
+    { 50.0f,   45.0f,   "50",   0.8f, &GPWSCallouts::called_50 },
+    { 40.0f,   35.0f,   "40",   0.8f, &GPWSCallouts::called_40 },
+    { 30.0f,   25.0f,   "30",   0.8f, &GPWSCallouts::called_30 },
+    { 20.0f,   15.0f,   "20",   0.8f, &GPWSCallouts::called_20 },
+    { 10.0f,   5.0f,    "10",   0.8f, &GPWSCallouts::called_10 },
+};
+
+static const float KT_TO_MS = 0.514444f;
+static const float G_MS2 = 9.80665f;
+
+// Aero table gear coordinate: 0 up, 1 down, half way in transit
+static float gearExtension(const LandingGear& gear) {
+    if (gear.position == GearPosition::DOWN) return 1.0f;
+    return (gear.position == GearPosition::TRANSIT) ? 0.5f : 0.0f;
+}
+
+bool parseDynamicsModel(const char* name, DynamicsModel& out) {
+    if (std::strcmp(name, "point") == 0) {
+        out = DynamicsModel::POINT_MASS;
+        return true;
+    }
+    if (std::strcmp(name, "6dof") == 0) {
+        out = DynamicsModel::SIX_DOF;
+        return true;
+    }
+    return false;
+}
+
+const std::vector<SensorThreshold>& primSensorThresholds() {
+    static const std::vector<SensorThreshold> thresholds = [] {
+        std::vector<SensorThreshold> t;
+        auto add = [&](float Sensors::* field, std::initializer_list<float> values) {
+            for (float v : values) t.push_back({field, v});
+        };
+        // Ground contact, GPWS callout windows (they open at their top), RETARD, windshear,
+        // L/G NOT DOWN, PULL UP, phase and callout reset, VMAX below FL100, BUSS
+        add(&Sensors::altitude_ft, {0.0f, RETARD_BOTTOM_FT, RETARD_TOP_FT, WINDSHEAR_MAX_ALT_FT, GEAR_NOT_DOWN_ALT_FT,
+                                    PULL_UP_MAX_ALT_FT, PHASE_LOW_ALT_FT, CALLOUT_RESET_ALT_FT, PHASE_HIGH_ALT_FT,
+                                    VMAX_FL100_ALT_FT, BUSS_CRUISE_ALT_FT});
+        for (const AltitudeCallout& c : ALTITUDE_CALLOUTS) add(&Sensors::altitude_ft, {c.top_ft});
+        add(&Sensors::ias_knots, {GROUND_SPEED_KT, STALL_WARNING_IAS_KT, ALPHA_FLOOR_MAX_IAS_KT, FLAPS_ESTIMATE_IAS_KT,
+                                  ALPHA_PROT_MAX_IAS_KT, VMO_KT + OVERSPEED_MARGIN_KT, VMO_KT + HIGH_SPEED_PROT_MARGIN_KT});
+        add(&Sensors::mach, {MMO + OVERSPEED_MARGIN_MACH, MMO + HIGH_SPEED_PROT_MARGIN_MACH});
+        add(&Sensors::aoa_deg, {INDUCED_DRAG_AOA, ALPHA_PROT_DISENGAGE, ALPHA_PROT_ENGAGE, STALL_WARNING_AOA,
+                                ALPHA_FLOOR_DISENGAGE, ALPHA_FLOOR_ENGAGE, ALPHA_MAX_AOA});
+        // PULL UP, phase, callouts armed, callout reset (climbing)
+        add(&Sensors::vs_fpm, {PULL_UP_VS_FPM, -PHASE_CLIMB_VS_FPM, CALLOUT_ARM_VS_FPM, 0.0f, PHASE_CLIMB_VS_FPM});
+        add(&Sensors::roll_deg, {-MAX_BANK_DEG, -NEUTRAL_STICK_BANK_DEG, NEUTRAL_STICK_BANK_DEG, MAX_BANK_DEG});
+        return t;
+    }();
+    return thresholds;
+}
+
+void PrimCore::setFlightModel(const FlightModel& model) {
+    model_ = model;
+    aero_cursor_ = AeroCursor{};
+    body_.configure(AirframeParams{}, model.aero);
+}
 
 void PrimCore::update(const PilotInput& pilot, const Sensors& s, const Faults& f, float dt_sec, AlertManager& am, AutopilotState& ap,
                       TrimSystem& trim, const LandingGear& gear, HydraulicSystem& hydraulics, const EngineState& engines, const APUState& apu) {
-    // ========== Hydraulic Systems ==========
-    hydraulics.green_avail = !f.green_hyd_fail;
-    hydraulics.blue_avail = !f.blue_hyd_fail;
-    hydraulics.yellow_avail = !f.yellow_hyd_fail;
-
-    // ========== Update Flight Control Status ==========
-    // Need at least one hydraulic system for flight controls
-    bool hydraulics_ok = hydraulics.green_avail || hydraulics.blue_avail || hydraulics.yellow_avail;
-
-    fctl_status_.elac1_avail = !f.elac1_fail && hydraulics_ok;
-    fctl_status_.elac2_avail = !f.elac2_fail && hydraulics_ok;
-    fctl_status_.sec1_avail = !f.sec1_fail && hydraulics_ok;
-
-    // Determine control law based on failures
-    // NORMAL LAW: All ELACs and SECs operational
-    // ALTERNATE LAW: One or more ELAC failures
-    // DIRECT LAW: Multiple critical failures (simplified)
-    if (f.elac1_fail && f.elac2_fail) {
-        fctl_status_.law = ControlLaw::DIRECT;
-    } else if (f.elac1_fail || f.elac2_fail || f.sec1_fail) {
-        fctl_status_.law = ControlLaw::ALTERNATE;
-    } else {
-        fctl_status_.law = ControlLaw::NORMAL;
-    }
+    // ========== Flight Control Reconfiguration ==========
+    // Law, computer/hydraulic availability and authority only change with the faults,
+    // so they come from the cache instead of being re-derived every step
+    const FlightControlReconfig& reconfig = reconfig_cache_.lookup(f);
+
+    hydraulics.green_avail = reconfig.green_avail;
+    hydraulics.blue_avail = reconfig.blue_avail;
+    hydraulics.yellow_avail = reconfig.yellow_avail;
+
+    fctl_status_.elac1_avail = reconfig.elac1_avail;
+    fctl_status_.elac2_avail = reconfig.elac2_avail;
+    fctl_status_.sec1_avail = reconfig.sec1_avail;
+    fctl_status_.sec2_avail = reconfig.sec2_avail;
+    fctl_status_.sec3_avail = reconfig.sec3_avail;
+    fctl_status_.law = reconfig.law;
 
     // Alpha protection: active when AoA high and speed low (only in normal law)
     // With hysteresis to prevent oscillation
-    const float ALPHA_PROT_ENGAGE = 11.0f;
-    const float ALPHA_PROT_DISENGAGE = 9.0f;
-
-    if (fctl_status_.law == ControlLaw::NORMAL && s.ias_knots < 200.0f) {
+    if (fctl_status_.law == ControlLaw::NORMAL && s.ias_knots < ALPHA_PROT_MAX_IAS_KT) {
         if (!alpha_prot_engaged_ && s.aoa_deg > ALPHA_PROT_ENGAGE) {
             alpha_prot_engaged_ = true;  // Engage at 11°
         } else if (alpha_prot_engaged_ && s.aoa_deg < ALPHA_PROT_DISENGAGE) {
@@ -57,28 +171,24 @@ void PrimCore::update(const PilotInput& pilot, const Sensors& s, const Faults& f
 
     // Alpha floor: triggers when AoA very high (unless system failed)
     // With hysteresis
-    static bool alpha_floor_engaged = false;
-    const float ALPHA_FLOOR_ENGAGE = 14.0f;
-    const float ALPHA_FLOOR_DISENGAGE = 12.5f;
-
-    if (!f.alpha_floor_fail && s.ias_knots < 160.0f) {
-        if (!alpha_floor_engaged && s.aoa_deg > ALPHA_FLOOR_ENGAGE) {
-            alpha_floor_engaged = true;
-        } else if (alpha_floor_engaged && s.aoa_deg < ALPHA_FLOOR_DISENGAGE) {
-            alpha_floor_engaged = false;
+    if (!f.alpha_floor_fail && s.ias_knots < ALPHA_FLOOR_MAX_IAS_KT) {
+        if (!alpha_floor_engaged_ && s.aoa_deg > ALPHA_FLOOR_ENGAGE) {
+            alpha_floor_engaged_ = true;
+        } else if (alpha_floor_engaged_ && s.aoa_deg < ALPHA_FLOOR_DISENGAGE) {
+            alpha_floor_engaged_ = false;
         }
-        fctl_status_.alpha_floor = alpha_floor_engaged;
+        fctl_status_.alpha_floor = alpha_floor_engaged_;
     } else {
         fctl_status_.alpha_floor = false;
-        alpha_floor_engaged = false;
+        alpha_floor_engaged_ = false;
     }
 
-    // High speed protection
-    fctl_status_.high_speed_prot = (s.ias_knots > 340.0f) || (s.mach > 0.82f);
+    // High speed protection: VMO + 20 kt, or MMO + 0.02 where Mach limits first (high altitude)
+    fctl_status_.high_speed_prot = (s.ias_knots > VMO_KT + HIGH_SPEED_PROT_MARGIN_KT) || (s.mach > MMO + HIGH_SPEED_PROT_MARGIN_MACH);
 
     // ========== Compute V-Speeds and BUSS ==========
     // Assume clean config for now (can be refined with actual flaps state later)
-    FlapsPosition flaps_est = (s.ias_knots < 180.0f) ? FlapsPosition::CONF_3 : FlapsPosition::RETRACTED;
+    FlapsPosition flaps_est = (s.ias_knots < FLAPS_ESTIMATE_IAS_KT) ? FlapsPosition::CONF_3 : FlapsPosition::RETRACTED;
     computeVSpeeds(s, flaps_est, gear);
     computeBUSS(s, flaps_est, gear, f, pilot.thrust);
 
@@ -94,7 +204,7 @@ void PrimCore::update(const PilotInput& pilot, const Sensors& s, const Faults& f
         "* USE ADR 2 OR 3"
     });
 
-    bool overspeed = (!f.overspeed_sensor_bad) && (s.ias_knots > 330.0f);
+    bool overspeed = (!f.overspeed_sensor_bad) && ((s.ias_knots > VMO_KT + OVERSPEED_MARGIN_KT) || (s.mach > MMO + OVERSPEED_MARGIN_MACH));
     am.set(200, AlertLevel::WARNING, "OVERSPEED", overspeed, false);
     am.set(210, AlertLevel::CAUTION, "SPD SENS FAULT", f.overspeed_sensor_bad, true, {
         "* REDUCE SPEED",
@@ -102,11 +212,11 @@ void PrimCore::update(const PilotInput& pilot, const Sensors& s, const Faults& f
         "* MONITOR ALTITUDE"
     });
 
-    bool stall = (!f.adr1_fail) && (s.ias_knots < 140.0f) && (s.aoa_deg > 12.0f);
+    bool stall = (!f.adr1_fail) && (s.ias_knots < STALL_WARNING_IAS_KT) && (s.aoa_deg > STALL_WARNING_AOA);
     am.set(300, AlertLevel::WARNING, "STALL", stall, false);
 
     // PULL UP warning (GPWS-style terrain alert)
-    bool pull_up = (!f.adr1_fail) && (s.altitude_ft < 2500.0f) && (s.vs_fpm < -1500.0f);
+    bool pull_up = (!f.adr1_fail) && (s.altitude_ft < PULL_UP_MAX_ALT_FT) && (s.vs_fpm < PULL_UP_VS_FPM);
     am.set(310, AlertLevel::WARNING, "PULL UP", pull_up, false);
 
     am.set(400, AlertLevel::CAUTION, "ELAC 1 FAULT", f.elac1_fail, true, {
@@ -209,7 +319,7 @@ void PrimCore::update(const PilotInput& pilot, const Sensors& s, const Faults& f
 
     // Landing gear warnings
     bool gear_disagree = (gear.position == GearPosition::TRANSIT);
-    bool gear_not_down_low_alt = (!gear.weight_on_wheels) && (gear.position != GearPosition::DOWN) && (s.altitude_ft < 2000.0f);
+    bool gear_not_down_low_alt = (!gear.weight_on_wheels) && (gear.position != GearPosition::DOWN) && (s.altitude_ft < GEAR_NOT_DOWN_ALT_FT);
 
     am.set(620, AlertLevel::CAUTION, "L/G DISAGREE", gear_disagree, false);
     am.set(621, AlertLevel::WARNING, "L/G NOT DOWN", gear_not_down_low_alt, false);
@@ -313,27 +423,12 @@ void PrimCore::update(const PilotInput& pilot, const Sensors& s, const Faults& f
         bool shown = (a.active || a.latched);
         if (shown && a.level != AlertLevel::MEMO) { haveAnyNonMemo = true; break; }
     }
-    am.set(900, AlertLevel::MEMO, "NORMAL", !haveAnyNonMemo, false);
+    am.set(1000, AlertLevel::MEMO, "NORMAL", !haveAnyNonMemo, false);
 
     // ========== Control Law Implementation ==========
-    float elevator_authority = 1.0f;
-    float aileron_authority = 1.0f;
-
     // Authority reduction based on control law
-    switch (fctl_status_.law) {
-        case ControlLaw::NORMAL:
-            elevator_authority = 1.0f;
-            aileron_authority = 1.0f;
-            break;
-        case ControlLaw::ALTERNATE:
-            elevator_authority = 0.65f; // Reduced authority
-            aileron_authority = 0.70f;
-            break;
-        case ControlLaw::DIRECT:
-            elevator_authority = 0.45f; // Minimal authority
-            aileron_authority = 0.50f;
-            break;
-    }
+    float elevator_authority = reconfig.elevator_authority;
+    float aileron_authority = reconfig.aileron_authority;
 
     // ========== Autopilot Adjustments ==========
     float effective_pitch = pilot.pitch;
@@ -357,12 +452,14 @@ void PrimCore::update(const PilotInput& pilot, const Sensors& s, const Faults& f
 
     // ========== Bank Angle Protection (Normal Law Only) ==========
     if (fctl_status_.law == ControlLaw::NORMAL && !gear.weight_on_wheels) {
-        float max_bank = 67.0f;  // Maximum bank angle in normal law
-
-        if (std::abs(s.roll_deg) > max_bank) {
+        if (std::abs(s.roll_deg) > MAX_BANK_DEG) {
             // Auto-level when exceeding bank limit
-            float bank_error = (s.roll_deg > 0.0f) ? (max_bank - s.roll_deg) : (-max_bank - s.roll_deg);
+            float bank_error = (s.roll_deg > 0.0f) ? (MAX_BANK_DEG - s.roll_deg) : (-MAX_BANK_DEG - s.roll_deg);
             effective_roll = clampf(bank_error * 0.05f, -1.0f, 1.0f);
+        } else if (std::abs(s.roll_deg) > NEUTRAL_STICK_BANK_DEG && std::abs(pilot.roll) < ROLL_STICK_NEUTRAL) {
+            // Spiral stability: with the stick released the bank comes back to 33 deg, at up to ~6 deg/s
+            float bank_error = (s.roll_deg > 0.0f) ? (NEUTRAL_STICK_BANK_DEG - s.roll_deg) : (-NEUTRAL_STICK_BANK_DEG - s.roll_deg);
+            effective_roll = clampf(bank_error * 0.02f, -0.1f, 0.1f);
         }
     }
 
@@ -399,7 +496,6 @@ void PrimCore::update(const PilotInput& pilot, const Sensors& s, const Faults& f
     // In Alternate/Direct Law: No protection - pilot can stall
     if (fctl_status_.law == ControlLaw::NORMAL && !gear.weight_on_wheels) {
         const float ALPHA_PROT_AOA = 11.0f;   // Start of alpha protection
-        const float ALPHA_MAX_AOA = 15.0f;     // Absolute hard limit
 
         if (alpha_prot_engaged_) {
             // Calculate target protection strength (0.0 at alpha-prot, 1.0 at alpha-max)
@@ -431,8 +527,8 @@ void PrimCore::update(const PilotInput& pilot, const Sensors& s, const Faults& f
                 effective_pitch = clampf(effective_pitch, -1.0f, 0.2f); // Allow small nose-up
             }
         } else {
-            // Reset smoothed protection strength when not engaged
-            smoothed_protection_strength_ = lerpf(smoothed_protection_strength_, 0.0f, 0.1f);
+            // Reset smoothed protection strength when not engaged (0.1 per 10 ms step)
+            smoothed_protection_strength_ = lerpf(smoothed_protection_strength_, 0.0f, 1.0f - std::exp(-10.5f * dt_sec));
         }
     } else {
         // Reset when not in normal law or on ground
@@ -456,8 +552,8 @@ void PrimCore::update(const PilotInput& pilot, const Sensors& s, const Faults& f
     float response_hz = (fctl_status_.law == ControlLaw::DIRECT) ? 12.0f : 8.0f;
     const float alpha = 1.0f - std::exp(-response_hz * dt_sec);
 
-    surfaces_.elevator_deg = lerpf(surfaces_.elevator_deg, elevator_cmd_deg_, alpha);
-    surfaces_.aileron_deg = lerpf(surfaces_.aileron_deg, aileron_cmd_deg_, alpha);
+    surfaces_.elevator_deg = settlef(surfaces_.elevator_deg, elevator_cmd_deg_, alpha);
+    surfaces_.aileron_deg = settlef(surfaces_.aileron_deg, aileron_cmd_deg_, alpha);
 
     surfaces_.elevator_deg = clampf(surfaces_.elevator_deg, -elevator_max_deg, elevator_max_deg);
     surfaces_.aileron_deg = clampf(surfaces_.aileron_deg, -aileron_max_deg, aileron_max_deg);
@@ -467,19 +563,12 @@ void PrimCore::updateFlightDynamics(Sensors& s, const PilotInput& pilot, FlapsPo
                                     const Speedbrakes& speedbrakes, LandingGear& gear, const Weather& weather, const EngineState& engines,
                                     const TrimSystem& trim) {
     // Improved flight dynamics model - more realistic and less aggressive
+    sim_time_sec_ += dt_sec;
 
-    // ========== Landing Gear Animation ==========
-    if (gear.position == GearPosition::TRANSIT) {
-        gear.transit_timer += dt_sec;
-        if (gear.transit_timer >= 10.0f) {  // 10 seconds to extend/retract
-            gear.transit_timer = 0.0f;
-            // Complete the transit to the target position
-            gear.position = gear.target_position;
-        }
-    }
+    // Gear transit completes from the sim timer wheel (see commandGear)
 
     // Update weight on wheels based on ground contact
-    gear.weight_on_wheels = (s.altitude_ft <= 0.0f) && (s.ias_knots < 80.0f);
+    gear.weight_on_wheels = (s.altitude_ft <= 0.0f) && (s.ias_knots < GROUND_SPEED_KT);
 
     // ========== Autopilot Speed Control ==========
     // When autothrust is active, it controls thrust automatically and overrides manual levers
@@ -495,23 +584,20 @@ void PrimCore::updateFlightDynamics(Sensors& s, const PilotInput& pilot, FlapsPo
     // AUTOTHRUST MODE: Automatically control thrust to reach target speed
     if (ap.autothrust && ap.spd_mode) {
         // P+I controller for better speed tracking
-        static float thrust_integrator = 0.0f;
-
         float speed_error = ap.target_spd_knots - s.ias_knots;
 
         // Proportional gain
         float thrust_p = speed_error * 0.006f;
 
         // Integral gain (accumulate error)
-        thrust_integrator += speed_error * dt_sec * 0.001f;
-        thrust_integrator = clampf(thrust_integrator, -0.3f, 0.3f);
+        thrust_integrator_ += speed_error * dt_sec * 0.001f;
+        thrust_integrator_ = clampf(thrust_integrator_, -0.3f, 0.3f);
 
         // Calculate thrust command directly (overrides manual levers)
-        effective_thrust = clampf(0.5f + thrust_p + thrust_integrator, 0.0f, 1.0f);
+        effective_thrust = clampf(0.5f + thrust_p + thrust_integrator_, 0.0f, 1.0f);
     } else {
         // Reset integrator when autothrust is off
-        static float thrust_integrator = 0.0f;
-        thrust_integrator = 0.0f;
+        thrust_integrator_ = 0.0f;
     }
 
     // ========== Engine Failures ==========
@@ -578,24 +664,31 @@ void PrimCore::updateFlightDynamics(Sensors& s, const PilotInput& pilot, FlapsPo
     float flaps_alpha = 1.0f - std::exp(-0.5f * dt_sec);  // ~2 second time constant
     s.smoothed_flaps_lift_bonus = lerpf(s.smoothed_flaps_lift_bonus, target_flaps_lift_bonus, flaps_alpha);
     s.smoothed_flaps_drag_mult = lerpf(s.smoothed_flaps_drag_mult, target_flaps_drag_mult, flaps_alpha);
+    flaps_position_ = lerpf(flaps_position_, (float)flaps, flaps_alpha);
 
     // Use smoothed values for flight dynamics
     float flaps_drag_mult = s.smoothed_flaps_drag_mult;
     float flaps_lift_bonus = s.smoothed_flaps_lift_bonus;
 
+    if (model_.dynamics == DynamicsModel::SIX_DOF) {
+        updateRigidBody(s, effective_thrust, dt_sec, speedbrakes, gear, weather, engines);
+        updateProbesAndEngines(s, pilot, engines, dt_sec);
+        return;
+    }
+
     // ========== Pitch Dynamics ==========
     // Elevator affects pitch rate
     float pitch_rate_dps = surfaces_.elevator_deg * 2.0f; // deg/sec
 
     // Turbulence affects pitch
     if (weather.turbulence_intensity > 0.0f) {
-        float pitch_turb = weather.turbulence_intensity * std::cos(SDL_GetPerformanceCounter() * 0.0012f) * 8.0f;
+        float pitch_turb = weather.turbulence_intensity * (float)std::cos(sim_time_sec_ * 7.3) * 8.0f;
         pitch_rate_dps += pitch_turb;
     }
 
     // Windshear creates sudden pitch changes
-    if (weather.windshear_intensity > 0.0f && s.altitude_ft < 1500.0f) {
-        float windshear_pitch = weather.windshear_intensity * std::sin(SDL_GetPerformanceCounter() * 0.002f) * 15.0f;
+    if (weather.windshear_intensity > 0.0f && s.altitude_ft < WINDSHEAR_MAX_ALT_FT) {
+        float windshear_pitch = weather.windshear_intensity * (float)std::sin(sim_time_sec_ * 2.1) * 15.0f;
         pitch_rate_dps += windshear_pitch;
     }
 
@@ -616,7 +709,7 @@ void PrimCore::updateFlightDynamics(Sensors& s, const PilotInput& pilot, FlapsPo
 
     // Turbulence affects roll
     if (weather.turbulence_intensity > 0.0f) {
-        float roll_turb = weather.turbulence_intensity * std::sin(SDL_GetPerformanceCounter() * 0.0015f) * 10.0f;
+        float roll_turb = weather.turbulence_intensity * (float)std::sin(sim_time_sec_ * 5.9) * 10.0f;
         roll_rate_dps += roll_turb;
     }
 
@@ -680,11 +773,29 @@ void PrimCore::updateFlightDynamics(Sensors& s, const PilotInput& pilot, FlapsPo
     // Induced drag from pitch (MUCH less aggressive)
     // Only significant at high AoA
     float induced_drag = 0.0f;
-    if (s.aoa_deg > 5.0f) {
-        float aoa_factor = (s.aoa_deg - 5.0f) / 10.0f;
+    if (s.aoa_deg > INDUCED_DRAG_AOA) {
+        float aoa_factor = (s.aoa_deg - INDUCED_DRAG_AOA) / 10.0f;
         induced_drag = aoa_factor * aoa_factor * 2.0f; // Much gentler
     }
 
+    // ========== Aero Database ==========
+    // With a database loaded the airframe drag (clean, flaps, gear, induced, wave) is q S CD
+    // against the reference mass instead of the scalars above; speedbrakes stay a scalar.
+    AeroPoint aero_point;
+    float aero_q_s = 0.0f;              // Dynamic pressure x wing area: newtons per unit coefficient
+    if (model_.aero) {
+        const AeroReference& ref = model_.aero->reference();
+        float tas_ms = casToTas(s.ias_knots, s.altitude_ft) * KT_TO_MS;
+        aero_q_s = 0.5f * isaAtmosphere(s.altitude_ft).density_kgm3 * tas_ms * tas_ms * ref.wing_area_m2;
+        aero_point.aoa_deg = s.aoa_deg;
+        aero_point.mach = s.mach;
+        aero_point.flaps = flaps_position_;
+        aero_point.gear = gearExtension(gear);
+        AeroCoefficients c = model_.aero->evaluate(aero_point, aero_cursor_);
+        total_drag = aero_q_s * c.cd / ref.mass_kg / KT_TO_MS + speedbrake_drag;
+        induced_drag = 0.0f;
+    }
+
     // Gravity component (energy trade)
     // Climbing costs energy, descending gains it
     float gravity_effect = -s.pitch_deg * 0.12f; // Reduced from 0.2
@@ -699,7 +810,7 @@ void PrimCore::updateFlightDynamics(Sensors& s, const PilotInput& pilot, FlapsPo
     float turbulence_effect = 0.0f;
     if (weather.turbulence_intensity > 0.0f) {
         // Random turbulence (simplified - would use actual random in production)
-        turbulence_effect = weather.turbulence_intensity * std::sin(SDL_GetPerformanceCounter() * 0.001f) * 2.0f;
+        turbulence_effect = weather.turbulence_intensity * (float)std::sin(sim_time_sec_ * 4.7) * 2.0f;
     }
 
     // Net acceleration
@@ -708,32 +819,83 @@ void PrimCore::updateFlightDynamics(Sensors& s, const PilotInput& pilot, FlapsPo
     s.ias_knots += speed_change_rate * dt_sec;
     s.ias_knots = clampf(s.ias_knots, 0.0f, 380.0f);
 
-    // Update Mach (simplified: IAS → Mach conversion, altitude dependent)
-    float altitude_factor = 1.0f - (s.altitude_ft / 100000.0f); // Higher alt → higher mach for same IAS
-    s.mach = (s.ias_knots / 600.0f) / clampf(altitude_factor, 0.5f, 1.0f);
-    s.mach = clampf(s.mach, 0.0f, 0.95f);
+    // Mach from calibrated airspeed and ISA static pressure (IAS taken as CAS)
+    s.mach = casToMach(s.ias_knots, s.altitude_ft);
 
     // ========== Angle of Attack ==========
     // AoA depends on pitch, speed, and flaps
     // Flaps allow higher AoA at lower speeds
     float speed_factor = clampf((250.0f - s.ias_knots) / 150.0f, -1.0f, 1.0f);
     float target_aoa = s.pitch_deg * 0.4f + speed_factor * 8.0f + flaps_lift_bonus;
+    if (model_.aero && !gear.weight_on_wheels && aero_q_s > 0.0f) {
+        // Airborne with a database: the AoA that gives the lift the load factor asks for
+        float cl_needed = s.nz * model_.aero->reference().mass_kg * G_MS2 / aero_q_s;
+        target_aoa = model_.aero->aoaForLift(cl_needed, aero_point, aero_cursor_);
+    }
 
     // Smooth AoA changes
     float aoa_alpha = 1.0f - std::exp(-3.0f * dt_sec);
-    s.aoa_deg = lerpf(s.aoa_deg, target_aoa, aoa_alpha);
+    s.aoa_deg = settlef(s.aoa_deg, target_aoa, aoa_alpha);
     s.aoa_deg = clampf(s.aoa_deg, -5.0f, 25.0f);
 
-    // ========== Temperature ==========
-    float isa_temp = 15.0f - (s.altitude_ft / 1000.0f) * 2.0f;
-    s.tat_c = lerpf(s.tat_c, isa_temp, 0.1f * dt_sec);
-
     // ========== Load Factor ==========
     float pitch_g = std::abs(pitch_rate_dps) * 0.01f;
     float roll_g = std::abs(s.roll_deg) * 0.005f;
     s.nz = 1.0f + pitch_g + roll_g;
     s.nz = clampf(s.nz, -1.0f, 3.0f);
 
+    updateProbesAndEngines(s, pilot, engines, dt_sec);
+}
+
+// ========== 6-DOF Dynamics ==========
+// Same control inputs and disturbances as the point-mass model, as rate demands on the rigid
+// body instead of attitude rates integrated directly
+void PrimCore::updateRigidBody(Sensors& s, float effective_thrust, float dt_sec,
+                               const Speedbrakes& speedbrakes, const LandingGear& gear, const Weather& weather,
+                               const EngineState& engines) {
+    float pitch_rate_dps = surfaces_.elevator_deg * 2.0f;
+    float roll_rate_dps = surfaces_.aileron_deg * 3.0f;
+    if (weather.turbulence_intensity > 0.0f) {
+        pitch_rate_dps += weather.turbulence_intensity * (float)std::cos(sim_time_sec_ * 7.3) * 8.0f;
+        roll_rate_dps += weather.turbulence_intensity * (float)std::sin(sim_time_sec_ * 5.9) * 10.0f;
+    }
+    if (weather.windshear_intensity > 0.0f && s.altitude_ft < WINDSHEAR_MAX_ALT_FT) {
+        pitch_rate_dps += weather.windshear_intensity * (float)std::sin(sim_time_sec_ * 2.1) * 15.0f;
+    }
+
+    // The point-mass attitude limits, as demands that fade out approaching them
+    pitch_rate_dps = clampf(pitch_rate_dps, (-30.0f - s.pitch_deg) * 2.0f, (30.0f - s.pitch_deg) * 2.0f);
+    roll_rate_dps = clampf(roll_rate_dps, (-90.0f - s.roll_deg) * 2.0f, (90.0f - s.roll_deg) * 2.0f);
+    // The ground plane has no nose gear: on the runway the nose can come up but not go down
+    if (s.altitude_ft <= 0.0f) pitch_rate_dps = std::max(pitch_rate_dps, -s.pitch_deg * 2.0f);
+
+    RigidBodyInputs in;
+    in.pitch_rate_dps = pitch_rate_dps;
+    in.roll_rate_dps = roll_rate_dps;
+    // effective_thrust already carries the engine-out halving; it all comes from the live engine
+    in.thrust_left = engines.engine1_running ? effective_thrust * (engines.engine2_running ? 0.5f : 1.0f) : 0.0f;
+    in.thrust_right = engines.engine2_running ? effective_thrust * (engines.engine1_running ? 0.5f : 1.0f) : 0.0f;
+    in.flaps = flaps_position_;
+    in.gear = gearExtension(gear);
+    in.speedbrake = speedbrakes.position;
+
+    // Steady wind moves the air mass (wind_direction_deg is where it blows from)
+    float wind_ms = weather.wind_speed_knots * KT_TO_MS;
+    float wind_from = weather.wind_direction_deg * 3.14159f / 180.0f;
+    in.wind_north_ms = -wind_ms * std::cos(wind_from);
+    in.wind_east_ms = -wind_ms * std::sin(wind_from);
+
+    body_.follow(s);
+    body_.step(in, dt_sec, model_.substep_sec);
+    body_.output(s);
+}
+
+void PrimCore::updateProbesAndEngines(Sensors& s, const PilotInput& pilot, const EngineState& engines, float dt_sec) {
+    // ========== Temperature ==========
+    // ISA static temperature plus ram rise, through a slow probe lag
+    float tat = totalAirTemperatureC(isaTemperatureC(s.altitude_ft), s.mach);
+    s.tat_c = lerpf(s.tat_c, tat, 0.1f * dt_sec);
+
     // ========== Engine Simulation ==========
     // Update engine parameters based on thrust setting and engine status
     float target_n1 = 0.0f;
@@ -766,11 +928,11 @@ FlightPhase PrimCore::detectFlightPhase(const Sensors& s, const LandingGear& gea
     // Detect current flight phase based on conditions
     bool on_ground = gear.weight_on_wheels;
     bool engines_running = engines.engine1_running || engines.engine2_running;
-    bool low_speed = s.ias_knots < 80.0f;
-    bool climbing = s.vs_fpm > 500.0f;
-    bool descending = s.vs_fpm < -500.0f;
-    bool low_altitude = s.altitude_ft < 3000.0f;
-    bool high_altitude = s.altitude_ft > 10000.0f;
+    bool low_speed = s.ias_knots < GROUND_SPEED_KT;
+    bool climbing = s.vs_fpm > PHASE_CLIMB_VS_FPM;
+    bool descending = s.vs_fpm < -PHASE_CLIMB_VS_FPM;
+    bool low_altitude = s.altitude_ft < PHASE_LOW_ALT_FT;
+    bool high_altitude = s.altitude_ft > PHASE_HIGH_ALT_FT;
 
     if (on_ground && !engines_running) {
         return FlightPhase::PREFLIGHT;
@@ -793,111 +955,57 @@ FlightPhase PrimCore::detectFlightPhase(const Sensors& s, const LandingGear& gea
     return FlightPhase::CRUISE;  // Default
 }
 
-void PrimCore::updateGPWS(const Sensors& s, const LandingGear& gear, const Weather& weather, float dt_sec) {
-    // Update callout timer
-    if (gpws_callouts_.callout_timer > 0.0f) {
-        gpws_callouts_.callout_timer -= dt_sec;
-    }
+static void clearCallout(void* ctx) {
+    GPWSCallouts& gpws = *static_cast<GPWSCallouts*>(ctx);
+    gpws.current_callout.clear();
+    gpws.callout_timer = TimerHandle{};
+}
 
-    // Clear callout if timer expired
-    if (gpws_callouts_.callout_timer <= 0.0f) {
-        gpws_callouts_.current_callout = "";
-    }
+// Show a callout for duration_sec; a newer callout replaces it and its expiry
+void PrimCore::showCallout(const char* callout, float duration_sec, TimerWheel& timers) {
+    gpws_callouts_.current_callout = callout;
+    timers.reschedule(gpws_callouts_.callout_timer, timers.now() + duration_sec, clearCallout, &gpws_callouts_);
+}
 
+void PrimCore::updateGPWS(const Sensors& s, const LandingGear& gear, const Weather& weather, TimerWheel& timers) {
     // PULL UP warning (terrain warning - already handled in alerts)
-    gpws_callouts_.pull_up_active = (s.altitude_ft < 2500.0f) && (s.vs_fpm < -1500.0f) && !gear.weight_on_wheels;
+    gpws_callouts_.pull_up_active = (s.altitude_ft < PULL_UP_MAX_ALT_FT) && (s.vs_fpm < PULL_UP_VS_FPM) && !gear.weight_on_wheels;
 
     // WINDSHEAR warning (based on windshear intensity and low altitude)
-    gpws_callouts_.windshear_active = (weather.windshear_intensity > 0.3f) && (s.altitude_ft < 1500.0f);
+    gpws_callouts_.windshear_active = (weather.windshear_intensity > 0.3f) && (s.altitude_ft < WINDSHEAR_MAX_ALT_FT);
 
     // Set priority callouts
     if (gpws_callouts_.pull_up_active) {
-        gpws_callouts_.current_callout = "PULL UP";
-        gpws_callouts_.callout_timer = 1.0f;  // Flash for 1 second
+        showCallout("PULL UP", 1.0f, timers);  // Flash for 1 second
     } else if (gpws_callouts_.windshear_active) {
-        gpws_callouts_.current_callout = "WINDSHEAR";
-        gpws_callouts_.callout_timer = 2.0f;
+        showCallout("WINDSHEAR", 2.0f, timers);
     }
 
     // Altitude callouts (only during approach - descending below 2500ft)
-    bool approaching = (s.vs_fpm < -300.0f) && !gear.weight_on_wheels;
+    bool approaching = (s.vs_fpm < CALLOUT_ARM_VS_FPM) && !gear.weight_on_wheels;
 
     // Reset callouts when climbing above 3000ft
-    if (s.altitude_ft > 3000.0f && s.vs_fpm > 0.0f) {
-        gpws_callouts_.called_2500 = false;
-        gpws_callouts_.called_1000 = false;
-        gpws_callouts_.called_500 = false;
-        gpws_callouts_.called_400 = false;
-        gpws_callouts_.called_300 = false;
-        gpws_callouts_.called_200 = false;
-        gpws_callouts_.called_100 = false;
-        gpws_callouts_.called_50 = false;
-        gpws_callouts_.called_40 = false;
-        gpws_callouts_.called_30 = false;
-        gpws_callouts_.called_20 = false;
-        gpws_callouts_.called_10 = false;
+    if (s.altitude_ft > CALLOUT_RESET_ALT_FT && s.vs_fpm > 0.0f) {
+        for (const AltitudeCallout& c : ALTITUDE_CALLOUTS) gpws_callouts_.*c.called = false;
         gpws_callouts_.retard_active = false;
     }
 
     if (approaching && !gpws_callouts_.pull_up_active && !gpws_callouts_.windshear_active) {
-        // Altitude callouts
-        if (s.altitude_ft <= 2500.0f && s.altitude_ft > 2400.0f && !gpws_callouts_.called_2500) {
-            gpws_callouts_.current_callout = "2500";
-            gpws_callouts_.callout_timer = 1.5f;
-            gpws_callouts_.called_2500 = true;
-        } else if (s.altitude_ft <= 1000.0f && s.altitude_ft > 950.0f && !gpws_callouts_.called_1000) {
-            gpws_callouts_.current_callout = "1000";
-            gpws_callouts_.callout_timer = 1.5f;
-            gpws_callouts_.called_1000 = true;
-        } else if (s.altitude_ft <= 500.0f && s.altitude_ft > 480.0f && !gpws_callouts_.called_500) {
-            gpws_callouts_.current_callout = "500";
-            gpws_callouts_.callout_timer = 1.0f;
-            gpws_callouts_.called_500 = true;
-        } else if (s.altitude_ft <= 400.0f && s.altitude_ft > 380.0f && !gpws_callouts_.called_400) {
-            gpws_callouts_.current_callout = "400";
-            gpws_callouts_.callout_timer = 1.0f;
-            gpws_callouts_.called_400 = true;
-        } else if (s.altitude_ft <= 300.0f && s.altitude_ft > 280.0f && !gpws_callouts_.called_300) {
-            gpws_callouts_.current_callout = "300";
-            gpws_callouts_.callout_timer = 1.0f;
-            gpws_callouts_.called_300 = true;
-        } else if (s.altitude_ft <= 200.0f && s.altitude_ft > 180.0f && !gpws_callouts_.called_200) {
-            gpws_callouts_.current_callout = "200";
-            gpws_callouts_.callout_timer = 1.0f;
-            gpws_callouts_.called_200 = true;
-        } else if (s.altitude_ft <= 100.0f && s.altitude_ft > 90.0f && !gpws_callouts_.called_100) {
-            gpws_callouts_.current_callout = "100";
-            gpws_callouts_.callout_timer = 1.0f;
-            gpws_callouts_.called_100 = true;
-        } else if (s.altitude_ft <= 50.0f && s.altitude_ft > 45.0f && !gpws_callouts_.called_50) {
-            gpws_callouts_.current_callout = "50";
-            gpws_callouts_.callout_timer = 0.8f;
-            gpws_callouts_.called_50 = true;
-        } else if (s.altitude_ft <= 40.0f && s.altitude_ft > 35.0f && !gpws_callouts_.called_40) {
-            gpws_callouts_.current_callout = "40";
-            gpws_callouts_.callout_timer = 0.8f;
-            gpws_callouts_.called_40 = true;
-        } else if (s.altitude_ft <= 30.0f && s.altitude_ft > 25.0f && !gpws_callouts_.called_30) {
-            gpws_callouts_.current_callout = "30";
-            gpws_callouts_.callout_timer = 0.8f;
-            gpws_callouts_.called_30 = true;
-        } else if (s.altitude_ft <= 20.0f && s.altitude_ft > 15.0f && !gpws_callouts_.called_20) {
-            gpws_callouts_.current_callout = "20";
-            gpws_callouts_.callout_timer = 0.8f;
-            gpws_callouts_.called_20 = true;
-            gpws_callouts_.retard_active = true;  // RETARD starts at 20ft
-        } else if (s.altitude_ft <= 10.0f && s.altitude_ft > 5.0f && !gpws_callouts_.called_10) {
-            gpws_callouts_.current_callout = "10";
-            gpws_callouts_.callout_timer = 0.8f;
-            gpws_callouts_.called_10 = true;
+        // Altitude callouts; the windows do not overlap, so at most one fires per step
+        for (const AltitudeCallout& c : ALTITUDE_CALLOUTS) {
+            if (s.altitude_ft <= c.top_ft && s.altitude_ft > c.bottom_ft && !(gpws_callouts_.*c.called)) {
+                showCallout(c.text, c.duration_sec, timers);
+                gpws_callouts_.*c.called = true;
+                if (c.top_ft == RETARD_TOP_FT) gpws_callouts_.retard_active = true;  // RETARD starts at 20ft
+                break;
+            }
         }
     }
 
     // RETARD callout (thrust reduction on landing below 20ft)
-    if (gpws_callouts_.retard_active && s.altitude_ft < 20.0f && s.altitude_ft > 5.0f && !gear.weight_on_wheels) {
+    if (gpws_callouts_.retard_active && s.altitude_ft < RETARD_TOP_FT && s.altitude_ft > RETARD_BOTTOM_FT && !gear.weight_on_wheels) {
         if (gpws_callouts_.current_callout != "RETARD") {
-            gpws_callouts_.current_callout = "RETARD";
-            gpws_callouts_.callout_timer = 3.0f;  // Keep showing until touchdown
+            showCallout("RETARD", 3.0f, timers);  // Keep showing until touchdown
         }
     }
 }
@@ -931,10 +1039,11 @@ void PrimCore::computeVSpeeds(const Sensors& s, FlapsPosition flaps, const Landi
         vspeeds_.vmax = 220.0f;  // Gear down speed limit
     } else if (flaps != FlapsPosition::RETRACTED) {
         vspeeds_.vmax = 250.0f;  // Flaps extended limit
-    } else if (s.altitude_ft < 10000.0f) {
+    } else if (s.altitude_ft < VMAX_FL100_ALT_FT) {
         vspeeds_.vmax = 250.0f;  // Below FL100
     } else {
-        vspeeds_.vmax = 320.0f;  // High altitude clean config
+        // Clean: VMO, or MMO as a CAS once that is lower (above about FL250)
+        vspeeds_.vmax = std::min(VMO_KT, machToCas(MMO, s.altitude_ft));
     }
 
     // Green dot (best L/D speed) - typically VLS + 30 for Airbus
@@ -954,7 +1063,7 @@ void PrimCore::computeBUSS(const Sensors& s, FlapsPosition flaps, const LandingG
     // Determine pitch and thrust targets based on configuration and altitude
     if (flaps == FlapsPosition::RETRACTED && gear.position == GearPosition::UP) {
         // Clean configuration
-        if (s.altitude_ft > 15000.0f) {
+        if (s.altitude_ft > BUSS_CRUISE_ALT_FT) {
             // Cruise
             buss_data_.target_pitch_min = 2.0f;
             buss_data_.target_pitch_max = 5.0f;
@@ -5,6 +5,37 @@
 #pragma once
 #include "sim_types.h"
 #include "alerts.h"
+#include "fctl_reconfig.h"
+#include "aero_table.h"
+#include "rigid_body.h"
+
+enum class DynamicsModel : uint8_t {
+    POINT_MASS,     // Attitude rates integrated directly, speed from a drag budget (default)
+    SIX_DOF         // RigidBody: forces and moments, quaternion attitude, RK4
+};
+
+// Which aircraft model updateFlightDynamics() runs
+struct FlightModel {
+    const AeroDatabase* aero = nullptr;     // nullptr: built-in coefficients. Shared read-only,
+                                            // must outlive the core
+    DynamicsModel dynamics = DynamicsModel::POINT_MASS;
+    float substep_sec = 0.005f;             // SIX_DOF: longest RK4 step
+};
+
+// "point" or "6dof"
+bool parseDynamicsModel(const char* name, DynamicsModel& out);
+
+// A sensor value some discrete logic switches on. Adaptive fast-time stepping
+// (adaptive_step.h) ends steps on these instead of stepping across them.
+struct SensorThreshold {
+    float Sensors::* field = nullptr;
+    float value = 0.0f;
+};
+
+// Every threshold of update(), updateFlightDynamics(), updateGPWS() and detectFlightPhase():
+// alert and protection limits, GPWS callout heights, flight phase boundaries. Built from the
+// same named constants the logic compares against, so retuning a limit moves both.
+const std::vector<SensorThreshold>& primSensorThresholds();
 
 class PrimCore {
 public:
@@ -23,9 +54,18 @@ public:
     void updateFlightDynamics(Sensors& s, const PilotInput& pilot, FlapsPosition flaps, float dt_sec, const AutopilotState& ap,
                               const Speedbrakes& speedbrakes, LandingGear& gear, const Weather& weather, const EngineState& engines,
                               const TrimSystem& trim);
-    void updateGPWS(const Sensors& s, const LandingGear& gear, const Weather& weather, float dt_sec);
+    void updateGPWS(const Sensors& s, const LandingGear& gear, const Weather& weather, TimerWheel& timers);
     FlightPhase detectFlightPhase(const Sensors& s, const LandingGear& gear, const EngineState& engines) const;
 
+    // With an aero database the point-mass drag and the AoA for the lift needed come from it
+    // instead of the built-in scalars; SIX_DOF replaces the point-mass model altogether
+    void setFlightModel(const FlightModel& model);
+    const FlightModel& flightModel() const { return model_; }
+    const RigidBody& rigidBody() const { return body_; }
+
+    // Put the flaps at 'flaps' with no travel left, for states set up already settled (applyTrim)
+    void settleFlaps(FlapsPosition flaps) { flaps_position_ = (float)flaps; }
+
 private:
     Surfaces surfaces_{};
     FlightControlStatus fctl_status_{};
@@ -34,8 +74,15 @@ private:
     VSpeeds vspeeds_{};
     BUSSData buss_data_{};
 
+    void showCallout(const char* callout, float duration_sec, TimerWheel& timers);
     void computeVSpeeds(const Sensors& s, FlapsPosition flaps, const LandingGear& gear);
     void computeBUSS(const Sensors& s, FlapsPosition flaps, const LandingGear& gear, const Faults& f, float thrust);
+    void updateRigidBody(Sensors& s, float effective_thrust, float dt_sec, const Speedbrakes& speedbrakes,
+                         const LandingGear& gear, const Weather& weather, const EngineState& engines);
+    void updateProbesAndEngines(Sensors& s, const PilotInput& pilot, const EngineState& engines, float dt_sec);
+
+    // Fault-driven law/authority, recomputed only when the relevant faults change
+    ReconfigCache reconfig_cache_;
 
     float elevator_cmd_deg_ = 0.0f;
     float aileron_cmd_deg_  = 0.0f;
@@ -43,4 +90,19 @@ private:
     // Alpha protection hysteresis state
     bool alpha_prot_engaged_ = false;
     float smoothed_protection_strength_ = 0.0f;
+    bool alpha_floor_engaged_ = false;
+
+    // Autothrust P+I controller state
+    float thrust_integrator_ = 0.0f;
+
+    // Flap position as a FlapsPosition index, fractional while the flaps run. Moves with the
+    // same lag as the smoothed flap effects in Sensors; the aero database is looked up on it.
+    float flaps_position_ = 0.0f;
+
+    // Simulated time, drives turbulence/windshear so runs are reproducible
+    double sim_time_sec_ = 0.0;
+
+    FlightModel model_;
+    AeroCursor aero_cursor_;            // Last table cells of this aircraft
+    RigidBody body_;                    // SIX_DOF state
 };
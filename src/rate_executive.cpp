@@ -0,0 +1,176 @@
+//
+//
+// Santiago Quintana Moreno A01571222
+// Created on: 18/10/2026.
+#include "rate_executive.h"
+#include "sim_state.h"
+#include "latency_histogram.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+
+using ExecClock = std::chrono::steady_clock;
+
+static double secondsBetween(ExecClock::time_point a, ExecClock::time_point b) {
+    return std::chrono::duration<double>(b - a).count();
+}
+
+void RateGroupStats::record(double exec_sec) {
+    last_us = exec_sec * 1e6;
+    total_us += last_us;
+    if (last_us > max_us) max_us = last_us;
+    ++runs;
+    if (exec_sec * rate_hz > 1.0) ++overruns;
+    if (histogram) histogram->record((uint64_t)(exec_sec * 1e9));
+}
+
+bool parseRateConfig(const char* spec, RateConfig& config, std::string& error) {
+    float* fields[] = { &config.dynamics_hz, &config.prim_hz, &config.monitor_hz };
+    const char* p = spec;
+    for (float* field : fields) {
+        char* end = nullptr;
+        double v = std::strtod(p, &end);
+        if (end == p || v <= 0.0) {
+            error = std::string("rates: bad spec '") + spec + "', expected DYN,PRIM,MON in Hz";
+            return false;
+        }
+        *field = (float)v;
+        if (*end == '\0') return true;
+        if (*end != ',') {
+            error = std::string("rates: bad spec '") + spec + "', expected DYN,PRIM,MON in Hz";
+            return false;
+        }
+        p = end + 1;
+    }
+    error = std::string("rates: too many fields in '") + spec + "'";
+    return false;
+}
+
+// Base frames per run of a group at 'hz', or 0 if it does not divide the dynamics rate
+static uint32_t harmonicDivider(float dynamics_hz, float hz) {
+    if (hz <= 0.0f || hz > dynamics_hz) return 0;
+    double ratio = (double)dynamics_hz / (double)hz;
+    double rounded = std::round(ratio);
+    return std::fabs(ratio - rounded) < 1e-3 ? (uint32_t)rounded : 0;
+}
+
+RateExecutive::RateExecutive() {
+    std::string error;
+    configure(RateConfig{}, error);
+}
+
+bool RateExecutive::configure(const RateConfig& config, std::string& error) {
+    if (config.dynamics_hz < 10.0f || config.dynamics_hz > 10000.0f) {
+        error = "rates: dynamics rate must be between 10 and 10000 Hz";
+        return false;
+    }
+    uint32_t prim_div = harmonicDivider(config.dynamics_hz, config.prim_hz);
+    uint32_t monitor_div = harmonicDivider(config.dynamics_hz, config.monitor_hz);
+    if (prim_div == 0 || monitor_div == 0) {
+        error = "rates: PRIM and monitor rates must divide the dynamics rate";
+        return false;
+    }
+
+    config_ = config;
+    frame_dt_ = 1.0 / config.dynamics_hz;
+    prim_divider_ = prim_div;
+    monitor_divider_ = monitor_div;
+    max_catchup_frames_ = config.max_catchup_sec > 0.0f
+                        ? std::max(1, (int)std::ceil(config.max_catchup_sec * config.dynamics_hz - 1e-6)) : 0;
+
+    // Report the rates actually run
+    groups_[(int)RateGroupId::DYNAMICS].name = "DYNAMICS";
+    groups_[(int)RateGroupId::DYNAMICS].rate_hz = config.dynamics_hz;
+    groups_[(int)RateGroupId::PRIM].name = "PRIM";
+    groups_[(int)RateGroupId::PRIM].rate_hz = config.dynamics_hz / (float)prim_div;
+    groups_[(int)RateGroupId::MONITOR].name = "MONITOR";
+    groups_[(int)RateGroupId::MONITOR].rate_hz = config.dynamics_hz / (float)monitor_div;
+    frame_stats_.name = "FRAME";
+    frame_stats_.rate_hz = config.dynamics_hz;
+
+    reset();
+    resetStats();
+    return true;
+}
+
+void RateExecutive::reset() {
+    frame_ = 0;
+    carry_sec_ = 0.0;
+}
+
+void RateExecutive::resetStats() {
+    for (RateGroupStats& g : groups_) {
+        RateGroupStats fresh;
+        fresh.name = g.name;
+        fresh.rate_hz = g.rate_hz;
+        fresh.histogram = g.histogram;
+        g = fresh;
+    }
+    RateGroupStats fresh;
+    fresh.name = frame_stats_.name;
+    fresh.rate_hz = frame_stats_.rate_hz;
+    fresh.histogram = frame_stats_.histogram;
+    frame_stats_ = fresh;
+    dropped_frames_ = 0;
+}
+
+int RateExecutive::advance(SimState& sim, double elapsed_sec) {
+    carry_sec_ += elapsed_sec;
+    int frames = (int)std::floor(carry_sec_ / frame_dt_ + 1e-6);
+    if (frames <= 0) return 0;
+    carry_sec_ = std::max(0.0, carry_sec_ - frames * frame_dt_);
+
+    if (max_catchup_frames_ > 0 && frames > max_catchup_frames_) {
+        dropped_frames_ += (uint64_t)(frames - max_catchup_frames_);
+        frames = max_catchup_frames_;
+        carry_sec_ = 0.0;
+    }
+
+    for (int i = 0; i < frames; ++i) runFrame(sim);
+    return frames;
+}
+
+void RateExecutive::runFrame(SimState& sim) {
+    const float dt = (float)frame_dt_;
+    const bool run_monitor = frame_ % monitor_divider_ == 0;
+    const bool run_prim = frame_ % prim_divider_ == 0;
+
+    ExecClock::time_point t0 = ExecClock::now();
+    double monitor_sec = 0.0;
+
+    if (run_monitor) {
+        sim.flight_phase = sim.prim.detectFlightPhase(sim.sensors, sim.gear, sim.engines);
+    }
+    ExecClock::time_point t1 = ExecClock::now();
+    monitor_sec += secondsBetween(t0, t1);
+
+    if (run_prim) {
+        sim.prim.update(sim.pilot, sim.sensors, sim.faults, dt * (float)prim_divider_, sim.alerts, sim.autopilot,
+                        sim.trim, sim.gear, sim.hydraulics, sim.engines, sim.apu);
+    }
+    ExecClock::time_point t2 = ExecClock::now();
+
+    // Manual override (QF72-style scenarios) freezes the aircraft model, as in stepSimulation()
+    if (!sim.settings.manual_sensor_override) {
+        sim.prim.updateFlightDynamics(sim.sensors, sim.pilot, sim.flaps, dt, sim.autopilot, sim.speedbrakes,
+                                      sim.gear, sim.weather, sim.engines, sim.trim);
+    }
+    ExecClock::time_point t3 = ExecClock::now();
+
+    if (run_monitor) {
+        sim.prim.updateGPWS(sim.sensors, sim.gear, sim.weather, sim.timers);
+    }
+    ExecClock::time_point t4 = ExecClock::now();
+    monitor_sec += secondsBetween(t3, t4);
+
+    sim.time_sec += frame_dt_;
+    sim.timers.advance(sim.time_sec);
+    ExecClock::time_point t5 = ExecClock::now();
+
+    groups_[(int)RateGroupId::DYNAMICS].record(secondsBetween(t2, t3));
+    if (run_prim) groups_[(int)RateGroupId::PRIM].record(secondsBetween(t1, t2));
+    if (run_monitor) groups_[(int)RateGroupId::MONITOR].record(monitor_sec);
+    frame_stats_.record(secondsBetween(t0, t5));
+    ++frame_;
+}
@@ -0,0 +1,98 @@
+//
+//
+// Santiago Quintana Moreno A01571222
+// Created on: 18/10/2026.
+#pragma once
+#include <cstdint>
+#include <string>
+
+struct SimState;
+class LatencyHistogram;
+
+// ========== Multi-Rate Executive ==========
+// Runs the aircraft as harmonic rate groups instead of once per render frame, the way the
+// real PRIM computers run their control laws on a fixed frame separate from the aircraft:
+//
+//   DYNAMICS  updateFlightDynamics, every base frame (e.g. 400 Hz); also advances sim time
+//   PRIM      PrimCore::update, every Nth base frame (e.g. 100 Hz), surfaces held in between
+//   MONITOR   flight phase detection + GPWS, every Mth base frame (e.g. 20 Hz)
+//
+// PRIM and MONITOR rates must divide the dynamics rate. Within a base frame the order is the
+// same as stepSimulation(): phase, PRIM, dynamics, GPWS, timers.
+//
+// Every group run is timed against the group's period; a run that takes longer is an overrun.
+// The base frame as a whole (all groups that ran in it) is checked against the base period.
+
+enum class RateGroupId : uint8_t {
+    DYNAMICS,
+    PRIM,
+    MONITOR,
+    COUNT
+};
+
+struct RateConfig {
+    float dynamics_hz = 400.0f;
+    float prim_hz = 100.0f;
+    float monitor_hz = 20.0f;            // GPWS and flight phase
+    float max_catchup_sec = 0.0f;        // advance() runs at most this much sim time per call (0 = no cap)
+};
+
+// "DYN,PRIM,MON" in Hz, e.g. "400,100,20"; trailing fields may be omitted
+bool parseRateConfig(const char* spec, RateConfig& config, std::string& error);
+
+struct RateGroupStats {
+    const char* name = "";
+    float rate_hz = 0.0f;
+    uint64_t runs = 0;
+    uint64_t overruns = 0;               // Runs that took longer than one period
+    double last_us = 0.0;
+    double max_us = 0.0;
+    double total_us = 0.0;
+    LatencyHistogram* histogram = nullptr;   // Optional: every run recorded in ns (latency harness)
+
+    void record(double exec_sec);
+    double meanMicros() const { return runs ? total_us / (double)runs : 0.0; }
+    double loadPercent() const { return meanMicros() * rate_hz * 1e-4; }   // Mean share of the period
+};
+
+class RateExecutive {
+public:
+    RateExecutive();
+
+    bool configure(const RateConfig& config, std::string& error);
+    const RateConfig& config() const { return config_; }
+    double framePeriod() const { return frame_dt_; }
+
+    // Runs as many base frames as 'elapsed_sec' covers and carries the remainder to the next
+    // call. Time beyond the catch-up cap is dropped and counted. Returns the frames run.
+    int advance(SimState& sim, double elapsed_sec);
+
+    // One base frame
+    void runFrame(SimState& sim);
+
+    // Restart the frame count and drop carried time (after initSimulation / a scenario restart)
+    void reset();
+    void resetStats();
+
+    // Record every run of a group (or of the whole base frame) into 'histogram'; nullptr detaches
+    void setHistogram(RateGroupId id, LatencyHistogram* histogram) { groups_[(int)id].histogram = histogram; }
+    void setFrameHistogram(LatencyHistogram* histogram) { frame_stats_.histogram = histogram; }
+
+    const RateGroupStats& stats(RateGroupId id) const { return groups_[(int)id]; }
+    const RateGroupStats& frameStats() const { return frame_stats_; }
+    uint64_t droppedFrames() const { return dropped_frames_; }
+
+private:
+    RateConfig config_;
+    double frame_dt_ = 0.0;
+    uint32_t prim_divider_ = 1;
+    uint32_t monitor_divider_ = 1;
+    int max_catchup_frames_ = 0;
+
+    uint64_t frame_ = 0;
+    double carry_sec_ = 0.0;
+
+    RateGroupStats groups_[(int)RateGroupId::COUNT];
+    RateGroupStats frame_stats_;
+    uint64_t dropped_frames_ = 0;
+};
@@ -0,0 +1,188 @@
+//
+//
+// Santiago Quintana Moreno A01571222
+// Created on: 18/10/2026.
+#include "realtime.h"
+#include "latency_histogram.h"
+#include <chrono>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define PRIM_HAVE_POSIX_RT 1
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+static void appendError(std::string& error, const std::string& what) {
+    if (!error.empty()) error += "; ";
+    error += what;
+}
+
+#ifdef PRIM_HAVE_POSIX_RT
+static std::string errnoText(const char* what, int err) {
+    return std::string(what) + ": " + std::strerror(err);
+}
+#endif
+
+// Touch a fixed slice of stack below the caller so later frames do not fault it in
+static constexpr size_t PREFAULT_STACK_BYTES = 256 * 1024;
+
+#if defined(__GNUC__)
+__attribute__((noinline))
+#endif
+static void prefaultStack() {
+    unsigned char buffer[PREFAULT_STACK_BYTES];
+    volatile unsigned char* touch = buffer;     // Volatile so the stores are not optimised away
+    for (size_t i = 0; i < PREFAULT_STACK_BYTES; i += 4096) touch[i] = 0;
+}
+
+static void prefaultHeap(size_t bytes) {
+#if defined(__GLIBC__)
+    // Keep freed memory in the heap instead of returning it to the OS, and never serve
+    // allocations from fresh mmaps, so the pages touched here are the ones reused later
+    mallopt(M_TRIM_THRESHOLD, -1);
+    mallopt(M_MMAP_MAX, 0);
+#endif
+    if (bytes == 0) return;
+    unsigned char* block = static_cast<unsigned char*>(std::malloc(bytes));
+    if (!block) return;
+    for (size_t i = 0; i < bytes; i += 4096) block[i] = 1;
+    std::free(block);
+}
+
+bool enterRealtime(const RealtimeConfig& config, RealtimeStatus& status, std::string& error) {
+    status = RealtimeStatus{};
+    error.clear();
+
+#ifdef PRIM_HAVE_POSIX_RT
+    if (config.cpu >= 0) {
+#if defined(__linux__)
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(config.cpu, &set);
+        int err = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+        if (err == 0) {
+            status.pinned = true;
+            status.cpu = config.cpu;
+        } else {
+            appendError(error, errnoText("pin to cpu", err));
+        }
+#else
+        appendError(error, "pin to cpu: not supported on this platform");
+#endif
+    }
+
+    if (config.priority > 0) {
+        sched_param param{};
+        param.sched_priority = config.priority;
+        int err = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+        if (err == 0) {
+            status.fifo = true;
+            status.priority = config.priority;
+        } else {
+            appendError(error, errnoText("SCHED_FIFO", err));
+        }
+    }
+
+    if (config.lock_memory) {
+        if (mlockall(MCL_CURRENT | MCL_FUTURE) == 0) status.memory_locked = true;
+        else appendError(error, errnoText("mlockall", errno));
+    }
+#else
+    if (config.cpu >= 0) appendError(error, "pin to cpu: not supported on this platform");
+    if (config.priority > 0) appendError(error, "SCHED_FIFO: not supported on this platform");
+    if (config.lock_memory) appendError(error, "mlockall: not supported on this platform");
+#endif
+
+    // Worth doing even unlocked: the first touches happen now rather than mid-frame
+    prefaultStack();
+    prefaultHeap(config.prefault_heap_mb * 1024 * 1024);
+    status.prefaulted = true;
+
+    return error.empty();
+}
+
+std::string describeRealtime(const RealtimeStatus& status) {
+    std::string text = "RT";
+    if (status.pinned) text += " cpu " + std::to_string(status.cpu) + ",";
+    if (status.fifo) text += " FIFO " + std::to_string(status.priority) + ",";
+    if (status.memory_locked) text += " mlock,";
+    if (status.prefaulted) text += " prefault,";
+    if (text.back() == ',') text.pop_back();
+    else text += " off";
+    return text;
+}
+
+static uint64_t clockNanos() {
+#ifdef PRIM_HAVE_POSIX_RT
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+#else
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+static void sleepUntilNanos(uint64_t deadline_ns) {
+#ifdef PRIM_HAVE_POSIX_RT
+#if defined(__linux__)
+    timespec ts;
+    ts.tv_sec = (time_t)(deadline_ns / 1000000000ull);
+    ts.tv_nsec = (long)(deadline_ns % 1000000000ull);
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR) {}
+#else
+    // No clock_nanosleep on macOS: relative sleep to the absolute deadline
+    uint64_t now = clockNanos();
+    if (deadline_ns > now) std::this_thread::sleep_for(std::chrono::nanoseconds(deadline_ns - now));
+#endif
+#else
+    uint64_t now = clockNanos();
+    if (deadline_ns > now) std::this_thread::sleep_for(std::chrono::nanoseconds(deadline_ns - now));
+#endif
+}
+
+void DeadlineClock::start(uint64_t period_ns) {
+    period_ns_ = period_ns;
+    next_ns_ = clockNanos() + period_ns;
+    stats_ = DeadlineStats{};
+}
+
+bool DeadlineClock::wait(uint64_t* late_ns) {
+    ++stats_.frames;
+    uint64_t now = clockNanos();
+
+    if (now > next_ns_) {
+        uint64_t late = now - next_ns_;
+        ++stats_.misses;
+        if (late > stats_.max_late_ns) stats_.max_late_ns = late;
+        if (late_ns) *late_ns = late;
+
+        if (late >= period_ns_) {
+            // More than a period behind: drop the lost periods and start over from now
+            stats_.skipped_periods += late / period_ns_;
+            next_ns_ = now + period_ns_;
+        } else {
+            next_ns_ += period_ns_;     // Next frame starts immediately, still on the grid
+        }
+        return false;
+    }
+
+    sleepUntilNanos(next_ns_);
+    uint64_t woke = clockNanos();
+    uint64_t wake = woke > next_ns_ ? woke - next_ns_ : 0;
+    if (wake > stats_.max_wake_ns) stats_.max_wake_ns = wake;
+    if (wake_histogram_) wake_histogram_->record(wake);
+    next_ns_ += period_ns_;
+    if (late_ns) *late_ns = 0;
+    return true;
+}
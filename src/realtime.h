@@ -0,0 +1,77 @@
+//
+//
+// Santiago Quintana Moreno A01571222
+// Created on: 18/10/2026.
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+class LatencyHistogram;
+
+// ========== Real-Time Execution ==========
+// Opt-in setup for running the sim thread on a shared lab box without frame jitter:
+// pin the calling thread to one core, switch it to SCHED_FIFO, lock all memory and touch
+// the stack and heap up front so no page fault lands inside a frame. Linux gets all of it;
+// macOS tries all but the pinning, which it reports as unavailable; other platforms only
+// prefault and report the rest as unavailable. Priority and locking usually need
+// CAP_SYS_NICE / CAP_IPC_LOCK or a suitable rtprio / memlock limit.
+
+struct RealtimeConfig {
+    int cpu = -1;                        // Core to pin to (-1 = leave affinity alone)
+    int priority = 80;                   // SCHED_FIFO priority 1-99 (0 = keep the normal scheduler)
+    bool lock_memory = true;             // mlockall(MCL_CURRENT | MCL_FUTURE)
+    size_t prefault_heap_mb = 64;        // Heap touched and kept by the allocator
+};
+
+struct RealtimeStatus {
+    bool pinned = false;
+    bool fifo = false;
+    bool memory_locked = false;
+    bool prefaulted = false;
+    int cpu = -1;
+    int priority = 0;
+};
+
+// Applies every step to the calling thread. Steps that fail are listed in 'error' and the
+// rest still apply; returns true only if everything requested succeeded.
+bool enterRealtime(const RealtimeConfig& config, RealtimeStatus& status, std::string& error);
+
+// One line for logs and the UI, e.g. "RT cpu 3, FIFO 80, mlock, prefault"
+std::string describeRealtime(const RealtimeStatus& status);
+
+// ========== Absolute-Deadline Pacing ==========
+// Sleeps to absolute CLOCK_MONOTONIC deadlines one period apart (clock_nanosleep with
+// TIMER_ABSTIME on POSIX), so the period does not drift with the work done in each frame.
+// A frame that is still running at its deadline is a miss; if the loop falls more than a
+// full period behind it re-phases to now instead of bursting to catch up.
+
+struct DeadlineStats {
+    uint64_t frames = 0;
+    uint64_t misses = 0;                 // Frames that ran past their deadline
+    uint64_t skipped_periods = 0;        // Whole periods dropped when re-phasing
+    uint64_t max_late_ns = 0;            // Worst overrun past a deadline
+    uint64_t max_wake_ns = 0;            // Worst wake-up latency after a sleep
+};
+
+class DeadlineClock {
+public:
+    // First deadline one period from now
+    void start(uint64_t period_ns);
+
+    // Call at the end of each frame. Returns false when the frame missed its deadline;
+    // 'late_ns' then holds how far past it the frame ran.
+    bool wait(uint64_t* late_ns = nullptr);
+
+    uint64_t period() const { return period_ns_; }
+    const DeadlineStats& stats() const { return stats_; }
+
+    // Optional: wake-up latency of every sleep, in ns
+    void setWakeHistogram(LatencyHistogram* histogram) { wake_histogram_ = histogram; }
+
+private:
+    uint64_t period_ns_ = 0;
+    uint64_t next_ns_ = 0;
+    DeadlineStats stats_;
+    LatencyHistogram* wake_histogram_ = nullptr;
+};
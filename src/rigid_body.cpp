@@ -0,0 +1,329 @@
+//
+//
+// Santiago Quintana Moreno A01571222
+// Created on: 18/10/2026.
+#include "rigid_body.h"
+#include "atmosphere.h"
+#include <algorithm>
+#include <cmath>
+
+static float clampf(float v, float lo, float hi) { return std::max(lo, std::min(hi, v)); }
+static double clampd(double v, double lo, double hi) { return std::max(lo, std::min(hi, v)); }
+
+static const double DEG_TO_RAD = 0.017453292519943295;
+static const double RAD_TO_DEG = 57.29577951308232;
+static const double FT_TO_M = 0.3048;
+static const double KT_TO_MS = 0.5144444444444445;
+static const double MS_TO_FPM = 196.85039370078738;
+static const double G_MS2 = 9.80665;
+
+// Below this airspeed there is no coordinated turn to fly (on the ground, parked)
+static const double MIN_TURN_SPEED_MS = 30.0;
+
+// ========== Built-in coefficients ==========
+// Used without an aero database. Same shape as aero/a320.aero: per flap setting CL0, stall
+// AoA, flap drag and Cm0, blended linearly while the flaps run.
+
+static const float BUILTIN_CL0[5] = {0.20f, 0.45f, 0.65f, 0.85f, 1.10f};
+static const float BUILTIN_STALL_DEG[5] = {15.0f, 15.5f, 14.5f, 14.0f, 13.0f};
+static const float BUILTIN_CD_FLAPS[5] = {0.0f, 0.012f, 0.025f, 0.040f, 0.070f};
+static const float BUILTIN_CM0[5] = {0.03f, 0.0f, -0.03f, -0.06f, -0.10f};
+
+static AeroCoefficients builtinCoefficients(float aoa_deg, float mach, float flaps, float gear) {
+    flaps = clampf(flaps, 0.0f, 4.0f);
+    int i = std::min((int)flaps, 3);
+    float t = flaps - (float)i;
+    auto blend = [&](const float* table) { return table[i] + (table[i + 1] - table[i]) * t; };
+
+    float m = std::min(mach, 0.84f);
+    float lift_slope = 0.095f * std::sqrt(0.99f / (1.0f - m * m));    // Prandtl-Glauert, 1 at M0.1
+    float cl0 = blend(BUILTIN_CL0);
+    float stall = blend(BUILTIN_STALL_DEG) - std::max(0.0f, mach - 0.3f) * 8.0f;
+
+    AeroCoefficients c;
+    if (aoa_deg <= stall) {
+        c.cl = cl0 + lift_slope * aoa_deg;
+    } else {
+        c.cl = cl0 + lift_slope * stall - 0.08f * (aoa_deg - stall);
+    }
+
+    float clean = 1.0f - std::min(flaps, 1.0f);
+    float induced = (0.05f - 0.005f * clean) * c.cl * c.cl;
+    float critical_mach = 0.80f - 0.10f * std::max(c.cl, 0.0f);
+    float wave = clean * 20.0f * std::pow(std::max(0.0f, mach - critical_mach), 4.0f);
+    c.cd = 0.021f + blend(BUILTIN_CD_FLAPS) + 0.018f * gear + induced + wave;
+    if (aoa_deg > stall) c.cd += 0.05f * (aoa_deg - stall);
+
+    c.cm = blend(BUILTIN_CM0) - 0.012f * aoa_deg - 0.005f * gear;
+    if (mach > 0.75f) c.cm -= 0.2f * (mach - 0.75f);
+    return c;
+}
+
+// ========== Quaternion helpers ==========
+
+struct Rotation {
+    double m[3][3];                      // Body to NED
+};
+
+static Rotation rotationOf(const Quaternion& q) {
+    double xx = q.x * q.x, yy = q.y * q.y, zz = q.z * q.z;
+    double xy = q.x * q.y, xz = q.x * q.z, yz = q.y * q.z;
+    double wx = q.w * q.x, wy = q.w * q.y, wz = q.w * q.z;
+    Rotation r;
+    r.m[0][0] = 1.0 - 2.0 * (yy + zz); r.m[0][1] = 2.0 * (xy - wz);        r.m[0][2] = 2.0 * (xz + wy);
+    r.m[1][0] = 2.0 * (xy + wz);        r.m[1][1] = 1.0 - 2.0 * (xx + zz); r.m[1][2] = 2.0 * (yz - wx);
+    r.m[2][0] = 2.0 * (xz - wy);        r.m[2][1] = 2.0 * (yz + wx);        r.m[2][2] = 1.0 - 2.0 * (xx + yy);
+    return r;
+}
+
+static Quaternion fromEuler(double roll, double pitch, double yaw) {
+    double cr = std::cos(roll * 0.5), sr = std::sin(roll * 0.5);
+    double cp = std::cos(pitch * 0.5), sp = std::sin(pitch * 0.5);
+    double cy = std::cos(yaw * 0.5), sy = std::sin(yaw * 0.5);
+    Quaternion q;
+    q.w = cr * cp * cy + sr * sp * sy;
+    q.x = sr * cp * cy - cr * sp * sy;
+    q.y = cr * sp * cy + sr * cp * sy;
+    q.z = cr * cp * sy - sr * sp * cy;
+    return q;
+}
+
+static void normalize(Quaternion& q) {
+    double n = std::sqrt(q.w * q.w + q.x * q.x + q.y * q.y + q.z * q.z);
+    if (n <= 0.0) {
+        q = Quaternion{};
+        return;
+    }
+    double inv = 1.0 / n;
+    q.w *= inv;
+    q.x *= inv;
+    q.y *= inv;
+    q.z *= inv;
+}
+
+// out = x + d * h, field by field
+static void advance(RigidBodyState& out, const RigidBodyState& x, const RigidBodyState& d, double h) {
+    out.attitude.w = x.attitude.w + d.attitude.w * h;
+    out.attitude.x = x.attitude.x + d.attitude.x * h;
+    out.attitude.y = x.attitude.y + d.attitude.y * h;
+    out.attitude.z = x.attitude.z + d.attitude.z * h;
+    out.p = x.p + d.p * h;
+    out.q = x.q + d.q * h;
+    out.r = x.r + d.r * h;
+    out.u = x.u + d.u * h;
+    out.v = x.v + d.v * h;
+    out.w = x.w + d.w * h;
+    out.north_m = x.north_m + d.north_m * h;
+    out.east_m = x.east_m + d.east_m * h;
+    out.altitude_m = x.altitude_m + d.altitude_m * h;
+}
+
+// Body rates of a turn at 'turn_rate' (rad/s of heading) plus the demanded Euler rates
+static void bodyRateDemand(double roll, double pitch, double roll_rate, double pitch_rate, double turn_rate,
+                           double& p, double& q, double& r) {
+    double sr = std::sin(roll), cr = std::cos(roll);
+    double sp = std::sin(pitch), cp = std::cos(pitch);
+    p = roll_rate - turn_rate * sp;
+    q = pitch_rate * cr + turn_rate * cp * sr;
+    r = -pitch_rate * sr + turn_rate * cp * cr;
+}
+
+// ========== RigidBody ==========
+
+// Heading rate of a coordinated turn at bank 'roll', as far as the wing can fly it: the bank
+// is counted up to max_turn_nz, and the turn fades out as the AoA nears the stall. Past that
+// the control laws' pitch demand is all the loop follows.
+double RigidBody::turnRate(double roll, double airspeed_ms, double alpha) const {
+    if (airspeed_ms <= MIN_TURN_SPEED_MS) return 0.0;
+    const AirframeParams& a = params_;
+    double max_tan = std::sqrt(std::max((double)a.max_turn_nz * a.max_turn_nz - 1.0, 0.0));
+    double tan_roll = clampd(std::tan(clampd(roll, -1.4, 1.4)), -max_tan, max_tan);
+    double margin = (a.turn_zero_aoa_deg - alpha * RAD_TO_DEG) / (a.turn_zero_aoa_deg - a.turn_fade_aoa_deg);
+    return G_MS2 * tan_roll / airspeed_ms * clampd(margin, 0.0, 1.0);
+}
+
+void RigidBody::configure(const AirframeParams& params, const AeroDatabase* aero) {
+    params_ = params;
+    aero_ = aero;
+    if (aero) {
+        params_.mass_kg = aero->reference().mass_kg;
+        params_.wing_area_m2 = aero->reference().wing_area_m2;
+        params_.chord_m = aero->reference().chord_m;
+    }
+    cursor_ = AeroCursor{};
+    valid_ = false;
+}
+
+void RigidBody::follow(const Sensors& s) {
+    bool unchanged = valid_ && s.altitude_ft == written_.altitude_ft && s.ias_knots == written_.ias_knots
+                     && s.vs_fpm == written_.vs_fpm && s.pitch_deg == written_.pitch_deg && s.roll_deg == written_.roll_deg
+                     && s.heading_deg == written_.heading_deg && s.aoa_deg == written_.aoa_deg;
+    if (!unchanged) init(s);
+}
+
+void RigidBody::init(const Sensors& s) {
+    // Wings-level flight path from V/S; AoA is whatever separates it from the pitch attitude
+    double airspeed = std::max(casToTas(s.ias_knots, s.altitude_ft), 0.0f) * KT_TO_MS;
+    double vs_ms = s.vs_fpm / MS_TO_FPM;
+    double gamma = (airspeed > 1.0) ? std::asin(clampd(vs_ms / airspeed, -1.0, 1.0)) : 0.0;
+    double roll = s.roll_deg * DEG_TO_RAD;
+    double pitch = s.pitch_deg * DEG_TO_RAD;
+    double alpha = pitch - gamma;
+
+    state_.attitude = fromEuler(roll, pitch, s.heading_deg * DEG_TO_RAD);
+    state_.u = airspeed * std::cos(alpha);
+    state_.v = 0.0;
+    state_.w = airspeed * std::sin(alpha);
+    bodyRateDemand(roll, pitch, 0.0, 0.0, turnRate(roll, airspeed, alpha), state_.p, state_.q, state_.r);
+    state_.altitude_m = std::max(s.altitude_ft, 0.0f) * FT_TO_M;
+    valid_ = true;
+}
+
+RigidBody::Derivative RigidBody::derivative(const RigidBodyState& x, const RigidBodyInputs& in) {
+    const AirframeParams& a = params_;
+    Rotation rot = rotationOf(x.attitude);
+    const double (*m)[3] = rot.m;
+
+    // ========== Air data ==========
+    double altitude_ft = x.altitude_m / FT_TO_M;
+    AtmosphereState atm = isaAtmosphere(altitude_ft);
+    double airspeed = std::sqrt(x.u * x.u + x.v * x.v + x.w * x.w);
+    double v_safe = std::max(airspeed, 1.0);
+    double alpha = std::atan2(x.w, x.u);
+    double beta = std::asin(clampd(x.v / v_safe, -1.0, 1.0));
+    double mach = airspeed / (atm.speed_of_sound_kt * KT_TO_MS);
+    double qbar_s = 0.5 * atm.density_kgm3 * airspeed * airspeed * a.wing_area_m2;
+
+    AeroCoefficients c;
+    if (aero_) {
+        AeroPoint point;
+        point.aoa_deg = alpha * RAD_TO_DEG;
+        point.mach = mach;
+        point.flaps = in.flaps;
+        point.gear = in.gear;
+        c = aero_->evaluate(point, cursor_);
+    } else {
+        c = builtinCoefficients(alpha * RAD_TO_DEG, mach, in.flaps, in.gear);
+    }
+    double cd = c.cd + a.cd_speedbrake * in.speedbrake;
+
+    // ========== Forces (body axes) ==========
+    double lapse = std::pow(atm.sigma, 0.75);
+    double thrust_left = in.thrust_left * a.max_thrust_n * lapse;
+    double thrust_right = in.thrust_right * a.max_thrust_n * lapse;
+    double ca = std::cos(alpha), sa = std::sin(alpha);
+    double fx = qbar_s * (-cd * ca + c.cl * sa) + thrust_left + thrust_right;
+    double fy = qbar_s * a.cy_beta * beta;
+    double fz = qbar_s * (-cd * sa - c.cl * ca);
+
+    Derivative d;
+    d.nz = -fz / (a.mass_kg * G_MS2);
+
+    // Gravity is the NED down axis seen from the body: the bottom row of body-to-NED
+    double inv_mass = 1.0 / a.mass_kg;
+    d.rate.u = fx * inv_mass + G_MS2 * m[2][0] - (x.q * x.w - x.r * x.v);
+    d.rate.v = fy * inv_mass + G_MS2 * m[2][1] - (x.r * x.u - x.p * x.w);
+    d.rate.w = fz * inv_mass + G_MS2 * m[2][2] - (x.p * x.v - x.q * x.u);
+
+    // ========== Moments ==========
+    double qbar_sb = qbar_s * a.span_m;
+    double qbar_sc = qbar_s * a.chord_m;
+    double half_span = a.span_m / (2.0 * v_safe);
+    double half_chord = a.chord_m / (2.0 * v_safe);
+    double roll_aero = qbar_sb * (a.cl_beta * beta + a.cl_p * x.p * half_span);
+    double pitch_aero = qbar_sc * (c.cm + a.cm_q * x.q * half_chord);
+    double yaw_aero = qbar_sb * (a.cn_beta * beta + a.cn_r * x.r * half_span);
+    double yaw_thrust = a.engine_arm_m * (thrust_left - thrust_right);   // Left engine yaws right
+
+    // Rate loop: roll and pitch also cancel the aerodynamic moment they can see; yaw leaves
+    // sideslip and thrust asymmetry to show up before the rudder catches them
+    double roll = std::atan2(m[2][1], m[2][2]);
+    double pitch = -std::asin(clampd(m[2][0], -1.0, 1.0));
+    double p_cmd, q_cmd, r_cmd;
+    bodyRateDemand(roll, pitch, in.roll_rate_dps * DEG_TO_RAD, in.pitch_rate_dps * DEG_TO_RAD, turnRate(roll, airspeed, alpha),
+                   p_cmd, q_cmd, r_cmd);
+    double roll_limit = qbar_sb * a.roll_authority;
+    double pitch_limit = qbar_sc * a.pitch_authority;
+    double yaw_limit = qbar_sb * a.yaw_authority;
+    double roll_ctrl = clampd(a.ixx * a.roll_gain * (p_cmd - x.p) - roll_aero, -roll_limit, roll_limit);
+    double pitch_ctrl = clampd(a.iyy * a.pitch_gain * (q_cmd - x.q) - pitch_aero, -pitch_limit, pitch_limit);
+    double yaw_ctrl = clampd(a.izz * a.yaw_gain * (r_cmd - x.r), -yaw_limit, yaw_limit);
+
+    d.rate.p = (roll_aero + roll_ctrl + (a.iyy - a.izz) * x.q * x.r) / a.ixx;
+    d.rate.q = (pitch_aero + pitch_ctrl + (a.izz - a.ixx) * x.p * x.r) / a.iyy;
+    d.rate.r = (yaw_aero + yaw_thrust + yaw_ctrl + (a.ixx - a.iyy) * x.p * x.q) / a.izz;
+
+    // ========== Kinematics ==========
+    const Quaternion& q = x.attitude;
+    d.rate.attitude.w = -0.5 * (q.x * x.p + q.y * x.q + q.z * x.r);
+    d.rate.attitude.x = 0.5 * (q.w * x.p + q.y * x.r - q.z * x.q);
+    d.rate.attitude.y = 0.5 * (q.w * x.q + q.z * x.p - q.x * x.r);
+    d.rate.attitude.z = 0.5 * (q.w * x.r + q.x * x.q - q.y * x.p);
+
+    d.rate.north_m = m[0][0] * x.u + m[0][1] * x.v + m[0][2] * x.w + in.wind_north_ms;
+    d.rate.east_m = m[1][0] * x.u + m[1][1] * x.v + m[1][2] * x.w + in.wind_east_ms;
+    d.rate.altitude_m = -(m[2][0] * x.u + m[2][1] * x.v + m[2][2] * x.w);
+    return d;
+}
+
+void RigidBody::step(const RigidBodyInputs& in, float dt_sec, float substep_sec) {
+    last_inputs_ = in;
+    if (dt_sec <= 0.0f) return;
+    int substeps = std::max(1, (int)std::ceil(dt_sec / std::max(substep_sec, 1e-5f) - 1e-3f));
+    double h = (double)dt_sec / substeps;
+
+    RigidBodyState tmp;
+    for (int i = 0; i < substeps; ++i) {
+        Derivative k1 = derivative(state_, in);
+        advance(tmp, state_, k1.rate, 0.5 * h);
+        Derivative k2 = derivative(tmp, in);
+        advance(tmp, state_, k2.rate, 0.5 * h);
+        Derivative k3 = derivative(tmp, in);
+        advance(tmp, state_, k3.rate, h);
+        Derivative k4 = derivative(tmp, in);
+
+        advance(state_, state_, k1.rate, h / 6.0);
+        advance(state_, state_, k2.rate, h / 3.0);
+        advance(state_, state_, k3.rate, h / 3.0);
+        advance(state_, state_, k4.rate, h / 6.0);
+        normalize(state_.attitude);
+
+        // Ground plane: no sinking below it (the gear is not modelled as a spring)
+        if (state_.altitude_m <= 0.0) {
+            state_.altitude_m = 0.0;
+            Rotation rot = rotationOf(state_.attitude);
+            double sink = rot.m[2][0] * state_.u + rot.m[2][1] * state_.v + rot.m[2][2] * state_.w;
+            if (sink > 0.0) {
+                state_.u -= sink * rot.m[2][0];
+                state_.v -= sink * rot.m[2][1];
+                state_.w -= sink * rot.m[2][2];
+            }
+        }
+    }
+}
+
+void RigidBody::output(Sensors& s) {
+    Derivative d = derivative(state_, last_inputs_);
+    Rotation rot = rotationOf(state_.attitude);
+    const double (*m)[3] = rot.m;
+
+    double altitude_ft = state_.altitude_m / FT_TO_M;
+    double airspeed_ms = std::sqrt(state_.u * state_.u + state_.v * state_.v + state_.w * state_.w);
+    double airspeed_kt = airspeed_ms / KT_TO_MS;
+    // The vane has nothing to align with when parked
+    double alpha = (airspeed_ms > 1.0) ? std::atan2(state_.w, state_.u) : 0.0;
+    double heading = std::atan2(m[1][0], m[0][0]) * RAD_TO_DEG;
+    if (heading < 0.0) heading += 360.0;
+    if (heading >= 360.0) heading -= 360.0;
+
+    s.altitude_ft = altitude_ft;
+    s.vs_fpm = d.rate.altitude_m * MS_TO_FPM;
+    s.ias_knots = tasToCas(airspeed_kt, altitude_ft);
+    s.mach = tasToMach(airspeed_kt, altitude_ft);
+    s.pitch_deg = -std::asin(clampd(m[2][0], -1.0, 1.0)) * RAD_TO_DEG;
+    s.roll_deg = std::atan2(m[2][1], m[2][2]) * RAD_TO_DEG;
+    s.heading_deg = heading;
+    s.aoa_deg = alpha * RAD_TO_DEG;
+    s.nz = d.nz;
+    written_ = s;
+}
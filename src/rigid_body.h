@@ -0,0 +1,125 @@
+//
+//
+// Santiago Quintana Moreno A01571222
+// Created on: 18/10/2026.
+#pragma once
+#include "aero_table.h"
+#include "sim_types.h"
+
+// ========== 6-DOF Rigid Body ==========
+// Quaternion attitude, body rates, body-axis air velocity and position, driven by aero forces
+// and moments (an AeroDatabase, or built-in coefficients shaped like aero/a320.aero), engine
+// thrust and gravity over a flat earth. Integrated with classic RK4 at a fixed substep.
+//
+// The flight control laws upstream produce Euler-rate demands (the pitch and roll rates the
+// point-mass model integrates directly). Here they become body-rate demands, with the yaw
+// rate of a coordinated turn, and a rate loop standing in for the FBW inner loop turns the
+// rate error into control moments. Those are limited to what the surfaces can produce at the
+// current dynamic pressure, so slow flight runs out of authority like the real thing.
+//
+// The state is in double: at 1 kHz a float airspeed near 90 m/s cannot take increments below
+// ~0.008 m/s^2, which swallows the small accelerations a trim or a shallow descent is made of.
+// It is a handful of values with no heap, so fast-time batches (runScriptBatch, the fault
+// sweep) carry one per aircraft like the rest of SimState.
+
+struct Quaternion {
+    double w = 1.0;
+    double x = 0.0;
+    double y = 0.0;
+    double z = 0.0;
+};
+
+struct RigidBodyState {
+    Quaternion attitude;                // Body to local NED
+    double p = 0.0;                     // Body rates, rad/s
+    double q = 0.0;
+    double r = 0.0;
+    double u = 0.0;                     // Body-axis velocity relative to the air mass, m/s
+    double v = 0.0;
+    double w = 0.0;
+    double north_m = 0.0;               // Position over ground
+    double east_m = 0.0;
+    double altitude_m = 0.0;
+};
+
+struct AirframeParams {
+    float mass_kg = 64000.0f;           // Reference values; an aero database overrides these three
+    float wing_area_m2 = 122.6f;
+    float chord_m = 4.19f;
+    float span_m = 34.1f;
+    float ixx = 1.28e6f;                // Principal moments of inertia, kg m^2
+    float iyy = 3.9e6f;
+    float izz = 5.0e6f;
+    float max_thrust_n = 240000.0f;     // Both engines, sea-level static
+    float engine_arm_m = 5.75f;         // Lateral engine offset from the centreline
+
+    // Stability derivatives (per rad, rates non-dimensional)
+    float cy_beta = -0.8f;
+    float cl_beta = -0.1f;
+    float cn_beta = 0.12f;
+    float cl_p = -0.45f;
+    float cm_q = -20.0f;
+    float cn_r = -0.2f;
+    float cd_speedbrake = 0.04f;        // At full extension
+
+    // Rate loop gains (1/s) and the largest control moment coefficient per axis
+    float roll_gain = 5.0f;
+    float pitch_gain = 5.0f;
+    float yaw_gain = 3.0f;
+    float roll_authority = 0.08f;
+    float pitch_authority = 0.5f;
+    float yaw_authority = 0.1f;
+
+    // The coordinated-turn rates the loop adds to the demands ask for no more than
+    // max_turn_nz, and fade out between these AoAs so a steep bank cannot pull into the stall
+    float max_turn_nz = 2.5f;
+    float turn_fade_aoa_deg = 11.0f;
+    float turn_zero_aoa_deg = 15.0f;
+};
+
+struct RigidBodyInputs {
+    float pitch_rate_dps = 0.0f;        // Euler rate demands from the control laws
+    float roll_rate_dps = 0.0f;
+    float thrust_left = 0.0f;           // Share of max_thrust_n from each engine (0 .. 0.5 with both)
+    float thrust_right = 0.0f;
+    float flaps = 0.0f;                 // AeroPoint coordinates
+    float gear = 0.0f;
+    float speedbrake = 0.0f;            // 0..1
+    float wind_north_ms = 0.0f;         // Steady air-mass motion
+    float wind_east_ms = 0.0f;
+};
+
+class RigidBody {
+public:
+    void configure(const AirframeParams& params, const AeroDatabase* aero);
+
+    // Takes the state over from 's' unless it is exactly what output() last wrote, so a
+    // trim, a scenario 'sensor' action or an instructor edit moves the aircraft
+    void follow(const Sensors& s);
+
+    // Advances dt_sec in RK4 steps of at most substep_sec
+    void step(const RigidBodyInputs& in, float dt_sec, float substep_sec);
+
+    // Attitude, air data, V/S, AoA and load factor; heading wrapped to 0..360
+    void output(Sensors& s);
+
+    const RigidBodyState& state() const { return state_; }
+
+private:
+    struct Derivative {
+        RigidBodyState rate;            // Time derivative of every state field
+        double nz = 1.0;                // Body-axis load factor at the evaluated state
+    };
+
+    Derivative derivative(const RigidBodyState& x, const RigidBodyInputs& in);
+    double turnRate(double roll, double airspeed_ms, double alpha) const;
+    void init(const Sensors& s);
+
+    AirframeParams params_;
+    const AeroDatabase* aero_ = nullptr;
+    AeroCursor cursor_;
+    RigidBodyState state_;
+    RigidBodyInputs last_inputs_;
+    Sensors written_;                   // What output() last wrote, to spot outside changes
+    bool valid_ = false;
+};
@@ -0,0 +1,477 @@
+//
+//
+// Santiago Quintana Moreno A01571222
+// Created on: 18/10/2026.
+#include "scenario.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+static const char* const VAR_NAMES[] = {
+    "altitude_ft", "ias_knots", "aoa_deg", "vs_fpm", "pitch_deg", "roll_deg", "heading_deg", "mach", "nz", "tat_c"
+};
+static_assert(sizeof(VAR_NAMES) / sizeof(VAR_NAMES[0]) == (size_t)ScenarioVar::COUNT, "VAR_NAMES out of sync");
+
+static float Sensors::* sensorMember(ScenarioVar var) {
+    switch (var) {
+        case ScenarioVar::ALTITUDE_FT: return &Sensors::altitude_ft;
+        case ScenarioVar::IAS_KNOTS:   return &Sensors::ias_knots;
+        case ScenarioVar::AOA_DEG:     return &Sensors::aoa_deg;
+        case ScenarioVar::VS_FPM:      return &Sensors::vs_fpm;
+        case ScenarioVar::PITCH_DEG:   return &Sensors::pitch_deg;
+        case ScenarioVar::ROLL_DEG:    return &Sensors::roll_deg;
+        case ScenarioVar::HEADING_DEG: return &Sensors::heading_deg;
+        case ScenarioVar::MACH:        return &Sensors::mach;
+        case ScenarioVar::NZ:          return &Sensors::nz;
+        case ScenarioVar::TAT_C:       return &Sensors::tat_c;
+        case ScenarioVar::COUNT:       break;
+    }
+    return &Sensors::altitude_ft;
+}
+
+float scenarioVarValue(const Sensors& s, ScenarioVar var) {
+    return s.*sensorMember(var);
+}
+
+static bool varFromName(const std::string& name, ScenarioVar& out) {
+    for (int i = 0; i < (int)ScenarioVar::COUNT; ++i) {
+        if (name == VAR_NAMES[i]) {
+            out = (ScenarioVar)i;
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool parseFloat(const std::string& tok, float& out) {
+    if (tok.empty()) return false;
+    char* end = nullptr;
+    out = std::strtof(tok.c_str(), &end);
+    return end && *end == '\0';
+}
+
+static bool parseOnOff(const std::string& tok, float& out) {
+    if (tok == "on")  { out = 1.0f; return true; }
+    if (tok == "off") { out = 0.0f; return true; }
+    return false;
+}
+
+static bool parseFlaps(const std::string& tok, FlapsPosition& out) {
+    static const char* const names[] = { "0", "1", "2", "3", "FULL" };
+    for (int i = 0; i < 5; ++i) {
+        if (tok == names[i]) {
+            out = (FlapsPosition)i;
+            return true;
+        }
+    }
+    return false;
+}
+
+static std::vector<std::string> tokenize(const std::string& line) {
+    std::vector<std::string> tokens;
+    size_t i = 0;
+    while (i < line.size()) {
+        while (i < line.size() && (line[i] == ' ' || line[i] == '\t' || line[i] == '\r')) ++i;
+        if (i >= line.size() || line[i] == '#') break;
+        size_t start = i;
+        while (i < line.size() && line[i] != ' ' && line[i] != '\t' && line[i] != '\r' && line[i] != '#') ++i;
+        tokens.push_back(line.substr(start, i - start));
+    }
+    return tokens;
+}
+
+// Parses the action starting at tokens[pos]; it must consume the rest of the line
+static bool parseAction(const std::vector<std::string>& t, size_t pos, ScenarioAction& a, std::string& error) {
+    if (pos >= t.size()) { error = "missing action"; return false; }
+    const std::string& verb = t[pos];
+    size_t argc = t.size() - pos - 1;
+    auto arg = [&](size_t i) -> const std::string& { return t[pos + 1 + i]; };
+
+    if (verb == "end") {
+        a.type = ScenarioActionType::END;
+        if (argc != 0) { error = "'end' takes no arguments"; return false; }
+        return true;
+    }
+
+    if (argc == 0) { error = "missing arguments for '" + verb + "'"; return false; }
+
+    if (verb == "fault") {
+        FaultId id;
+        if (argc != 2 || !faultFromName(arg(0).c_str(), id) || !parseOnOff(arg(1), a.value)) {
+            error = "expected 'fault <Faults field> on|off'";
+            return false;
+        }
+        a.type = ScenarioActionType::FAULT;
+        a.index = (uint8_t)id;
+        return true;
+    }
+
+    if (verb == "pilot" || verb == "weather") {
+        static const struct { const char* verb; const char* name; ScenarioActionType type; } fields[] = {
+            { "pilot", "pitch", ScenarioActionType::PILOT_PITCH },
+            { "pilot", "roll", ScenarioActionType::PILOT_ROLL },
+            { "pilot", "thrust", ScenarioActionType::PILOT_THRUST },
+            { "weather", "wind_speed", ScenarioActionType::WIND_SPEED },
+            { "weather", "wind_dir", ScenarioActionType::WIND_DIR },
+            { "weather", "turbulence", ScenarioActionType::TURBULENCE },
+            { "weather", "windshear", ScenarioActionType::WINDSHEAR },
+        };
+        for (const auto& f : fields) {
+            if (verb == f.verb && argc == 2 && arg(0) == f.name) {
+                a.type = f.type;
+                if (!parseFloat(arg(1), a.value)) { error = "bad value '" + arg(1) + "'"; return false; }
+                return true;
+            }
+        }
+        error = "unknown " + verb + " field";
+        return false;
+    }
+
+    if (verb == "ap") {
+        static const struct { const char* name; ScenarioActionType type; bool on_off; } fields[] = {
+            { "spd", ScenarioActionType::AP_SPD, true },
+            { "hdg", ScenarioActionType::AP_HDG, true },
+            { "alt", ScenarioActionType::AP_ALT, true },
+            { "vs", ScenarioActionType::AP_VS, true },
+            { "athr", ScenarioActionType::AP_ATHR, true },
+            { "target_spd", ScenarioActionType::AP_TARGET_SPD, false },
+            { "target_hdg", ScenarioActionType::AP_TARGET_HDG, false },
+            { "target_alt", ScenarioActionType::AP_TARGET_ALT, false },
+            { "target_vs", ScenarioActionType::AP_TARGET_VS, false },
+        };
+        for (const auto& f : fields) {
+            if (argc == 2 && arg(0) == f.name) {
+                a.type = f.type;
+                bool ok = f.on_off ? parseOnOff(arg(1), a.value) : parseFloat(arg(1), a.value);
+                if (!ok) { error = "bad value '" + arg(1) + "'"; return false; }
+                return true;
+            }
+        }
+        error = "unknown autopilot field";
+        return false;
+    }
+
+    if (verb == "flaps") {
+        FlapsPosition flaps;
+        if (argc != 1 || !parseFlaps(arg(0), flaps)) { error = "expected 'flaps 0|1|2|3|FULL'"; return false; }
+        a.type = ScenarioActionType::FLAPS;
+        a.value = (float)(int)flaps;
+        return true;
+    }
+
+    if (verb == "gear") {
+        if (argc != 1 || (arg(0) != "up" && arg(0) != "down")) { error = "expected 'gear up|down'"; return false; }
+        a.type = ScenarioActionType::GEAR;
+        a.value = (arg(0) == "down") ? 1.0f : 0.0f;
+        return true;
+    }
+
+    if (verb == "engine") {
+        if (argc != 2 || (arg(0) != "1" && arg(0) != "2")) { error = "expected 'engine 1|2 on|off|fire'"; return false; }
+        a.index = (uint8_t)(arg(0)[0] - '0');
+        if (arg(1) == "fire") {
+            a.type = ScenarioActionType::ENGINE_FIRE;
+            a.value = 1.0f;
+            return true;
+        }
+        a.type = ScenarioActionType::ENGINE_RUNNING;
+        if (!parseOnOff(arg(1), a.value)) { error = "expected 'engine 1|2 on|off|fire'"; return false; }
+        return true;
+    }
+
+    if (verb == "override") {
+        a.type = ScenarioActionType::SENSOR_OVERRIDE;
+        if (argc != 1 || !parseOnOff(arg(0), a.value)) { error = "expected 'override on|off'"; return false; }
+        return true;
+    }
+
+    if (verb == "sensor") {
+        ScenarioVar var;
+        if (argc != 2 || !varFromName(arg(0), var) || !parseFloat(arg(1), a.value)) {
+            error = "expected 'sensor <Sensors field> <value>'";
+            return false;
+        }
+        a.type = ScenarioActionType::SENSOR;
+        a.index = (uint8_t)var;
+        return true;
+    }
+
+    error = "unknown action '" + verb + "'";
+    return false;
+}
+
+static bool parseStart(const std::vector<std::string>& t, Scenario& out, std::string& error) {
+    if (t.size() == 2) {
+        if (t[1] == "ground")    { out.start = StartupScenario::GROUND_PARKED;  out.trim_start = false; return true; }
+        if (t[1] == "cruise10k") { out.start = StartupScenario::CRUISE_10000FT; out.trim_start = false; return true; }
+        if (t[1] == "cruise37k") { out.start = StartupScenario::CRUISE_37000FT; out.trim_start = false; return true; }
+    }
+    if ((t.size() == 6 || t.size() == 7) && t[1] == "trim") {
+        TrimCondition& c = out.trim_condition;
+        bool ok = parseFloat(t[2], c.altitude_ft) && parseFloat(t[3], c.ias_knots) && parseFlaps(t[4], c.flaps)
+                  && (t[5] == "up" || t[5] == "down");
+        c.gear = (t[5] == "down") ? GearPosition::DOWN : GearPosition::UP;
+        c.vs_fpm = 0.0f;
+        if (ok && t.size() == 7) ok = parseFloat(t[6], c.vs_fpm);
+        if (ok) {
+            out.trim_start = true;
+            return true;
+        }
+    }
+    error = "expected 'start ground|cruise10k|cruise37k' or 'start trim <alt> <ias> <flaps> <up|down> [vs]'";
+    return false;
+}
+
+bool parseScenario(const std::string& text, Scenario& out, std::string& error) {
+    out = Scenario{};
+    size_t line_no = 0;
+    size_t pos = 0;
+
+    while (pos <= text.size()) {
+        size_t eol = text.find('\n', pos);
+        if (eol == std::string::npos) eol = text.size();
+        std::string line = text.substr(pos, eol - pos);
+        pos = eol + 1;
+        ++line_no;
+
+        std::vector<std::string> t = tokenize(line);
+        if (t.empty()) continue;
+
+        std::string why;
+        bool ok = true;
+        const std::string& kw = t[0];
+
+        if (kw == "name") {
+            // Keep the rest of the line as written
+            size_t start = line.find("name") + 4;
+            size_t hash = line.find('#', start);
+            out.name = line.substr(start, hash == std::string::npos ? std::string::npos : hash - start);
+            out.name.erase(0, out.name.find_first_not_of(" \t"));
+            out.name.erase(out.name.find_last_not_of(" \t\r") + 1);
+        } else if (kw == "start") {
+            ok = parseStart(t, out, why);
+        } else if (kw == "dt") {
+            ok = t.size() == 2 && parseFloat(t[1], out.dt_sec) && out.dt_sec > 0.0f && out.dt_sec <= 0.05f;
+            if (!ok) why = "expected 'dt <seconds>' (0 < dt <= 0.05)";
+        } else if (kw == "aero") {
+            ok = t.size() == 2;
+            if (ok) out.aero_path = t[1];
+            else why = "expected 'aero <file>'";
+        } else if (kw == "dynamics") {
+            ok = t.size() == 2 && parseDynamicsModel(t[1].c_str(), out.dynamics);
+            if (!ok) why = "expected 'dynamics point|6dof'";
+        } else if (kw == "at") {
+            ScenarioEvent ev;
+            ok = t.size() >= 2 && parseFloat(t[1], ev.time_sec) && ev.time_sec >= 0.0f;
+            if (!ok) why = "expected 'at <seconds> <action>'";
+            ok = ok && parseAction(t, 2, ev.action, why);
+            if (ok) out.events.push_back(ev);
+        } else if (kw == "when") {
+            ScenarioTrigger tr;
+            ok = t.size() >= 4 && varFromName(t[1], tr.var) && parseFloat(t[3], tr.threshold);
+            if (ok) {
+                if (t[2] == "<")       tr.compare = ScenarioCompare::LESS;
+                else if (t[2] == "<=") tr.compare = ScenarioCompare::LESS_EQUAL;
+                else if (t[2] == ">")  tr.compare = ScenarioCompare::GREATER;
+                else if (t[2] == ">=") tr.compare = ScenarioCompare::GREATER_EQUAL;
+                else ok = false;
+            }
+            if (!ok) why = "expected 'when <Sensors field> <|<=|>|>= <value> <action>'";
+            ok = ok && parseAction(t, 4, tr.action, why);
+            if (ok) out.triggers.push_back(tr);
+        } else {
+            ok = false;
+            why = "unknown statement '" + kw + "'";
+        }
+
+        if (!ok) {
+            error = "line " + std::to_string(line_no) + ": " + why;
+            return false;
+        }
+    }
+
+    // Compile: one flat array in firing order
+    std::stable_sort(out.events.begin(), out.events.end(),
+                     [](const ScenarioEvent& a, const ScenarioEvent& b) { return a.time_sec < b.time_sec; });
+    return true;
+}
+
+bool loadScenarioFile(const char* path, Scenario& out, std::string& error) {
+    FILE* f = std::fopen(path, "rb");
+    if (!f) {
+        error = std::string("cannot open ") + path;
+        return false;
+    }
+    std::string text;
+    char buf[4096];
+    size_t n;
+    while ((n = std::fread(buf, 1, sizeof(buf), f)) > 0) text.append(buf, n);
+    std::fclose(f);
+
+    if (!parseScenario(text, out, error)) {
+        error = std::string(path) + ": " + error;
+        return false;
+    }
+    if (out.name.empty()) out.name = path;
+
+    if (!out.aero_path.empty()) {
+        // Relative to the script, so scenarios/x.scn can say 'aero ../aero/a320.aero'
+        std::string aero_path = out.aero_path;
+        std::string dir = path;
+        size_t slash = dir.find_last_of('/');
+        if (aero_path[0] != '/' && slash != std::string::npos) aero_path = dir.substr(0, slash + 1) + aero_path;
+
+        auto aero = std::make_shared<AeroDatabase>();
+        if (!aero->load(aero_path.c_str(), error)) return false;
+        out.aero = std::move(aero);
+    }
+    return true;
+}
+
+void applyScenarioAction(SimState& sim, const ScenarioAction& a) {
+    bool on = a.value != 0.0f;
+    switch (a.type) {
+        case ScenarioActionType::FAULT: {
+            FaultSet set = sim.faults.bits();
+            set.set((FaultId)a.index, on);
+            sim.faults.setBits(set);
+            break;
+        }
+        case ScenarioActionType::PILOT_PITCH:  sim.pilot.pitch = std::clamp(a.value, -1.0f, 1.0f); break;
+        case ScenarioActionType::PILOT_ROLL:   sim.pilot.roll = std::clamp(a.value, -1.0f, 1.0f); break;
+        case ScenarioActionType::PILOT_THRUST: sim.pilot.thrust = std::clamp(a.value, 0.0f, 1.0f); break;
+
+        case ScenarioActionType::WIND_SPEED:  sim.weather.wind_speed_knots = a.value; break;
+        case ScenarioActionType::WIND_DIR:    sim.weather.wind_direction_deg = a.value; break;
+        case ScenarioActionType::TURBULENCE:  sim.weather.turbulence_intensity = a.value; break;
+        case ScenarioActionType::WINDSHEAR:   sim.weather.windshear_intensity = a.value; break;
+
+        // Mode engagement syncs the target the same way the FCU buttons do
+        case ScenarioActionType::AP_SPD:
+            sim.autopilot.spd_mode = on;
+            if (on) sim.autopilot.target_spd_knots = sim.sensors.ias_knots;
+            break;
+        case ScenarioActionType::AP_HDG:
+            sim.autopilot.hdg_mode = on;
+            if (on) sim.autopilot.target_hdg_deg = sim.sensors.heading_deg;
+            break;
+        case ScenarioActionType::AP_ALT:
+            sim.autopilot.alt_mode = on;
+            if (on) sim.autopilot.target_alt_ft = sim.sensors.altitude_ft;
+            break;
+        case ScenarioActionType::AP_VS:
+            sim.autopilot.vs_mode = on;
+            if (on) sim.autopilot.target_vs_fpm = sim.sensors.vs_fpm;
+            break;
+        case ScenarioActionType::AP_ATHR:        sim.autopilot.autothrust = on; break;
+        case ScenarioActionType::AP_TARGET_SPD:  sim.autopilot.target_spd_knots = a.value; break;
+        case ScenarioActionType::AP_TARGET_HDG:  sim.autopilot.target_hdg_deg = a.value; break;
+        case ScenarioActionType::AP_TARGET_ALT:  sim.autopilot.target_alt_ft = a.value; break;
+        case ScenarioActionType::AP_TARGET_VS:   sim.autopilot.target_vs_fpm = a.value; break;
+
+        case ScenarioActionType::FLAPS:
+            sim.flaps = (FlapsPosition)(int)a.value;
+            break;
+        case ScenarioActionType::GEAR:
+            commandGear(sim.gear, on ? GearPosition::DOWN : GearPosition::UP, sim.timers);
+            break;
+
+        case ScenarioActionType::ENGINE_RUNNING:
+            (a.index == 1 ? sim.engines.engine1_running : sim.engines.engine2_running) = on;
+            break;
+        case ScenarioActionType::ENGINE_FIRE:
+            (a.index == 1 ? sim.engines.engine1_fire : sim.engines.engine2_fire) = on;
+            break;
+
+        case ScenarioActionType::SENSOR_OVERRIDE:
+            sim.settings.manual_sensor_override = on;
+            break;
+        case ScenarioActionType::SENSOR:
+            sim.sensors.*sensorMember((ScenarioVar)a.index) = a.value;
+            break;
+
+        case ScenarioActionType::END:
+            break;
+    }
+}
+
+bool ScenarioRunner::start(const Scenario& scenario, SimState& sim, std::string& error) {
+    scenario_ = nullptr;
+    next_event_ = 0;
+    trigger_fired_.assign(scenario.triggers.size(), 0);
+    finished_ = false;
+
+    FlightModel model;
+    model.aero = scenario.aero.get();
+    model.dynamics = scenario.dynamics;
+    bool trimmed;
+    if (scenario.trim_start) {
+        resetSimulation(sim, StartupScenario::CRUISE_10000FT, model);
+        trimmed = trimSimulation(sim, scenario.trim_condition, error);
+    } else {
+        trimmed = initSimulation(sim, scenario.start, model, error);
+    }
+    if (!trimmed) {
+        error = "'" + scenario.name + "': start condition cannot be trimmed: " + error;
+        return false;
+    }
+    scenario_ = &scenario;
+    return true;
+}
+
+void ScenarioRunner::update(SimState& sim) {
+    if (!scenario_ || finished_) return;
+
+    const auto& events = scenario_->events;
+    while (next_event_ < events.size() && events[next_event_].time_sec <= sim.time_sec) {
+        const ScenarioAction& a = events[next_event_++].action;
+        if (a.type == ScenarioActionType::END) {
+            finished_ = true;
+            return;
+        }
+        applyScenarioAction(sim, a);
+    }
+
+    const auto& triggers = scenario_->triggers;
+    for (size_t i = 0; i < triggers.size(); ++i) {
+        if (trigger_fired_[i]) continue;
+        const ScenarioTrigger& tr = triggers[i];
+        if (!scenarioCompare(scenarioVarValue(sim.sensors, tr.var), tr.compare, tr.threshold)) continue;
+
+        trigger_fired_[i] = 1;
+        if (tr.action.type == ScenarioActionType::END) {
+            finished_ = true;
+            return;
+        }
+        applyScenarioAction(sim, tr.action);
+    }
+}
+
+bool ScenarioRunner::step(SimState& sim, RateExecutive* rates) {
+    if (!scenario_) return false;
+    update(sim);
+    if (finished_) return false;
+    if (rates) rates->advance(sim, scenario_->dt_sec);
+    else stepSimulation(sim, scenario_->dt_sec);
+    return true;
+}
+
+bool ScenarioRunner::stepAdaptive(SimState& sim, AdaptiveStepper& stepper, double until_sec) {
+    if (!scenario_) return false;
+    size_t fired = next_event_ + std::count(trigger_fired_.begin(), trigger_fired_.end(), 1);
+    update(sim);
+    if (finished_) return false;
+    if (next_event_ + std::count(trigger_fired_.begin(), trigger_fired_.end(), 1) != fired) stepper.restart();
+
+    double end = until_sec;
+    const auto& events = scenario_->events;
+    if (next_event_ < events.size()) end = std::min(end, (double)events[next_event_].time_sec);
+
+    pending_thresholds_.clear();
+    const auto& triggers = scenario_->triggers;
+    for (size_t i = 0; i < triggers.size(); ++i) {
+        if (!trigger_fired_[i]) pending_thresholds_.push_back({sensorMember(triggers[i].var), triggers[i].threshold});
+    }
+    return stepper.step(sim, end, &pending_thresholds_) > 0.0;
+}
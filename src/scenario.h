@@ -0,0 +1,141 @@
+//
+//
+// Santiago Quintana Moreno A01571222
+// Created on: 18/10/2026.
+#pragma once
+#include "sim_state.h"
+#include "trim_solver.h"
+#include "rate_executive.h"
+#include "adaptive_step.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// ========== Scenario Scripts ==========
+// Plain-text scenario files (see scenarios/*.scn). One statement per line, '#' starts a comment:
+//
+//   name    QF72 ADR spikes          free text shown in the GUI
+//   start   cruise10k                ground | cruise10k | cruise37k
+//   start   trim 3000 160 2 down -700   alt, IAS, flaps (0-3, FULL), gear (up/down), optional V/S
+//   dt      0.01                     fixed step, identical in GUI and PRIM_run
+//   aero    ../aero/a320.aero        aero database, relative to the script (default: built-in model)
+//   dynamics 6dof                    point (default) | 6dof rigid body
+//   at      12.5  <action>           fires when sim time reaches 12.5 s
+//   when    altitude_ft < 2000 <action>   fires once, the first step the condition holds
+//
+// Actions:
+//   fault <Faults field> on|off      pilot pitch|roll|thrust <v>
+//   weather wind_speed|wind_dir|turbulence|windshear <v>
+//   ap spd|hdg|alt|vs|athr on|off    ap target_spd|target_hdg|target_alt|target_vs <v>
+//   flaps 0|1|2|3|FULL               gear up|down
+//   engine 1|2 on|off|fire           override on|off  (manual sensor override, QF72 mode)
+//   sensor <Sensors field> <v>       end
+//
+// 'at' lines are compiled into one array sorted by time, so the per-step check is a single
+// compare against the next pending event.
+
+enum class ScenarioActionType : uint8_t {
+    FAULT,
+    PILOT_PITCH, PILOT_ROLL, PILOT_THRUST,
+    WIND_SPEED, WIND_DIR, TURBULENCE, WINDSHEAR,
+    AP_SPD, AP_HDG, AP_ALT, AP_VS, AP_ATHR,
+    AP_TARGET_SPD, AP_TARGET_HDG, AP_TARGET_ALT, AP_TARGET_VS,
+    FLAPS, GEAR,
+    ENGINE_RUNNING, ENGINE_FIRE,
+    SENSOR_OVERRIDE, SENSOR,
+    END
+};
+
+struct ScenarioAction {
+    ScenarioActionType type = ScenarioActionType::END;
+    uint8_t index = 0;     // FaultId, engine number or ScenarioVar, depending on type
+    float value = 0.0f;    // New value; 0/1 for on/off actions
+};
+
+struct ScenarioEvent {
+    float time_sec = 0.0f;
+    ScenarioAction action{};
+};
+
+// Sensors fields usable in 'when' conditions and 'sensor' actions
+enum class ScenarioVar : uint8_t {
+    ALTITUDE_FT, IAS_KNOTS, AOA_DEG, VS_FPM, PITCH_DEG, ROLL_DEG, HEADING_DEG, MACH, NZ, TAT_C,
+    COUNT
+};
+
+enum class ScenarioCompare : uint8_t { LESS, LESS_EQUAL, GREATER, GREATER_EQUAL };
+
+float scenarioVarValue(const Sensors& s, ScenarioVar var);
+
+inline bool scenarioCompare(float v, ScenarioCompare compare, float threshold) {
+    switch (compare) {
+        case ScenarioCompare::LESS:          return v < threshold;
+        case ScenarioCompare::LESS_EQUAL:    return v <= threshold;
+        case ScenarioCompare::GREATER:       return v > threshold;
+        case ScenarioCompare::GREATER_EQUAL: return v >= threshold;
+    }
+    return false;
+}
+
+struct ScenarioTrigger {
+    ScenarioVar var = ScenarioVar::ALTITUDE_FT;
+    ScenarioCompare compare = ScenarioCompare::LESS;
+    float threshold = 0.0f;
+    ScenarioAction action{};
+};
+
+struct Scenario {
+    std::string name;
+    StartupScenario start = StartupScenario::CRUISE_10000FT;
+    bool trim_start = false;          // Use trim_condition instead of 'start'
+    TrimCondition trim_condition{};
+    float dt_sec = 0.01f;
+    std::string aero_path;                      // As written in the script; loaded by loadScenarioFile()
+    std::shared_ptr<const AeroDatabase> aero;   // nullptr: built-in aero model
+    DynamicsModel dynamics = DynamicsModel::POINT_MASS;
+
+    std::vector<ScenarioEvent> events;     // Sorted by time, file order kept for equal times
+    std::vector<ScenarioTrigger> triggers;
+};
+
+// Parses and compiles a scenario. On failure 'error' holds "line N: reason". An 'aero'
+// statement only sets aero_path; loadScenarioFile() also loads the database.
+bool parseScenario(const std::string& text, Scenario& out, std::string& error);
+bool loadScenarioFile(const char* path, Scenario& out, std::string& error);
+
+void applyScenarioAction(SimState& sim, const ScenarioAction& action);
+
+// Plays a compiled scenario against a SimState. The GUI and PRIM_run both advance it with
+// step(), so a script produces the same trajectory in either.
+class ScenarioRunner {
+public:
+    // Resets 'sim' to the scenario's start condition. Returns false, with the reason in 'error'
+    // and the runner left inactive, if the start condition cannot be trimmed.
+    bool start(const Scenario& scenario, SimState& sim, std::string& error);
+
+    // Fires every event due at sim.time_sec and any trigger whose condition now holds
+    void update(SimState& sim);
+
+    // update() followed by one stepSimulation() at the scenario's dt, or with 'rates' the same
+    // dt run through the multi-rate executive. Returns false (without stepping) once the
+    // scenario has ended.
+    bool step(SimState& sim, RateExecutive* rates = nullptr);
+
+    // update() followed by one adaptive step (see adaptive_step.h) that ends no later than the
+    // next 'at' event or until_sec and lands on the thresholds of pending 'when' triggers.
+    // Returns false once the scenario has ended or until_sec is reached.
+    bool stepAdaptive(SimState& sim, AdaptiveStepper& stepper, double until_sec);
+
+    bool active() const { return scenario_ != nullptr; }
+    bool finished() const { return finished_; }
+    const Scenario* scenario() const { return scenario_; }
+    size_t eventsFired() const { return next_event_; }
+
+private:
+    const Scenario* scenario_ = nullptr;
+    size_t next_event_ = 0;
+    std::vector<uint8_t> trigger_fired_;
+    std::vector<SensorThreshold> pending_thresholds_;   // Of unfired triggers, for stepAdaptive()
+    bool finished_ = false;
+};
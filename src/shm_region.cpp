@@ -0,0 +1,93 @@
+//
+//
+// Santiago Quintana Moreno A01571222
+// Created on: 18/10/2026.
+#include "shm_region.h"
+#include <cerrno>
+#include <cstring>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static std::string shmError(const char* what, const char* name) {
+    return std::string(what) + " " + name + ": " + std::strerror(errno);
+}
+
+void* shmCreate(const char* name, size_t size, std::string& error) {
+    shm_unlink(name);
+    int fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd < 0) {
+        error = shmError("shm_open", name);
+        return nullptr;
+    }
+    if (ftruncate(fd, (off_t)size) != 0) {
+        error = shmError("ftruncate", name);
+        ::close(fd);
+        shm_unlink(name);
+        return nullptr;
+    }
+    void* p = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (p == MAP_FAILED) {
+        error = shmError("mmap", name);
+        shm_unlink(name);
+        return nullptr;
+    }
+    return p;
+}
+
+void* shmAttach(const char* name, size_t size, bool writable, std::string& error) {
+    int fd = shm_open(name, writable ? O_RDWR : O_RDONLY, 0);
+    if (fd < 0) {
+        error = shmError("shm_open", name);
+        return nullptr;
+    }
+
+    struct stat st{};
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < size) {
+        error = std::string(name) + ": region too small, not initialised or incompatible";
+        ::close(fd);
+        return nullptr;
+    }
+
+    void* p = mmap(nullptr, size, writable ? (PROT_READ | PROT_WRITE) : PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (p == MAP_FAILED) {
+        error = shmError("mmap", name);
+        return nullptr;
+    }
+    return p;
+}
+
+void shmUnmap(const void* p, size_t size) {
+    if (p) munmap(const_cast<void*>(p), size);
+}
+
+void shmRemove(const char* name) {
+    shm_unlink(name);
+}
+
+unsigned shmProcessId() {
+    return (unsigned)getpid();
+}
+
+#else
+
+void* shmCreate(const char* name, size_t, std::string& error) {
+    error = std::string(name) + ": shared memory export needs POSIX shared memory";
+    return nullptr;
+}
+
+void* shmAttach(const char* name, size_t, bool, std::string& error) {
+    error = std::string(name) + ": shared memory export needs POSIX shared memory";
+    return nullptr;
+}
+
+void shmUnmap(const void*, size_t) {}
+void shmRemove(const char*) {}
+unsigned shmProcessId() { return 0; }
+
+#endif
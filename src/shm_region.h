@@ -0,0 +1,23 @@
+//
+//
+// Santiago Quintana Moreno A01571222
+// Created on: 18/10/2026.
+#pragma once
+#include <cstddef>
+#include <string>
+
+// ========== POSIX Shared Memory ==========
+// Thin helpers shared by the live state export and the input injection ring. On platforms
+// without POSIX shared memory every call fails with an explanatory error.
+
+// Create a fresh zero-filled object of 'size' bytes (a stale one from a crashed run is replaced)
+void* shmCreate(const char* name, size_t size, std::string& error);
+
+// Map an existing object; fails if it is smaller than 'size'
+void* shmAttach(const char* name, size_t size, bool writable, std::string& error);
+
+void shmUnmap(const void* p, size_t size);
+void shmRemove(const char* name);
+
+// Process id stored in region headers so peers can tell a restarted writer apart
+unsigned shmProcessId();
@@ -0,0 +1,106 @@
+//
+//
+// Santiago Quintana Moreno A01571222
+// Created on: 18/10/2026.
+#include "sim_script.h"
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+ScriptScheduler::~ScriptScheduler() {
+    for (auto& w : timed_) w.handle.destroy();
+    for (auto& w : conditions_) w.handle.destroy();
+}
+
+void ScriptScheduler::spawn(ScriptTask task) {
+    auto h = std::exchange(task.handle_, {});
+    if (h) resume(h);
+}
+
+void ScriptScheduler::resume(std::coroutine_handle<> h) {
+    h.resume();
+    // A script that ran to completion is not in any wait list any more
+    if (h.done()) h.destroy();
+}
+
+void ScriptScheduler::waitUntilTime(double wake_time, std::coroutine_handle<> h) {
+    timed_.push_back(TimedWait{ wake_time, next_order_++, h });
+    std::push_heap(timed_.begin(), timed_.end(), laterWake);
+}
+
+void ScriptScheduler::waitFor(const ScriptCondition& cond, std::coroutine_handle<> h) {
+    ConditionWait w;
+    w.cond = cond;
+    w.handle = h;
+    conditions_.push_back(w);
+}
+
+void ScriptScheduler::waitFor(bool (*pred)(void*), void* ctx, std::coroutine_handle<> h) {
+    ConditionWait w;
+    w.pred = pred;
+    w.pred_ctx = ctx;
+    w.handle = h;
+    conditions_.push_back(w);
+}
+
+void ScriptScheduler::tick() {
+    // Collect everything that is due first: resumed scripts may add new waits to both lists
+    ready_.clear();
+
+    double t = now();
+    while (!timed_.empty() && timed_.front().wake_time <= t) {
+        std::pop_heap(timed_.begin(), timed_.end(), laterWake);
+        ready_.push_back(timed_.back().handle);
+        timed_.pop_back();
+    }
+
+    size_t kept = 0;
+    for (size_t i = 0; i < conditions_.size(); ++i) {
+        const ConditionWait& w = conditions_[i];
+        bool hit = w.pred ? w.pred(w.pred_ctx) : holds(w.cond);
+        if (hit) {
+            ready_.push_back(w.handle);
+        } else {
+            conditions_[kept++] = w;
+        }
+    }
+    conditions_.resize(kept);
+
+    for (size_t i = 0; i < ready_.size(); ++i) resume(ready_[i]);
+}
+
+std::vector<ScriptBatchResult> runScriptBatch(int count, ScriptFactory factory, const ScriptBatchConfig& config) {
+    std::vector<ScriptBatchResult> results(std::max(count, 0));
+    if (results.empty()) return results;
+
+    int threads = config.threads > 0 ? config.threads : (int)std::thread::hardware_concurrency();
+    threads = std::max(1, std::min(threads, count));
+
+    std::atomic<int> next{0};
+    auto worker = [&]() {
+        for (int i = next.fetch_add(1); i < count; i = next.fetch_add(1)) {
+            SimState sim;
+            if (!initSimulation(sim, config.start, config.model, results[i].error)) continue;
+            results[i].started = true;
+
+            ScriptScheduler sched(sim);
+            sched.spawn(factory(sched, i));
+
+            while (sched.pending() > 0 && sim.time_sec < config.duration_sec) {
+                sched.tick();
+                stepSimulation(sim, config.dt_sec);
+            }
+
+            results[i].final_sensors = sim.sensors;
+            results[i].end_time_sec = sim.time_sec;
+            results[i].script_finished = sched.pending() == 0;
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (int i = 1; i < threads; ++i) pool.emplace_back(worker);
+    worker();
+    for (auto& th : pool) th.join();
+
+    return results;
+}
@@ -0,0 +1,200 @@
+//
+//
+// Santiago Quintana Moreno A01571222
+// Created on: 18/10/2026.
+#pragma once
+#include "scenario.h"
+#include "sim_state.h"
+#include <coroutine>
+#include <cstdint>
+#include <exception>
+#include <string>
+#include <utility>
+#include <vector>
+
+// ========== Coroutine Scenario Scripts ==========
+// Training scripts written as straight-line C++20 coroutines over simulated time:
+//
+//   ScriptTask engineFailure(ScriptScheduler& sim) {
+//       co_await sim.until(sim.altitude < 2000);
+//       sim.state().engines.engine2_running = false;
+//       co_await sim.seconds(5);
+//       sim.state().weather.windshear_intensity = 0.8f;
+//   }
+//
+// A suspended script lives in exactly one wait list of its scheduler: a min-heap on wake time
+// for seconds(), or the condition list for until(). Per step, the scheduler compares the heap
+// top and evaluates each pending condition once; nothing else runs for sleeping scripts.
+
+class ScriptScheduler;
+
+// Coroutine return type. Scripts start suspended and run once handed to ScriptScheduler::spawn().
+class ScriptTask {
+public:
+    struct promise_type {
+        ScriptTask get_return_object() { return ScriptTask(std::coroutine_handle<promise_type>::from_promise(*this)); }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+
+    ScriptTask(ScriptTask&& o) noexcept : handle_(std::exchange(o.handle_, {})) {}
+    ScriptTask& operator=(ScriptTask&& o) noexcept {
+        if (this != &o) {
+            if (handle_) handle_.destroy();
+            handle_ = std::exchange(o.handle_, {});
+        }
+        return *this;
+    }
+    ScriptTask(const ScriptTask&) = delete;
+    ScriptTask& operator=(const ScriptTask&) = delete;
+    ~ScriptTask() { if (handle_) handle_.destroy(); }
+
+private:
+    friend class ScriptScheduler;
+    explicit ScriptTask(std::coroutine_handle<promise_type> h) : handle_(h) {}
+    std::coroutine_handle<promise_type> handle_;
+};
+
+// Compact sensor condition: one float compare per step while waiting
+struct ScriptCondition {
+    ScenarioVar var = ScenarioVar::ALTITUDE_FT;
+    ScenarioCompare compare = ScenarioCompare::LESS;
+    float threshold = 0.0f;
+};
+
+struct ScriptVar {
+    ScenarioVar var;
+
+    constexpr ScriptCondition operator<(float v) const  { return { var, ScenarioCompare::LESS, v }; }
+    constexpr ScriptCondition operator<=(float v) const { return { var, ScenarioCompare::LESS_EQUAL, v }; }
+    constexpr ScriptCondition operator>(float v) const  { return { var, ScenarioCompare::GREATER, v }; }
+    constexpr ScriptCondition operator>=(float v) const { return { var, ScenarioCompare::GREATER_EQUAL, v }; }
+};
+
+class ScriptScheduler {
+public:
+    // Sensor variables for until(): co_await sim.until(sim.ias < 200)
+    static constexpr ScriptVar altitude{ ScenarioVar::ALTITUDE_FT };
+    static constexpr ScriptVar ias{ ScenarioVar::IAS_KNOTS };
+    static constexpr ScriptVar aoa{ ScenarioVar::AOA_DEG };
+    static constexpr ScriptVar vs{ ScenarioVar::VS_FPM };
+    static constexpr ScriptVar pitch{ ScenarioVar::PITCH_DEG };
+    static constexpr ScriptVar roll{ ScenarioVar::ROLL_DEG };
+    static constexpr ScriptVar heading{ ScenarioVar::HEADING_DEG };
+    static constexpr ScriptVar mach{ ScenarioVar::MACH };
+
+    explicit ScriptScheduler(SimState& sim) : sim_(sim) {}
+    ~ScriptScheduler();
+
+    ScriptScheduler(const ScriptScheduler&) = delete;
+    ScriptScheduler& operator=(const ScriptScheduler&) = delete;
+
+    SimState& state() { return sim_; }
+    double now() const { return sim_.time_sec; }
+
+    // Takes ownership of the script and runs it up to its first co_await
+    void spawn(ScriptTask task);
+
+    // Resumes every script whose wait is over. Call once per step, before stepSimulation().
+    void tick();
+
+    // Scripts still waiting (finished scripts are destroyed immediately)
+    size_t pending() const { return timed_.size() + conditions_.size(); }
+
+    // ---------- Awaitables ----------
+    struct SecondsAwaiter {
+        ScriptScheduler* sched;
+        double wake_time;
+        bool await_ready() const noexcept { return wake_time <= sched->now(); }
+        void await_suspend(std::coroutine_handle<> h) { sched->waitUntilTime(wake_time, h); }
+        void await_resume() const noexcept {}
+    };
+
+    struct ConditionAwaiter {
+        ScriptScheduler* sched;
+        ScriptCondition cond;
+        bool await_ready() const noexcept { return sched->holds(cond); }
+        void await_suspend(std::coroutine_handle<> h) { sched->waitFor(cond, h); }
+        void await_resume() const noexcept {}
+    };
+
+    // Arbitrary predicate, for conditions that are not a single sensor compare.
+    // The predicate lives in the suspended coroutine frame; no allocation per wait.
+    template <typename Pred>
+    struct PredicateAwaiter {
+        ScriptScheduler* sched;
+        Pred pred;
+        bool await_ready() { return pred(); }
+        void await_suspend(std::coroutine_handle<> h) {
+            sched->waitFor(&PredicateAwaiter::thunk, this, h);
+        }
+        void await_resume() const noexcept {}
+        static bool thunk(void* self) { return static_cast<PredicateAwaiter*>(self)->pred(); }
+    };
+
+    SecondsAwaiter seconds(double sec) { return { this, now() + sec }; }
+    ConditionAwaiter until(ScriptCondition cond) { return { this, cond }; }
+
+    template <typename Pred>
+    PredicateAwaiter<Pred> until(Pred pred) { return { this, std::move(pred) }; }
+
+private:
+    struct TimedWait {
+        double wake_time;
+        uint64_t order;                  // FIFO among equal wake times
+        std::coroutine_handle<> handle;
+    };
+
+    struct ConditionWait {
+        ScriptCondition cond;
+        bool (*pred)(void*) = nullptr;   // Set for PredicateAwaiter waits, 'cond' unused then
+        void* pred_ctx = nullptr;
+        std::coroutine_handle<> handle;
+    };
+
+    // std heap functions build a max-heap, so "later" puts the earliest wake time on top
+    static bool laterWake(const TimedWait& a, const TimedWait& b) {
+        return a.wake_time > b.wake_time || (a.wake_time == b.wake_time && a.order > b.order);
+    }
+
+    bool holds(const ScriptCondition& cond) const {
+        return scenarioCompare(scenarioVarValue(sim_.sensors, cond.var), cond.compare, cond.threshold);
+    }
+
+    void waitUntilTime(double wake_time, std::coroutine_handle<> h);
+    void waitFor(const ScriptCondition& cond, std::coroutine_handle<> h);
+    void waitFor(bool (*pred)(void*), void* ctx, std::coroutine_handle<> h);
+    void resume(std::coroutine_handle<> h);
+
+    SimState& sim_;
+    std::vector<TimedWait> timed_;            // Min-heap on (wake_time, order)
+    std::vector<ConditionWait> conditions_;
+    std::vector<std::coroutine_handle<>> ready_;  // Scratch list for tick()
+    uint64_t next_order_ = 0;
+};
+
+// ========== Batch Mode ==========
+// Runs 'count' independent aircraft, each with its own scheduler and the script built by
+// 'factory(sched, index)', spread over worker threads. An aircraft stops when its script
+// finishes or after duration_sec. One whose start preset cannot be trimmed is not flown.
+struct ScriptBatchConfig {
+    StartupScenario start = StartupScenario::CRUISE_10000FT;
+    FlightModel model{};             // Aero database / 6-DOF, shared read-only by every aircraft
+    float dt_sec = 0.01f;
+    float duration_sec = 120.0f;
+    int threads = 0;                 // 0 = one per hardware thread
+};
+
+struct ScriptBatchResult {
+    Sensors final_sensors{};
+    double end_time_sec = 0.0;
+    bool started = false;            // False if the start could not be trimmed, see 'error'
+    bool script_finished = false;
+    std::string error;
+};
+
+using ScriptFactory = ScriptTask (*)(ScriptScheduler& sched, int index);
+
+std::vector<ScriptBatchResult> runScriptBatch(int count, ScriptFactory factory, const ScriptBatchConfig& config);
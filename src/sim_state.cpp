@@ -0,0 +1,187 @@
+//
+//
+// Santiago Quintana Moreno A01571222
+// Created on: 18/10/2026.
+#include "sim_state.h"
+#include "trim_solver.h"
+#include "live_state.h"
+#include "input_ring.h"
+#include "telemetry.h"
+#include <algorithm>
+
+void resetSimulation(SimState& sim, StartupScenario scenario, const FlightModel& model) {
+    sim = SimState{};
+    sim.prim.setFlightModel(model);
+    applyStartupScenario(scenario, sim.sensors, sim.pilot, sim.autopilot, sim.gear, sim.engines);
+}
+
+bool initSimulation(SimState& sim, StartupScenario scenario, const FlightModel& model, std::string& error) {
+    resetSimulation(sim, scenario, model);
+
+    // In-flight scenarios start in equilibrium instead of on the preset thrust guess
+    if (scenario != StartupScenario::GROUND_PARKED) {
+        TrimCondition cond;
+        cond.altitude_ft = sim.sensors.altitude_ft;
+        cond.ias_knots = sim.sensors.ias_knots;
+        cond.flaps = sim.flaps;
+        cond.gear = sim.gear.position;
+        return trimSimulation(sim, cond, error);
+    }
+    return true;
+}
+
+bool initSimulation(SimState& sim, StartupScenario scenario, const FlightModel& model) {
+    std::string error;
+    return initSimulation(sim, scenario, model, error);
+}
+
+void stepSimulation(SimState& sim, float dt_sec) {
+    // Detect flight phase
+    sim.flight_phase = sim.prim.detectFlightPhase(sim.sensors, sim.gear, sim.engines);
+
+    sim.prim.update(sim.pilot, sim.sensors, sim.faults, dt_sec, sim.alerts, sim.autopilot, sim.trim, sim.gear,
+                    sim.hydraulics, sim.engines, sim.apu);
+
+    // Update flight dynamics unless in manual override mode (for QF72-style scenarios)
+    if (!sim.settings.manual_sensor_override) {
+        sim.prim.updateFlightDynamics(sim.sensors, sim.pilot, sim.flaps, dt_sec, sim.autopilot, sim.speedbrakes,
+                                      sim.gear, sim.weather, sim.engines, sim.trim);
+    }
+
+    // Update GPWS callouts
+    sim.prim.updateGPWS(sim.sensors, sim.gear, sim.weather, sim.timers);
+
+    sim.time_sec += dt_sec;
+    sim.timers.advance(sim.time_sec);
+}
+
+void copySimState(SimState& dst, const SimState& src) {
+    dst.pilot = src.pilot;
+    dst.sensors = src.sensors;
+    dst.faults = src.faults;
+    dst.alerts = src.alerts;
+    dst.prim = src.prim;
+    dst.settings = src.settings;
+    dst.flaps = src.flaps;
+    dst.autopilot = src.autopilot;
+    dst.trim = src.trim;
+    dst.speedbrakes = src.speedbrakes;
+    dst.gear = src.gear;
+    dst.flight_phase = src.flight_phase;
+    dst.hydraulics = src.hydraulics;
+    dst.engines = src.engines;
+    dst.apu = src.apu;
+    dst.weather = src.weather;
+    dst.timers.copyFrom(src.timers);
+    dst.injected = src.injected;
+    dst.time_sec = src.time_sec;
+}
+
+static void completeGearTransit(void* ctx) {
+    LandingGear& gear = *static_cast<LandingGear*>(ctx);
+    gear.position = gear.target_position;
+    gear.transit_timer = TimerHandle{};
+}
+
+bool commandGear(LandingGear& gear, GearPosition target, TimerWheel& timers) {
+    bool can_move = (target == GearPosition::DOWN) ? (gear.position != GearPosition::DOWN)
+                                                   : (gear.position != GearPosition::UP && !gear.weight_on_wheels);
+    if (!can_move) return false;
+
+    // Reversing mid-transit restarts the full cycle
+    gear.target_position = target;
+    gear.position = GearPosition::TRANSIT;
+    timers.reschedule(gear.transit_timer, timers.now() + GEAR_TRANSIT_SEC, completeGearTransit, &gear);
+    return true;
+}
+
+void captureLiveState(const SimState& sim, LiveStateFrame& out) {
+    out.time_sec = sim.time_sec;
+    out.sensors = sim.sensors;
+    out.surfaces = sim.prim.surfaces();
+    out.fctl = sim.prim.fctl_status();
+    out.engine = sim.prim.engine_data();
+    out.autopilot = sim.autopilot;
+
+    out.alerts_shown = 0;
+    out.alerts_warning = 0;
+    out.alerts_caution = 0;
+    const auto& alerts = sim.alerts.all();
+    size_t n = std::min(alerts.size(), (size_t)64);
+    for (size_t i = 0; i < n; ++i) {
+        const Alert& a = alerts[i];
+        if (!a.active && !a.latched) continue;
+        uint64_t bit = uint64_t(1) << i;
+        out.alerts_shown |= bit;
+        if (a.level == AlertLevel::WARNING) out.alerts_warning |= bit;
+        if (a.level == AlertLevel::CAUTION) out.alerts_caution |= bit;
+    }
+    out.master_warning = sim.alerts.masterWarningOn();
+    out.master_caution = sim.alerts.masterCautionOn();
+
+    out.input_seq = sim.injected.last_seq;
+    out.input_sent_ns = sim.injected.last_sent_ns;
+    out.input_applied_ns = sim.injected.last_applied_ns;
+}
+
+void publishLiveState(const SimState& sim, LiveStateWriter& shm, TelemetryStreamer& udp) {
+    if (!shm.isOpen() && !udp.isRunning()) return;
+    LiveStateFrame frame;
+    captureLiveState(sim, frame);
+    frame.published_ns = monotonicNanos();
+    shm.publish(frame);
+    udp.publish(frame);
+}
+
+void applyInputCommand(SimState& sim, const InputCommand& cmd) {
+    const float v = cmd.values[0];
+    switch (cmd.type) {
+        case InputCommandType::PILOT:
+            sim.pilot.pitch = std::clamp(cmd.values[0], -1.0f, 1.0f);
+            sim.pilot.roll = std::clamp(cmd.values[1], -1.0f, 1.0f);
+            sim.pilot.thrust = std::clamp(cmd.values[2], 0.0f, 1.0f);
+            break;
+
+        case InputCommandType::FCU:
+            switch ((FcuField)cmd.index) {
+                case FcuField::SPEED_KNOTS: sim.autopilot.target_spd_knots = v; break;
+                case FcuField::HEADING_DEG: sim.autopilot.target_hdg_deg = v; break;
+                case FcuField::ALTITUDE_FT: sim.autopilot.target_alt_ft = v; break;
+                case FcuField::VS_FPM:      sim.autopilot.target_vs_fpm = v; break;
+                case FcuField::SPD_MODE:    sim.autopilot.spd_mode = v != 0.0f; break;
+                case FcuField::HDG_MODE:    sim.autopilot.hdg_mode = v != 0.0f; break;
+                case FcuField::ALT_MODE:    sim.autopilot.alt_mode = v != 0.0f; break;
+                case FcuField::VS_MODE:     sim.autopilot.vs_mode = v != 0.0f; break;
+                case FcuField::AUTOTHRUST:  sim.autopilot.autothrust = v != 0.0f; break;
+            }
+            break;
+
+        case InputCommandType::FAULT:
+            if (cmd.index < (uint16_t)FaultId::COUNT) {
+                FaultSet set = sim.faults.bits();
+                set.set((FaultId)cmd.index, v != 0.0f);
+                sim.faults.setBits(set);
+            }
+            break;
+    }
+}
+
+size_t drainInputCommands(InputRingConsumer& ring, SimState& sim) {
+    if (!ring.isOpen()) return 0;
+
+    // Everything queued, capped at one ring's worth so a flooding producer cannot stall the step
+    InputCommand batch[64];
+    size_t total = 0;
+    size_t n;
+    while (total < INPUT_RING_CAPACITY && (n = ring.drain(batch, 64)) > 0) {
+        uint64_t now_ns = monotonicNanos();
+        for (size_t i = 0; i < n; ++i) applyInputCommand(sim, batch[i]);
+
+        sim.injected.last_seq = batch[n - 1].seq;
+        sim.injected.last_sent_ns = batch[n - 1].sent_ns;
+        sim.injected.last_applied_ns = now_ns;
+        sim.injected.applied += n;
+        total += n;
+    }
+    return total;
+}
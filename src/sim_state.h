@@ -0,0 +1,87 @@
+//
+//
+// Santiago Quintana Moreno A01571222
+// Created on: 18/10/2026.
+#pragma once
+#include "sim_types.h"
+#include "alerts.h"
+#include "prim_core.h"
+#include <string>
+
+struct LiveStateFrame;
+class LiveStateWriter;
+class TelemetryStreamer;
+class InputRingConsumer;
+struct InputCommand;
+
+// Last command applied from the input injection ring, echoed through the live state export
+// so an external producer can measure its latency
+struct InjectedInputStatus {
+    uint64_t last_seq = 0;
+    uint64_t last_sent_ns = 0;       // Producer timestamp (monotonicNanos)
+    uint64_t last_applied_ns = 0;    // When the sim drained it
+    uint64_t applied = 0;            // Commands applied since start
+};
+
+// Complete simulation state for one aircraft. The GUI and the headless tools both
+// advance it through stepSimulation() so they run exactly the same model.
+// copySimState() lists every member; keep it in step when adding one.
+struct SimState {
+    PilotInput pilot{};
+    Sensors sensors{};
+    Faults faults{};
+    AlertManager alerts{};
+    PrimCore prim{};
+    SimulationSettings settings{};
+    FlapsPosition flaps = FlapsPosition::RETRACTED;
+    AutopilotState autopilot{};
+    TrimSystem trim{};
+    Speedbrakes speedbrakes{};
+    LandingGear gear{};
+    FlightPhase flight_phase = FlightPhase::PREFLIGHT;
+    HydraulicSystem hydraulics{};
+    EngineState engines{};
+    APUState apu{};
+    Weather weather{};
+    TimerWheel timers{};    // Timed events (gear transit, callout expiry), advanced with time_sec
+    InjectedInputStatus injected{};
+
+    double time_sec = 0.0;  // Simulated time since the scenario started
+};
+
+// Reset the state and apply a startup preset on its thrust guess, without trimming it: the
+// starting point for a trimSimulation() to some other condition.
+void resetSimulation(SimState& sim, StartupScenario scenario, const FlightModel& model = {});
+
+// Reset the state and apply one of the startup scenarios. The flight dynamics run (and are
+// trimmed with) 'model'; the default is the built-in point-mass model. Returns false, with the
+// reason in 'error', if an in-flight preset cannot be trimmed; the aircraft is then left on the
+// preset's thrust guess.
+bool initSimulation(SimState& sim, StartupScenario scenario, const FlightModel& model, std::string& error);
+bool initSimulation(SimState& sim, StartupScenario scenario, const FlightModel& model = {});
+
+// Advance the whole aircraft by one step: phase detection, PRIM, flight dynamics, GPWS, timers.
+// Everything runs at dt_sec; RateExecutive runs the same pieces at separate rates.
+void stepSimulation(SimState& sim, float dt_sec);
+
+// Member-wise copy for rolling a step back (adaptive_step.h). Pending timers come along
+// and fire into 'dst' (see TimerWheel), so the copy can be stepped on its own.
+void copySimState(SimState& dst, const SimState& src);
+
+// Command the landing gear: it goes to TRANSIT and reaches 'target' GEAR_TRANSIT_SEC later.
+// Same rules as the GEAR lever: no retraction with weight on wheels. Returns false if refused.
+bool commandGear(LandingGear& gear, GearPosition target, TimerWheel& timers);
+
+// Snapshot the exported subset of the state (see live_state.h)
+void captureLiveState(const SimState& sim, LiveStateFrame& out);
+
+// Capture once and hand the frame to the shared-memory export and the UDP streamer.
+// Either sink may be closed; nothing is captured when both are.
+void publishLiveState(const SimState& sim, LiveStateWriter& shm, TelemetryStreamer& udp);
+
+// Apply one externally injected command (pilot input, FCU target or fault toggle)
+void applyInputCommand(SimState& sim, const InputCommand& cmd);
+
+// Drain the injection ring once, applying commands in order; call before each step.
+// No-op when the ring is not open. Returns the number of commands applied.
+size_t drainInputCommands(InputRingConsumer& ring, SimState& sim);
@@ -3,7 +3,12 @@
 // Santiago Quintana Moreno A01571222
 // Created on: 24/12/2025.
 #pragma once
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <functional>
 #include <string>
+#include "timer_wheel.h"
 
 struct Sensors {
     float ias_knots = 250.0f;
@@ -94,9 +99,11 @@ struct LandingGear {
     GearPosition position = GearPosition::DOWN;
     GearPosition target_position = GearPosition::DOWN;  // Where gear is commanded to go
     bool weight_on_wheels = false;
-    float transit_timer = 0.0f;  // Animation timer
+    TimerHandle transit_timer{};  // Pending transit completion in the sim timer wheel
 };
 
+constexpr float GEAR_TRANSIT_SEC = 10.0f;  // Time to extend/retract
+
 enum class FlightPhase {
     PREFLIGHT,   // On ground, engines off
     TAXI,        // On ground, engines running
@@ -137,6 +144,129 @@ struct Weather {
     float windshear_intensity = 0.0f;   // 0.0 = none, 1.0 = severe
 };
 
+// Every Faults field, in declaration order. Used to generate FaultId and the packed
+// FaultSet conversions; the static_assert after struct Faults catches a missing entry.
+#define PRIM_FAULT_LIST(X) \
+    X(adr1_fail) \
+    X(elac1_fail) \
+    X(elac2_fail) \
+    X(sec1_fail) \
+    X(elevator_jam) \
+    X(aileron_jam) \
+    X(overspeed_sensor_bad) \
+    X(alpha_floor_fail) \
+    X(trim_runaway) \
+    X(green_hyd_fail) \
+    X(blue_hyd_fail) \
+    X(yellow_hyd_fail) \
+    X(total_electrical_fail) \
+    X(partial_electrical_fail) \
+    X(pitot_blocked) \
+    X(eng1_n1_sensor_fail) \
+    X(eng1_n2_sensor_fail) \
+    X(eng1_egt_sensor_fail) \
+    X(eng2_n1_sensor_fail) \
+    X(eng2_n2_sensor_fail) \
+    X(eng2_egt_sensor_fail) \
+    X(eng1_vibration_high) \
+    X(eng2_vibration_high) \
+    X(eng1_oil_pressure_low) \
+    X(eng2_oil_pressure_low) \
+    X(eng1_compressor_stall) \
+    X(eng2_compressor_stall) \
+    X(gen1_fail) \
+    X(gen2_fail) \
+    X(apu_gen_fail) \
+    X(bat1_fail) \
+    X(bat2_fail) \
+    X(ac_bus1_fail) \
+    X(ac_bus2_fail) \
+    X(rat_deployed) \
+    X(rat_fault) \
+    X(green_eng1_pump_fail) \
+    X(blue_elec_pump_fail) \
+    X(yellow_eng1_pump_fail) \
+    X(green_reservoir_low) \
+    X(blue_reservoir_low) \
+    X(yellow_reservoir_low) \
+    X(elevator_left_actuator_fail) \
+    X(elevator_right_actuator_fail) \
+    X(aileron_left_actuator_fail) \
+    X(aileron_right_actuator_fail)
+
+enum class FaultId : uint8_t {
+#define PRIM_FAULT_ENUM(name) name,
+    PRIM_FAULT_LIST(PRIM_FAULT_ENUM)
+#undef PRIM_FAULT_ENUM
+    COUNT
+};
+
+inline const char* faultName(FaultId id) {
+    static const char* const names[] = {
+#define PRIM_FAULT_NAME(name) #name,
+        PRIM_FAULT_LIST(PRIM_FAULT_NAME)
+#undef PRIM_FAULT_NAME
+    };
+    return (id < FaultId::COUNT) ? names[(int)id] : "unknown";
+}
+
+inline bool faultFromName(const char* name, FaultId& out) {
+    for (int i = 0; i < (int)FaultId::COUNT; ++i) {
+        if (std::strcmp(faultName((FaultId)i), name) == 0) {
+            out = (FaultId)i;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Packed fault configuration: one bit per FaultId. Cheap to copy, compare and hash,
+// so it can be used directly as a key for lookup tables and result caches.
+struct FaultSet {
+    uint64_t bits = 0;
+
+    bool test(FaultId id) const { return (bits >> (int)id) & 1u; }
+    void set(FaultId id, bool on = true) {
+        uint64_t mask = uint64_t(1) << (int)id;
+        bits = on ? (bits | mask) : (bits & ~mask);
+    }
+    void reset(FaultId id) { set(id, false); }
+
+    int count() const { return std::popcount(bits); }
+    bool any() const { return bits != 0; }
+    bool none() const { return bits == 0; }
+
+    // Faults that differ between the two sets (toggled on or off)
+    FaultSet diff(const FaultSet& other) const { return FaultSet{ bits ^ other.bits }; }
+    // Faults present here but not in 'other'
+    FaultSet minus(const FaultSet& other) const { return FaultSet{ bits & ~other.bits }; }
+
+    uint64_t hash() const {
+        // splitmix64 finalizer - spreads neighbouring configurations across buckets
+        uint64_t x = bits + 0x9E3779B97F4A7C15ull;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+        return x ^ (x >> 31);
+    }
+
+    // Calls fn(FaultId) for every active fault, lowest id first
+    template <typename Fn>
+    void forEach(Fn&& fn) const {
+        uint64_t rest = bits;
+        while (rest) {
+            fn((FaultId)std::countr_zero(rest));
+            rest &= rest - 1;
+        }
+    }
+
+    FaultSet operator|(const FaultSet& o) const { return FaultSet{ bits | o.bits }; }
+    FaultSet operator&(const FaultSet& o) const { return FaultSet{ bits & o.bits }; }
+    FaultSet operator^(const FaultSet& o) const { return FaultSet{ bits ^ o.bits }; }
+    bool operator==(const FaultSet& o) const = default;
+};
+
+static_assert((int)FaultId::COUNT <= 64, "FaultSet packs faults into a single 64-bit word");
+
 struct Faults {
     bool adr1_fail = false;
     bool elac1_fail = false;
@@ -208,6 +338,46 @@ struct Faults {
     bool elevator_right_actuator_fail = false;
     bool aileron_left_actuator_fail = false;
     bool aileron_right_actuator_fail = false;
+
+    // Packed view of the fields above (field-style access stays the primary API)
+    FaultSet bits() const {
+        FaultSet out;
+#define PRIM_FAULT_PACK(name) out.bits |= uint64_t(name) << (int)FaultId::name;
+        PRIM_FAULT_LIST(PRIM_FAULT_PACK)
+#undef PRIM_FAULT_PACK
+        return out;
+    }
+
+    void setBits(FaultSet set) {
+#define PRIM_FAULT_UNPACK(name) name = set.test(FaultId::name);
+        PRIM_FAULT_LIST(PRIM_FAULT_UNPACK)
+#undef PRIM_FAULT_UNPACK
+    }
+
+    // Single-field access by id, without packing the whole struct
+    bool get(FaultId id) const {
+        static constexpr bool Faults::* const fields[] = {
+#define PRIM_FAULT_MEMBER(name) &Faults::name,
+            PRIM_FAULT_LIST(PRIM_FAULT_MEMBER)
+#undef PRIM_FAULT_MEMBER
+        };
+        return this->*fields[(int)id];
+    }
+
+    static Faults fromBits(FaultSet set) {
+        Faults f;
+        f.setBits(set);
+        return f;
+    }
+
+    bool operator==(const Faults& o) const = default;
+};
+
+static_assert(sizeof(Faults) == (size_t)FaultId::COUNT, "PRIM_FAULT_LIST is out of sync with struct Faults");
+
+template <>
+struct std::hash<FaultSet> {
+    size_t operator()(const FaultSet& set) const noexcept { return (size_t)set.hash(); }
 };
 
 struct SimulationSettings {
@@ -252,7 +422,7 @@ struct AutopilotState {
 // GPWS (Ground Proximity Warning System) callouts
 struct GPWSCallouts {
     std::string current_callout = "";  // Current active callout
-    float callout_timer = 0.0f;        // Time since callout started
+    TimerHandle callout_timer{};       // Clears current_callout when it expires
     bool pull_up_active = false;       // PULL UP warning
     bool windshear_active = false;     // WINDSHEAR warning
     bool retard_active = false;        // RETARD callout (below 20ft)
@@ -311,7 +481,7 @@ inline void applyStartupScenario(StartupScenario scenario, Sensors& sensors, Pil
             sensors.altitude_ft = 10000.0f;
             sensors.vs_fpm = 0.0f;
             sensors.mach = 0.45f;
-            sensors.tat_c = -10.0f;
+            sensors.tat_c = 6.0f;  // ISA -5 C plus ram rise
             sensors.pitch_deg = 0.0f;
             sensors.roll_deg = 0.0f;
             sensors.heading_deg = 0.0f;
@@ -327,21 +497,21 @@ inline void applyStartupScenario(StartupScenario scenario, Sensors& sensors, Pil
             break;
 
         case StartupScenario::CRUISE_37000FT:
-            sensors.ias_knots = 280.0f;  // Lower IAS at high altitude
+            sensors.ias_knots = 252.0f;  // Mach 0.78 at FL370 (ISA)
             sensors.aoa_deg = 2.0f;
             sensors.nz = 1.0f;
             sensors.altitude_ft = 37000.0f;
             sensors.vs_fpm = 0.0f;
             sensors.mach = 0.78f;  // Typical cruise Mach
-            sensors.tat_c = -54.0f;  // ISA at FL370
+            sensors.tat_c = -30.0f;  // ISA -56.5 C plus ram rise at M 0.78
             sensors.pitch_deg = 0.0f;  // Level flight
             sensors.roll_deg = 0.0f;
             sensors.heading_deg = 0.0f;
             pilot.pitch = 0.0f;
             pilot.roll = 0.0f;
-            pilot.thrust = 0.75f;  // Balanced thrust for 280kt cruise
+            pilot.thrust = 0.61f;  // Balanced thrust for 252kt cruise
             autopilot.target_alt_ft = 37000.0f;
-            autopilot.target_spd_knots = 280.0f;
+            autopilot.target_spd_knots = 252.0f;
             gear.position = GearPosition::UP;
             gear.weight_on_wheels = false;
             engines.engine1_running = true;
@@ -0,0 +1,148 @@
+//
+//
+// Santiago Quintana Moreno A01571222
+// Created on: 18/10/2026.
+#include "static_layer.h"
+#include <SDL2/SDL.h>
+#include <cmath>
+#include <cstdint>
+
+static SDL_Renderer* s_renderer = nullptr;
+static bool s_targets_supported = false;
+static uint32_t s_generation = 1;
+
+// Every layer that ever got a texture, for invalidation and teardown. Layers are static panel
+// objects, so a small fixed table is enough and nothing here needs destroying at exit.
+static constexpr int MAX_LAYERS = 16;
+static StaticLayer* s_layers[MAX_LAYERS];
+static int s_layer_count = 0;
+
+void SetStaticLayerRenderer(SDL_Renderer* renderer) {
+    ReleaseStaticLayers();
+    s_renderer = renderer;
+    s_targets_supported = renderer && SDL_RenderTargetSupported(renderer);
+}
+
+void InvalidateStaticLayers() {
+    ++s_generation;
+}
+
+void ReleaseStaticLayers() {
+    for (int i = 0; i < s_layer_count; ++i) s_layers[i]->release();
+}
+
+static void disableCaching(const char* what) {
+    SDL_Log("Static layers disabled, %s failed: %s", what, SDL_GetError());
+    s_targets_supported = false;
+}
+
+ImDrawList* StaticLayer::begin(ImDrawList* dst, ImVec2 pos, ImVec2 size, uint64_t key, ImU32 background) {
+    cached_ = false;
+    painting_ = false;
+
+    // Whole-pixel origin so the blit lands on the same pixels the geometry was painted for
+    origin_ = ImVec2(std::floor(pos.x), std::floor(pos.y));
+    int width = (int)std::ceil(pos.x + size.x - origin_.x);
+    int height = (int)std::ceil(pos.y + size.y - origin_.y);
+
+    if (!registered_ && s_layer_count < MAX_LAYERS) {
+        s_layers[s_layer_count++] = this;
+        registered_ = true;
+    }
+
+    if (!s_targets_supported || !registered_ || width <= 0 || height <= 0) {
+        dst->AddRectFilled(pos, ImVec2(pos.x + size.x, pos.y + size.y), background);
+        return dst;
+    }
+
+    cached_ = true;
+    if (texture_ && width == width_ && height == height_ && key == key_ && generation_ == s_generation) {
+        return nullptr;
+    }
+
+    if (!texture_ || width != width_ || height != height_) {
+        if (texture_) SDL_DestroyTexture(texture_);
+        texture_ = SDL_CreateTexture(s_renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET, width, height);
+        if (!texture_) {
+            disableCaching("SDL_CreateTexture");
+            cached_ = false;
+            dst->AddRectFilled(pos, ImVec2(pos.x + size.x, pos.y + size.y), background);
+            return dst;
+        }
+        SDL_SetTextureBlendMode(texture_, SDL_BLENDMODE_NONE);     // Opaque layer: plain copy
+        width_ = width;
+        height_ = height;
+    }
+
+    if (!list_) list_ = IM_NEW(ImDrawList)(ImGui::GetDrawListSharedData());
+    list_->_ResetForNewFrame();
+    list_->Flags = dst->Flags;
+    list_->PushTextureID(ImGui::GetIO().Fonts->TexID);
+    list_->PushClipRect(origin_, ImVec2(origin_.x + width_, origin_.y + height_));
+
+    key_ = key;
+    generation_ = s_generation;
+    background_ = background;
+    painting_ = true;
+    return list_;
+}
+
+void StaticLayer::end(ImDrawList* dst) {
+    if (!cached_) return;      // Painted straight into dst
+
+    if (painting_) {
+        painting_ = false;
+        if (!rasterize()) {
+            disableCaching("SDL_SetRenderTarget");
+            generation_ = 0;
+            return;
+        }
+    }
+
+    dst->AddImage((ImTextureID)(intptr_t)texture_, origin_, ImVec2(origin_.x + width_, origin_.y + height_));
+}
+
+bool StaticLayer::rasterize() {
+    SDL_Texture* previous = SDL_GetRenderTarget(s_renderer);
+    if (SDL_SetRenderTarget(s_renderer, texture_) != 0) return false;
+
+    SDL_SetRenderDrawColor(s_renderer, (background_ >> IM_COL32_R_SHIFT) & 0xFF, (background_ >> IM_COL32_G_SHIFT) & 0xFF,
+                           (background_ >> IM_COL32_B_SHIFT) & 0xFF, 255);
+    SDL_RenderClear(s_renderer);
+
+    // Same replay as the SDL_Renderer backend, in layer coordinates
+    for (ImDrawVert& v : list_->VtxBuffer) {
+        v.pos.x -= origin_.x;
+        v.pos.y -= origin_.y;
+    }
+    const ImDrawVert* vtx = list_->VtxBuffer.Data;
+    const ImDrawIdx* idx = list_->IdxBuffer.Data;
+    for (const ImDrawCmd& cmd : list_->CmdBuffer) {
+        if (cmd.UserCallback || cmd.ElemCount == 0) continue;
+
+        SDL_Rect clip = {(int)(cmd.ClipRect.x - origin_.x), (int)(cmd.ClipRect.y - origin_.y),
+                         (int)(cmd.ClipRect.z - cmd.ClipRect.x), (int)(cmd.ClipRect.w - cmd.ClipRect.y)};
+        SDL_RenderSetClipRect(s_renderer, &clip);
+
+        const ImDrawVert* first = vtx + cmd.VtxOffset;
+        SDL_RenderGeometryRaw(s_renderer, (SDL_Texture*)(intptr_t)cmd.GetTexID(),
+                              &first->pos.x, (int)sizeof(ImDrawVert),
+                              (const SDL_Color*)&first->col, (int)sizeof(ImDrawVert),
+                              &first->uv.x, (int)sizeof(ImDrawVert),
+                              list_->VtxBuffer.Size - (int)cmd.VtxOffset,
+                              idx + cmd.IdxOffset, (int)cmd.ElemCount, (int)sizeof(ImDrawIdx));
+    }
+
+    SDL_RenderSetClipRect(s_renderer, nullptr);
+    SDL_SetRenderTarget(s_renderer, previous);
+    return true;
+}
+
+void StaticLayer::release() {
+    if (texture_) SDL_DestroyTexture(texture_);
+    texture_ = nullptr;
+    if (list_) IM_DELETE(list_);
+    list_ = nullptr;
+    width_ = height_ = 0;
+    cached_ = painting_ = false;
+}
@@ -0,0 +1,76 @@
+//
+//
+// Santiago Quintana Moreno A01571222
+// Created on: 18/10/2026.
+#pragma once
+#include "imgui.h"
+#include <cstdint>
+
+struct SDL_Renderer;
+struct SDL_Texture;
+
+// ========== Static Layers ==========
+// Display backgrounds (tape boxes, scales, bezels) that only change with the panel size or
+// the configuration are painted once into an SDL render-target texture and then blitted as
+// a single quad under the moving symbology. On a software renderer this replaces hundreds
+// of rasterised triangles per frame with one copy.
+//
+// Usage, inside an ImGui window:
+//
+//   if (ImDrawList* bg = layer.begin(draw_list, pos, size, key, background)) {
+//       ...paint the static content into bg, in screen coordinates as usual...
+//   }
+//   layer.end(draw_list);
+//   ...draw the dynamic content into draw_list...
+//
+// begin() returns nullptr while the cached texture is valid. Without a renderer that supports
+// render targets it returns 'dst' every frame, so the panel still draws (uncached).
+
+class StaticLayer {
+public:
+    StaticLayer() = default;
+    StaticLayer(const StaticLayer&) = delete;
+    StaticLayer& operator=(const StaticLayer&) = delete;
+
+    // 'key' identifies the configuration painted into the layer; a different key or size
+    // repaints it. 'background' must be opaque: the texture is copied without blending.
+    ImDrawList* begin(ImDrawList* dst, ImVec2 pos, ImVec2 size, uint64_t key, ImU32 background);
+    void end(ImDrawList* dst);
+
+    // Frees the texture and the paint list (the next begin() rebuilds them)
+    void release();
+
+private:
+    bool rasterize();
+
+    ImDrawList* list_ = nullptr;        // Private list the layer is painted into
+    SDL_Texture* texture_ = nullptr;
+    int width_ = 0;
+    int height_ = 0;
+    uint64_t key_ = 0;
+    uint32_t generation_ = 0;
+    ImU32 background_ = 0;
+    ImVec2 origin_;                     // Top-left of the layer this frame (whole pixels)
+    bool cached_ = false;               // This frame goes through the texture
+    bool painting_ = false;             // begin() handed out list_ this frame
+    bool registered_ = false;
+};
+
+// Renderer used for every layer; call once after creating it (nullptr disables caching)
+void SetStaticLayerRenderer(SDL_Renderer* renderer);
+
+// Forces every layer to repaint, e.g. on SDL_RENDER_TARGETS_RESET
+void InvalidateStaticLayers();
+
+// Destroys every layer texture; call before destroying the renderer
+void ReleaseStaticLayers();
+
+// Folds one value into a layer key (FNV-1a)
+inline uint64_t layerKeyMix(uint64_t key, uint32_t value) {
+    if (key == 0) key = 14695981039346656037ull;
+    for (int i = 0; i < 4; ++i) {
+        key ^= (value >> (i * 8)) & 0xFF;
+        key *= 1099511628211ull;
+    }
+    return key;
+}
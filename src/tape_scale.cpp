@@ -0,0 +1,60 @@
+//
+//
+// Santiago Quintana Moreno A01571222
+// Created on: 18/10/2026.
+#include "tape_scale.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+int TapeScale::tickCount() const {
+    if (tick_step <= 0.0f || max_value < min_value) return 0;
+    return (int)std::floor((max_value - min_value) / tick_step + 0.5f) + 1;
+}
+
+TapeWindow visibleTicks(const TapeScale& scale, float low_value, float high_value) {
+    TapeWindow window;
+    int count = scale.tickCount();
+    if (count == 0 || high_value < low_value) return window;
+
+    // Small slack so a tick sitting exactly on the edge is not lost to rounding
+    float lo = (low_value - scale.min_value) / scale.tick_step - 1e-4f;
+    float hi = (high_value - scale.min_value) / scale.tick_step + 1e-4f;
+    window.first = std::max(0, (int)std::ceil(lo));
+    window.last = std::min(count - 1, (int)std::floor(hi));
+    return window;
+}
+
+void TapeLabels::build(const TapeScale& scale, MeasureFn measure, float font_size) {
+    int count = scale.tickCount();
+    text_.clear();
+    labels_.assign(count, Label{});
+
+    for (int i = 0; i < count; ++i) {
+        if (!scale.isMajor(i)) continue;
+        float value = scale.tickValue(i);
+        if (!scale.label_zero && std::fabs(value) < scale.tick_step * 0.5f) continue;
+
+        char buffer[32];
+        int n = std::snprintf(buffer, sizeof(buffer), scale.label_format, value / scale.label_divisor);
+        if (n <= 0) continue;
+        n = std::min(n, (int)sizeof(buffer) - 1);
+
+        Label& label = labels_[i];
+        label.offset = (uint32_t)text_.size();
+        label.length = (uint16_t)n;
+        label.width = measure ? measure(buffer) : 0.0f;
+        text_.append(buffer, n);
+    }
+
+    font_size_ = font_size;
+    built_ = true;
+}
+
+const char* TapeLabels::text(int tick, const char** end) const {
+    const Label& label = labels_[tick];
+    if (label.length == 0) return nullptr;
+    const char* begin = text_.data() + label.offset;
+    *end = begin + label.length;
+    return begin;
+}
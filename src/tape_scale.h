@@ -0,0 +1,65 @@
+//
+//
+// Santiago Quintana Moreno A01571222
+// Created on: 18/10/2026.
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// ========== Tape Scales ==========
+// A PFD tape or ladder is a run of evenly spaced ticks. Each frame works out the visible
+// tick indices directly from the current value, so drawing cost depends on the window
+// height and not on how far the scale extends. Major-tick labels are formatted and
+// measured once by TapeLabels and reused every frame.
+
+struct TapeScale {
+    float min_value = 0.0f;             // First tick; a multiple of the major spacing
+    float max_value = 0.0f;             // Last tick (inclusive)
+    float tick_step = 1.0f;             // Units between ticks
+    int major_every = 1;                // Every Nth tick is major and labelled
+    float label_divisor = 1.0f;         // Label shows value / label_divisor
+    const char* label_format = "%.0f";  // printf format applied to the label value
+    bool label_zero = true;             // Label the tick at value 0
+
+    int tickCount() const;
+    float tickValue(int index) const { return min_value + (float)index * tick_step; }
+    bool isMajor(int index) const { return index % major_every == 0; }
+};
+
+// Inclusive range of tick indices; empty when first > last
+struct TapeWindow {
+    int first = 0;
+    int last = -1;
+};
+
+// Ticks whose value lies in [low_value, high_value], clamped to the scale
+TapeWindow visibleTicks(const TapeScale& scale, float low_value, float high_value);
+
+class TapeLabels {
+public:
+    // Rendered width of a label in pixels (e.g. ImGui::CalcTextSize(text).x)
+    using MeasureFn = float (*)(const char* text);
+
+    // Formats and measures every major-tick label. 'font_size' is remembered so a font change
+    // can trigger a rebuild.
+    void build(const TapeScale& scale, MeasureFn measure, float font_size);
+    bool builtFor(float font_size) const { return built_ && font_size == font_size_; }
+
+    // Label for a tick; nullptr for minor or unlabelled ticks. The text is not null-terminated
+    // at 'end' in general, so pass both pointers to the draw call.
+    const char* text(int tick, const char** end) const;
+    float width(int tick) const { return labels_[tick].width; }
+
+private:
+    struct Label {
+        uint32_t offset = 0;
+        uint16_t length = 0;
+        float width = 0.0f;
+    };
+
+    std::string text_;                  // Every label back to back
+    std::vector<Label> labels_;         // One per tick
+    float font_size_ = 0.0f;
+    bool built_ = false;
+};
@@ -0,0 +1,152 @@
+//
+//
+// Santiago Quintana Moreno A01571222
+// Created on: 18/10/2026.
+#include "telemetry.h"
+#include "input_ring.h"
+#include <chrono>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#define PRIM_HAVE_BSD_SOCKETS 1
+#endif
+
+bool parseTelemetryTarget(const char* spec, TelemetryConfig& config, std::string& error) {
+    std::string text = spec;
+    size_t colon = text.rfind(':');
+    std::string port = (colon == std::string::npos) ? text : text.substr(colon + 1);
+    if (colon != std::string::npos && colon > 0) config.host = text.substr(0, colon);
+
+    char* end = nullptr;
+    long value = std::strtol(port.c_str(), &end, 10);
+    if (port.empty() || *end != '\0' || value <= 0 || value > 65535) {
+        error = std::string("telemetry: bad target '") + spec + "', expected host:port";
+        return false;
+    }
+    config.port = (uint16_t)value;
+    return true;
+}
+
+bool TelemetryStreamer::start(const TelemetryConfig& config, std::string& error) {
+    stop();
+#ifdef PRIM_HAVE_BSD_SOCKETS
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(config.port);
+    if (inet_pton(AF_INET, config.host.c_str(), &addr.sin_addr) != 1) {
+        error = "telemetry: bad IPv4 address '" + config.host + "'";
+        return false;
+    }
+
+    int fd = socket(AF_INET, SOCK_DGRAM, 0);
+    if (fd < 0) {
+        error = std::string("telemetry: socket: ") + std::strerror(errno);
+        return false;
+    }
+    // Connected UDP: the I/O thread just calls send()
+    if (connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+        error = std::string("telemetry: connect: ") + std::strerror(errno);
+        ::close(fd);
+        return false;
+    }
+
+    config_ = config;
+    if (config_.decimation < 1) config_.decimation = 1;
+    socket_ = fd;
+    frames_.assign(RING_FRAMES, LiveStateFrame{});
+    frame_index_.assign(RING_FRAMES, 0);
+    head_.store(0, std::memory_order_relaxed);
+    tail_.store(0, std::memory_order_relaxed);
+    published_ = 0;
+    sent_.store(0, std::memory_order_relaxed);
+    overruns_.store(0, std::memory_order_relaxed);
+    send_errors_.store(0, std::memory_order_relaxed);
+
+    running_.store(true, std::memory_order_release);
+    io_thread_ = std::thread(&TelemetryStreamer::ioLoop, this);
+    return true;
+#else
+    (void)config;
+    error = "telemetry: UDP streaming needs BSD sockets (Linux / macOS)";
+    return false;
+#endif
+}
+
+void TelemetryStreamer::stop() {
+    if (!running_.exchange(false)) return;
+    io_thread_.join();
+#ifdef PRIM_HAVE_BSD_SOCKETS
+    ::close(socket_);
+#endif
+    socket_ = -1;
+}
+
+void TelemetryStreamer::publish(const LiveStateFrame& frame) {
+    if (!running_.load(std::memory_order_relaxed)) return;
+
+    uint64_t index = published_++;
+    if (index % (uint64_t)config_.decimation != 0) return;
+
+    uint64_t head = head_.load(std::memory_order_relaxed);
+    if (head - tail_.load(std::memory_order_acquire) >= RING_FRAMES) {
+        overruns_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    std::memcpy(&frames_[head % RING_FRAMES], &frame, sizeof(LiveStateFrame));
+    frame_index_[head % RING_FRAMES] = index;
+    head_.store(head + 1, std::memory_order_release);
+}
+
+TelemetryStats TelemetryStreamer::stats() const {
+    TelemetryStats s;
+    s.sent = sent_.load(std::memory_order_relaxed);
+    s.overruns = overruns_.load(std::memory_order_relaxed);
+    s.send_errors = send_errors_.load(std::memory_order_relaxed);
+    return s;
+}
+
+void TelemetryStreamer::ioLoop() {
+#ifdef PRIM_HAVE_BSD_SOCKETS
+    alignas(8) unsigned char packet[TELEMETRY_PACKET_SIZE];
+    TelemetryHeader header{};
+    std::memcpy(header.magic, TELEMETRY_MAGIC, sizeof(TELEMETRY_MAGIC));
+    header.version = TELEMETRY_VERSION;
+    header.header_size = sizeof(TelemetryHeader);
+    header.payload_size = sizeof(LiveStateFrame);
+    header.decimation = (uint32_t)config_.decimation;
+
+    const auto idle = std::chrono::microseconds(config_.poll_us);
+
+    for (;;) {
+        // Read the flag before draining so frames queued before stop() still go out
+        bool keep_running = running_.load(std::memory_order_acquire);
+
+        uint64_t tail = tail_.load(std::memory_order_relaxed);
+        uint64_t head = head_.load(std::memory_order_acquire);
+        for (; tail != head; ++tail) {
+            // Numbered from the frame, so frames dropped on a ring overrun leave a gap too
+            header.frame_index = frame_index_[tail % RING_FRAMES];
+            header.packet_seq = header.frame_index / header.decimation;
+            header.send_ns = monotonicNanos();
+            std::memcpy(packet, &header, sizeof(TelemetryHeader));
+            std::memcpy(packet + sizeof(TelemetryHeader), &frames_[tail % RING_FRAMES], sizeof(LiveStateFrame));
+            tail_.store(tail + 1, std::memory_order_release);
+
+            if (send(socket_, packet, sizeof(packet), 0) == (ssize_t)sizeof(packet)) {
+                sent_.fetch_add(1, std::memory_order_relaxed);
+            } else {
+                send_errors_.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        if (!keep_running) break;
+        if (tail == head) std::this_thread::sleep_for(idle);
+    }
+#endif
+}
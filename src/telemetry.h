@@ -0,0 +1,125 @@
+//
+//
+// Santiago Quintana Moreno A01571222
+// Created on: 18/10/2026.
+#pragma once
+#include "live_state.h"
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+// ========== UDP Telemetry ==========
+// Optional streamer for lab dashboards: one datagram per published state frame (or every
+// Nth), sent from a dedicated I/O thread. The sim thread only copies the frame into an
+// in-process ring; the socket calls all happen on the I/O thread.
+//
+// Datagram, version 1, host byte order (little-endian on all supported targets), 232 bytes:
+//
+//   offset  size  field
+//        0     4  magic "PTLM"
+//        4     2  version (1)
+//        6     2  header size (40)
+//        8     4  payload size (sizeof(LiveStateFrame) = 192)
+//       12     4  decimation (frames per datagram)
+//       16     8  packet sequence, frame index / decimation: a gap is a lost datagram, on
+//                  the network or dropped by a sender overrun (TelemetryStats::overruns)
+//       24     8  frame index (published frames since start)
+//       32     8  send time, steady clock ns
+//       40   192  LiveStateFrame, raw (live_state.h, version 2):
+//
+//     payload offset  field
+//          0  double   time_sec
+//          8  float    ias_knots, aoa_deg, nz, altitude_ft, vs_fpm, mach, tat_c,
+//                      pitch_deg, roll_deg, heading_deg, flaps lift bonus, flaps drag mult
+//         56  float    elevator_deg, aileron_deg, rudder_deg
+//         68  int32    control law (0 NORMAL, 1 ALTERNATE, 2 DIRECT)
+//         72  uint8    elac1, elac2, sec1, sec2, sec3 avail, alpha_prot, alpha_floor, high_speed_prot
+//         80  float    n1_percent, n2_percent, egt_c, fuel_flow
+//         96  uint8    spd, hdg, alt, vs mode, autothrust (+3 pad)
+//        104  float    target speed, heading, altitude, V/S
+//        120  uint8    AP was active last frame (+7 pad)
+//        128  uint64   alerts shown, warning, caution masks
+//        152  uint8    master warning, master caution (+6 pad)
+//        160  uint64   input seq, input sent ns, input applied ns, published ns
+
+constexpr uint16_t TELEMETRY_VERSION = 1;
+constexpr char TELEMETRY_MAGIC[4] = { 'P', 'T', 'L', 'M' };
+constexpr uint16_t TELEMETRY_DEFAULT_PORT = 49100;
+
+struct TelemetryHeader {
+    char magic[4];
+    uint16_t version;
+    uint16_t header_size;
+    uint32_t payload_size;
+    uint32_t decimation;
+    uint64_t packet_seq;
+    uint64_t frame_index;
+    uint64_t send_ns;
+};
+
+static_assert(sizeof(TelemetryHeader) == 40, "telemetry header layout changed, bump TELEMETRY_VERSION");
+static_assert(sizeof(LiveStateFrame) == 192 && offsetof(LiveStateFrame, surfaces) == 56 &&
+              offsetof(LiveStateFrame, fctl) == 68 && offsetof(LiveStateFrame, engine) == 80 &&
+              offsetof(LiveStateFrame, autopilot) == 96 && offsetof(LiveStateFrame, alerts_shown) == 128 &&
+              offsetof(LiveStateFrame, master_warning) == 152 && offsetof(LiveStateFrame, input_seq) == 160,
+              "LiveStateFrame layout no longer matches the documented telemetry payload");
+
+constexpr size_t TELEMETRY_PACKET_SIZE = sizeof(TelemetryHeader) + sizeof(LiveStateFrame);
+
+struct TelemetryConfig {
+    std::string host = "127.0.0.1";
+    uint16_t port = TELEMETRY_DEFAULT_PORT;
+    int decimation = 1;              // Send every Nth published frame
+    int poll_us = 100;               // I/O thread sleep when the ring is empty
+};
+
+// "host:port", ":port" or "port" (host defaults to 127.0.0.1)
+bool parseTelemetryTarget(const char* spec, TelemetryConfig& config, std::string& error);
+
+struct TelemetryStats {
+    uint64_t sent = 0;
+    uint64_t overruns = 0;           // Frames dropped because the I/O thread fell a ring behind
+    uint64_t send_errors = 0;
+};
+
+class TelemetryStreamer {
+public:
+    static constexpr uint32_t RING_FRAMES = 256;
+
+    TelemetryStreamer() = default;
+    ~TelemetryStreamer() { stop(); }
+
+    TelemetryStreamer(const TelemetryStreamer&) = delete;
+    TelemetryStreamer& operator=(const TelemetryStreamer&) = delete;
+
+    // Opens the socket and starts the I/O thread
+    bool start(const TelemetryConfig& config, std::string& error);
+    void stop();                     // Sends what is queued, then joins the I/O thread
+
+    // Sim thread: queue the frame for sending (memcpy only, never blocks, no syscalls)
+    void publish(const LiveStateFrame& frame);
+
+    bool isRunning() const { return running_.load(std::memory_order_relaxed); }
+    TelemetryStats stats() const;
+
+private:
+    void ioLoop();
+
+    TelemetryConfig config_;
+    int socket_ = -1;
+    std::thread io_thread_;
+    std::atomic<bool> running_{false};
+
+    // SPSC ring: publish() advances head_, the I/O thread advances tail_
+    std::vector<LiveStateFrame> frames_;
+    std::vector<uint64_t> frame_index_;
+    alignas(64) std::atomic<uint64_t> head_{0};
+    alignas(64) std::atomic<uint64_t> tail_{0};
+
+    uint64_t published_ = 0;         // Sim thread only
+    std::atomic<uint64_t> sent_{0};
+    std::atomic<uint64_t> overruns_{0};
+    std::atomic<uint64_t> send_errors_{0};
+};
@@ -0,0 +1,253 @@
+//
+//
+// Santiago Quintana Moreno A01571222
+// Created on: 18/10/2026.
+#include "timer_wheel.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+static constexpr uint64_t SLOT_MASK = TimerWheel::SLOTS - 1;
+static constexpr uint64_t MAX_DELTA = (1ull << (TimerWheel::LEVEL_BITS * TimerWheel::LEVELS)) - 1;
+
+TimerWheel::TimerWheel() : heads_(LIST_COUNT, NIL) {}
+
+uint64_t TimerWheel::tickFor(double t) const {
+    // Round up so a timer never fires before its time; the epsilon absorbs float step accumulation
+    double ticks = std::ceil(t * TICKS_PER_SEC - 1e-6);
+    return ticks > 0.0 ? (uint64_t)ticks : 0;
+}
+
+// Contexts are kept relative to the wheel, so a moved or copied owner fires into itself
+intptr_t TimerWheel::ctxOffset(void* ctx) const {
+    if (!ctx) return NO_CTX;
+    return (intptr_t)ctx - (intptr_t)this;
+}
+
+void* TimerWheel::ctxFor(intptr_t offset) {
+    if (offset == NO_CTX) return nullptr;
+    return (void*)((intptr_t)this + offset);
+}
+
+TimerHandle TimerWheel::schedule(double expiry_sec, TimerCallback fn, void* ctx) {
+    uint32_t idx;
+    if (!free_.empty()) {
+        idx = free_.back();
+        free_.pop_back();
+    } else {
+        idx = (uint32_t)nodes_.size();
+        nodes_.emplace_back();
+    }
+
+    Node& n = nodes_[idx];
+    n.expiry_sec = expiry_sec;
+    n.expiry_tick = tickFor(expiry_sec);
+    n.order = next_order_++;
+    n.fn = fn;
+    n.ctx_offset = ctxOffset(ctx);
+    ++active_;
+    place(idx);
+
+    return TimerHandle{ idx, n.generation };
+}
+
+bool TimerWheel::cancel(TimerHandle& handle) {
+    bool was_live = live(handle);
+    if (was_live) release(handle.index);
+    handle = TimerHandle{};
+    return was_live;
+}
+
+void TimerWheel::reschedule(TimerHandle& handle, double expiry_sec, TimerCallback fn, void* ctx) {
+    cancel(handle);
+    handle = schedule(expiry_sec, fn, ctx);
+}
+
+bool TimerWheel::pending(TimerHandle handle) const {
+    return live(handle);
+}
+
+double TimerWheel::remaining(TimerHandle handle) const {
+    if (!live(handle)) return 0.0;
+    return std::max(0.0, nodes_[handle.index].expiry_sec - now_sec_);
+}
+
+double TimerWheel::nextExpiry() const {
+    double next = std::numeric_limits<double>::infinity();
+    for (const Node& n : nodes_) {
+        if (n.list != FREE && n.list != FIRING) next = std::min(next, n.expiry_sec);
+    }
+    return next;
+}
+
+void TimerWheel::copyFrom(const TimerWheel& other) {
+    nodes_ = other.nodes_;
+    free_ = other.free_;
+    heads_ = other.heads_;
+    std::copy(other.level_count_, other.level_count_ + LEVELS, level_count_);
+    due_ = other.due_;
+    base_tick_ = other.base_tick_;
+    now_sec_ = other.now_sec_;
+    next_order_ = other.next_order_;
+    active_ = other.active_;
+}
+
+void TimerWheel::clear() {
+    for (uint32_t i = 0; i < (uint32_t)nodes_.size(); ++i) {
+        if (nodes_[i].list != FREE) release(i);
+    }
+    due_.clear();
+}
+
+// ========== Wheel Placement ==========
+
+void TimerWheel::place(uint32_t idx) {
+    const Node& n = nodes_[idx];
+    if (n.expiry_tick < base_tick_) {
+        link(idx, OVERDUE_LIST);
+        return;
+    }
+
+    uint64_t delta = n.expiry_tick - base_tick_;
+    uint64_t tick = n.expiry_tick;
+    if (delta > MAX_DELTA) {
+        // Beyond the wheel horizon: park at the far edge, it is re-placed when that slot cascades
+        tick = base_tick_ + MAX_DELTA;
+        delta = MAX_DELTA;
+    }
+
+    int level = 0;
+    while (level < LEVELS - 1 && delta >= (1ull << (LEVEL_BITS * (level + 1)))) ++level;
+
+    uint32_t slot = (uint32_t)((tick >> (LEVEL_BITS * level)) & SLOT_MASK);
+    link(idx, (uint32_t)level * SLOTS + slot);
+}
+
+void TimerWheel::link(uint32_t idx, uint32_t list) {
+    Node& n = nodes_[idx];
+    n.list = list;
+    n.prev = NIL;
+    n.next = heads_[list];
+    if (n.next != NIL) nodes_[n.next].prev = idx;
+    heads_[list] = idx;
+    if (list < OVERDUE_LIST) ++level_count_[list / SLOTS];
+}
+
+void TimerWheel::unlink(uint32_t idx) {
+    Node& n = nodes_[idx];
+    if (n.list >= LIST_COUNT) return;
+
+    if (n.prev != NIL) nodes_[n.prev].next = n.next;
+    else heads_[n.list] = n.next;
+    if (n.next != NIL) nodes_[n.next].prev = n.prev;
+    if (n.list < OVERDUE_LIST) --level_count_[n.list / SLOTS];
+
+    n.prev = n.next = NIL;
+    n.list = FIRING;
+}
+
+void TimerWheel::release(uint32_t idx) {
+    unlink(idx);
+    Node& n = nodes_[idx];
+    n.list = FREE;
+    n.fn = nullptr;
+    n.ctx_offset = NO_CTX;
+    if (++n.generation == 0) n.generation = 1;
+    free_.push_back(idx);
+    --active_;
+}
+
+void TimerWheel::cascade(int level) {
+    uint32_t slot = (uint32_t)((base_tick_ >> (LEVEL_BITS * level)) & SLOT_MASK);
+    uint32_t list = (uint32_t)level * SLOTS + slot;
+
+    uint32_t idx = heads_[list];
+    while (idx != NIL) {
+        uint32_t next = nodes_[idx].next;
+        unlink(idx);
+        place(idx);
+        idx = next;
+    }
+}
+
+// ========== Expiry ==========
+
+void TimerWheel::collect(uint32_t list) {
+    uint32_t idx = heads_[list];
+    while (idx != NIL) {
+        uint32_t next = nodes_[idx].next;
+        unlink(idx);
+        due_.push_back(TimerHandle{ idx, nodes_[idx].generation });
+        idx = next;
+    }
+}
+
+void TimerWheel::fireDue() {
+    // Callbacks may schedule timers that are already due; those land in the overdue list
+    // and are picked up by the next pass.
+    for (;;) {
+        collect(OVERDUE_LIST);
+        if (due_.empty()) return;
+
+        std::sort(due_.begin(), due_.end(), [this](TimerHandle a, TimerHandle b) {
+            const Node& na = nodes_[a.index];
+            const Node& nb = nodes_[b.index];
+            return na.expiry_sec < nb.expiry_sec || (na.expiry_sec == nb.expiry_sec && na.order < nb.order);
+        });
+
+        for (size_t i = 0; i < due_.size(); ++i) {
+            TimerHandle h = due_[i];
+            // A callback earlier in this batch may have cancelled it
+            if (!live(h) || nodes_[h.index].list != FIRING) continue;
+
+            Node& n = nodes_[h.index];
+            TimerCallback fn = n.fn;
+            void* ctx = ctxFor(n.ctx_offset);
+            now_sec_ = std::max(now_sec_, n.expiry_sec);
+            release(h.index);
+            fn(ctx);
+        }
+        due_.clear();
+    }
+}
+
+uint64_t TimerWheel::nextInterestingTick(uint64_t target) const {
+    if (heads_[OVERDUE_LIST] != NIL || level_count_[0] > 0) return base_tick_;
+
+    // Only higher levels hold timers: nothing happens before the next boundary of the lowest one
+    for (int level = 1; level < LEVELS; ++level) {
+        if (level_count_[level] == 0) continue;
+        uint64_t span = 1ull << (LEVEL_BITS * level);
+        return (base_tick_ + span - 1) & ~(span - 1);
+    }
+    return target + 1;
+}
+
+void TimerWheel::advance(double now_sec) {
+    uint64_t target = (uint64_t)std::max(0.0, std::floor(now_sec * TICKS_PER_SEC + 1e-6));
+
+    while (base_tick_ <= target) {
+        uint64_t next = nextInterestingTick(target);
+        if (next > target) {
+            base_tick_ = target + 1;
+            break;
+        }
+        base_tick_ = next;
+
+        // Refill level 0 from the higher levels whenever their index rolls over
+        if ((base_tick_ & SLOT_MASK) == 0) {
+            for (int level = 1; level < LEVELS; ++level) {
+                cascade(level);
+                if (((base_tick_ >> (LEVEL_BITS * level)) & SLOT_MASK) != 0) break;
+            }
+        }
+
+        collect((uint32_t)(base_tick_ & SLOT_MASK));
+        ++base_tick_;
+        fireDue();
+    }
+
+    // Timers scheduled in the past since the last call
+    fireDue();
+    now_sec_ = std::max(now_sec_, now_sec);
+}
@@ -0,0 +1,123 @@
+//
+//
+// Santiago Quintana Moreno A01571222
+// Created on: 18/10/2026.
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// ========== Sim Timer Wheel ==========
+// Central scheduler for timed sim events (gear transit, GPWS callout expiry, procedure waits).
+// Hierarchical wheel on a 1 ms tick: level 0 holds timers due in the next 64 ticks, each
+// higher level covers 64x the range of the one below and cascades down as time reaches it.
+// Insert and cancel are O(1); timers live in a pooled node array linked into per-slot lists.
+//
+// advance() walks the elapsed ticks in order and skips empty stretches, so a large time
+// step (time compression, a scenario jump) still fires expiries in deadline order. Timers
+// due in the same tick are sorted on their exact time, then in scheduling order.
+//
+// A timer's context must live in the same object as the wheel (a SimState member). It is
+// stored as an offset from the wheel and resolved when the timer fires, so pending timers
+// follow their owner when it is moved or copied.
+
+using TimerCallback = void (*)(void* ctx);
+
+// Generation-checked reference to a scheduled timer. A default handle refers to nothing,
+// and a handle whose timer fired or was cancelled simply stops matching.
+struct TimerHandle {
+    uint32_t index = 0;
+    uint32_t generation = 0;     // 0 = no timer
+};
+
+class TimerWheel {
+public:
+    static constexpr double TICKS_PER_SEC = 1000.0;
+    static constexpr int LEVEL_BITS = 6;
+    static constexpr int LEVELS = 5;                 // 2^30 ticks ~ 12 days before clamping
+    static constexpr uint32_t SLOTS = 1u << LEVEL_BITS;
+
+    TimerWheel();
+
+    // Copy through copyFrom() so an owner's state can be saved without allocating
+    TimerWheel(const TimerWheel&) = delete;
+    TimerWheel& operator=(const TimerWheel&) = delete;
+    TimerWheel(TimerWheel&&) = default;
+    TimerWheel& operator=(TimerWheel&&) = default;
+
+    // Make this wheel an exact copy of 'other'. Contexts resolve into this wheel's owner.
+    void copyFrom(const TimerWheel& other);
+
+    // Schedule fn(ctx) at absolute sim time. Times already passed fire on the next advance().
+    // 'ctx' is null or points into the object that holds this wheel.
+    TimerHandle schedule(double expiry_sec, TimerCallback fn, void* ctx);
+    TimerHandle scheduleIn(double delay_sec, TimerCallback fn, void* ctx) { return schedule(now_sec_ + delay_sec, fn, ctx); }
+
+    // Cancel and clear the handle. Returns false when the timer had already fired or been cancelled.
+    bool cancel(TimerHandle& handle);
+
+    // Cancel any pending timer behind 'handle' and schedule a new one in its place
+    void reschedule(TimerHandle& handle, double expiry_sec, TimerCallback fn, void* ctx);
+
+    bool pending(TimerHandle handle) const;
+    double remaining(TimerHandle handle) const;      // Seconds until expiry, 0 if not pending
+
+    // Earliest pending expiry, infinity with nothing scheduled. Scans the node pool, so it is
+    // meant for choosing step lengths, not for every tick.
+    double nextExpiry() const;
+
+    // Fire every timer due at or before now_sec, in deadline order
+    void advance(double now_sec);
+
+    double now() const { return now_sec_; }
+    size_t size() const { return active_; }
+    void clear();
+
+private:
+    static constexpr uint32_t NIL = 0xFFFFFFFFu;
+    static constexpr uint32_t LIST_COUNT = LEVELS * SLOTS + 1;
+    static constexpr uint32_t OVERDUE_LIST = LEVELS * SLOTS;    // Scheduled at or before the current tick
+    static constexpr uint32_t FIRING = LIST_COUNT;              // Detached, waiting in due_
+    static constexpr uint32_t FREE = LIST_COUNT + 1;
+    static constexpr intptr_t NO_CTX = INTPTR_MIN;              // Null context
+
+    struct Node {
+        double expiry_sec = 0.0;
+        uint64_t expiry_tick = 0;
+        uint64_t order = 0;           // FIFO among equal expiry times
+        TimerCallback fn = nullptr;
+        intptr_t ctx_offset = NO_CTX; // Context address relative to the wheel
+        uint32_t prev = NIL;
+        uint32_t next = NIL;
+        uint32_t list = FREE;
+        uint32_t generation = 1;
+    };
+
+    uint64_t tickFor(double t) const;
+    intptr_t ctxOffset(void* ctx) const;
+    void* ctxFor(intptr_t offset);
+    bool live(TimerHandle handle) const {
+        return handle.generation != 0 && handle.index < nodes_.size() &&
+               nodes_[handle.index].generation == handle.generation && nodes_[handle.index].list != FREE;
+    }
+
+    void place(uint32_t idx);
+    void link(uint32_t idx, uint32_t list);
+    void unlink(uint32_t idx);
+    void release(uint32_t idx);
+    void cascade(int level);
+    void collect(uint32_t list);
+    void fireDue();
+    uint64_t nextInterestingTick(uint64_t target) const;
+
+    std::vector<Node> nodes_;
+    std::vector<uint32_t> free_;
+    std::vector<uint32_t> heads_;               // LIST_COUNT list heads
+    uint32_t level_count_[LEVELS] = {};         // Timers per level, for skipping empty stretches
+    std::vector<TimerHandle> due_;              // Scratch list for the tick being fired
+
+    uint64_t base_tick_ = 0;                    // Next tick to process
+    double now_sec_ = 0.0;
+    uint64_t next_order_ = 0;
+    size_t active_ = 0;
+};
@@ -0,0 +1,343 @@
+//
+//
+// Santiago Quintana Moreno A01571222
+// Created on: 18/10/2026.
+#include "trim_solver.h"
+#include "atmosphere.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+
+static float clampf(float v, float lo, float hi) { return std::max(lo, std::min(hi, v)); }
+
+struct TrimPoint {
+    float speed_rate = 0.0f;   // kt/s
+    float vs_error = 0.0f;     // fpm
+    Sensors settled{};
+};
+
+// Holds IAS and altitude at the condition while the lagged states (AoA, V/S, smoothed flaps)
+// settle for the given controls, then measures the remaining speed rate.
+static TrimPoint evaluate(const TrimCondition& cond, float thrust, float pitch_deg, const TrimSolverConfig& config) {
+    // The held IAS and altitude re-seed the 6-DOF state every step, so substeps finer than the
+    // settle step buy nothing there
+    FlightModel model = config.model;
+    model.substep_sec = std::max(model.substep_sec, config.settle_dt_sec);
+    PrimCore core;
+    core.setFlightModel(model);
+    PilotInput pilot;
+    pilot.pitch = 0.0f;
+    pilot.roll = 0.0f;
+    pilot.thrust = thrust;
+
+    AutopilotState ap{};
+    Speedbrakes speedbrakes{};
+    Weather weather{};
+    EngineState engines{};
+    TrimSystem trim{};
+    LandingGear gear;
+    gear.position = cond.gear;
+    gear.target_position = cond.gear;
+
+    Sensors s;
+    s.altitude_ft = cond.altitude_ft;
+    s.ias_knots = cond.ias_knots;
+    s.pitch_deg = pitch_deg;
+    s.roll_deg = 0.0f;
+    s.heading_deg = 0.0f;
+    s.vs_fpm = cond.vs_fpm;
+
+    int steps = (int)std::ceil(config.settle_sec / config.settle_dt_sec);
+    for (int i = 0; i < steps; ++i) {
+        core.updateFlightDynamics(s, pilot, cond.flaps, config.settle_dt_sec, ap, speedbrakes, gear, weather, engines, trim);
+        s.ias_knots = cond.ias_knots;
+        s.altitude_ft = cond.altitude_ft;
+        s.pitch_deg = pitch_deg;
+    }
+
+    // The speed update is explicit Euler on the pre-step state, so a 1 s probe step gives the
+    // rate directly without losing it in float rounding of the IAS value. It is measured
+    // against a zero-length step: the 6-DOF model keeps TAS, and its IAS -> TAS -> IAS round
+    // trip is not exact.
+    Sensors start = s;
+    core.updateFlightDynamics(start, pilot, cond.flaps, 0.0f, ap, speedbrakes, gear, weather, engines, trim);
+    Sensors probe = s;
+    core.updateFlightDynamics(probe, pilot, cond.flaps, 1.0f, ap, speedbrakes, gear, weather, engines, trim);
+
+    TrimPoint out;
+    out.speed_rate = probe.ias_knots - start.ias_knots;
+    out.vs_error = s.vs_fpm - cond.vs_fpm;
+    out.settled = s;
+    return out;
+}
+
+TrimResult solveTrim(const TrimCondition& cond, const TrimSolverConfig& config) {
+    const float D_THRUST = 0.01f;
+    const float D_PITCH = 0.1f;
+
+    float thrust = 0.5f;
+    float pitch = cond.vs_fpm / 200.0f;   // V/S follows pitch at 200 fpm/deg
+    int pinned = 0;                       // Consecutive steps that wanted thrust outside 0..1
+
+    TrimResult result;
+    for (int iter = 1; iter <= config.max_iterations; ++iter) {
+        TrimPoint p = evaluate(cond, thrust, pitch, config);
+
+        result.thrust = thrust;
+        result.pitch_deg = pitch;
+        result.aoa_deg = p.settled.aoa_deg;
+        result.flaps_lift_bonus = p.settled.smoothed_flaps_lift_bonus;
+        result.flaps_drag_mult = p.settled.smoothed_flaps_drag_mult;
+        result.residual_kt_per_sec = p.speed_rate;
+        result.iterations = (uint16_t)iter;
+
+        if (std::abs(p.speed_rate) < config.speed_tolerance && std::abs(p.vs_error) < config.vs_tolerance) {
+            result.converged = 1;
+            return result;
+        }
+
+        // Finite-difference Jacobian of (speed rate, V/S error) w.r.t. (thrust, pitch)
+        TrimPoint pt = evaluate(cond, thrust + D_THRUST, pitch, config);
+        TrimPoint pp = evaluate(cond, thrust, pitch + D_PITCH, config);
+        float j11 = (pt.speed_rate - p.speed_rate) / D_THRUST;
+        float j12 = (pp.speed_rate - p.speed_rate) / D_PITCH;
+        float j21 = (pt.vs_error - p.vs_error) / D_THRUST;
+        float j22 = (pp.vs_error - p.vs_error) / D_PITCH;
+
+        float det = j11 * j22 - j12 * j21;
+        float d_thrust;
+        float d_pitch;
+        if (std::abs(det) > 1e-6f) {
+            d_thrust = -( j22 * p.speed_rate - j12 * p.vs_error) / det;
+            d_pitch  = -(-j21 * p.speed_rate + j11 * p.vs_error) / det;
+        } else {
+            // Degenerate Jacobian: fall back to a secant step on thrust alone
+            d_thrust = (std::abs(j11) > 1e-6f) ? -p.speed_rate / j11 : 0.0f;
+            d_pitch = 0.0f;
+        }
+
+        d_thrust = clampf(d_thrust, -0.3f, 0.3f);
+        d_pitch = clampf(d_pitch, -5.0f, 5.0f);
+
+        float new_thrust = thrust + d_thrust;
+        if (new_thrust < 0.0f || new_thrust > 1.0f) {
+            // Condition needs more than TOGA or less than idle: give up once it keeps asking
+            if (++pinned >= 2) break;
+        } else {
+            pinned = 0;
+        }
+        thrust = clampf(new_thrust, 0.0f, 1.0f);
+        pitch = clampf(pitch + d_pitch, -20.0f, 20.0f);
+    }
+
+    result.converged = 0;
+    return result;
+}
+
+void applyTrim(SimState& sim, const TrimCondition& cond, const TrimResult& trim) {
+    sim.sensors.altitude_ft = cond.altitude_ft;
+    sim.sensors.ias_knots = cond.ias_knots;
+    sim.sensors.vs_fpm = cond.vs_fpm;
+    sim.sensors.mach = casToMach(cond.ias_knots, cond.altitude_ft);
+    sim.sensors.tat_c = totalAirTemperatureC(isaTemperatureC(cond.altitude_ft), sim.sensors.mach);
+    sim.sensors.pitch_deg = trim.pitch_deg;
+    sim.sensors.roll_deg = 0.0f;
+    sim.sensors.aoa_deg = trim.aoa_deg;
+    sim.sensors.nz = 1.0f;
+    sim.sensors.smoothed_flaps_lift_bonus = trim.flaps_lift_bonus;
+    sim.sensors.smoothed_flaps_drag_mult = trim.flaps_drag_mult;
+
+    sim.flaps = cond.flaps;
+    sim.prim.settleFlaps(cond.flaps);
+    sim.gear.position = cond.gear;
+    sim.gear.target_position = cond.gear;
+    sim.timers.cancel(sim.gear.transit_timer);
+    sim.gear.weight_on_wheels = false;
+
+    sim.pilot.pitch = 0.0f;
+    sim.pilot.roll = 0.0f;
+    sim.pilot.thrust = trim.thrust;
+    sim.trim.pitch_trim_deg = 0.0f;
+
+    sim.autopilot.target_alt_ft = cond.altitude_ft;
+    sim.autopilot.target_spd_knots = cond.ias_knots;
+}
+
+bool checkTrimHolds(const TrimCondition& cond, const TrimResult& trim, const TrimSolverConfig& config,
+                    std::string& error) {
+    SimState probe;
+    probe.prim.setFlightModel(config.model);
+    applyTrim(probe, cond, trim);
+
+    char msg[160];
+    int steps = (int)std::ceil(config.hold_sec / config.hold_dt_sec);
+    for (int i = 0; i < steps; ++i) {
+        stepSimulation(probe, config.hold_dt_sec);
+        const FlightControlStatus& fctl = probe.prim.fctl_status();
+        if (fctl.alpha_prot || fctl.alpha_floor) {
+            std::snprintf(msg, sizeof(msg), "trimmed AoA %.1f deg engages %s after %.2f s", trim.aoa_deg,
+                          fctl.alpha_floor ? "alpha floor" : "alpha protection", probe.time_sec);
+            error = msg;
+            return false;
+        }
+    }
+
+    float ias_drift = probe.sensors.ias_knots - cond.ias_knots;
+    float vs_drift = probe.sensors.vs_fpm - cond.vs_fpm;
+    if (std::abs(ias_drift) > config.hold_ias_knots || std::abs(vs_drift) > config.hold_vs_fpm) {
+        std::snprintf(msg, sizeof(msg), "trimmed point drifts %+.1f kt, %+.0f fpm in %.0f s", ias_drift, vs_drift,
+                      config.hold_sec);
+        error = msg;
+        return false;
+    }
+    return true;
+}
+
+bool trimSimulation(SimState& sim, const TrimCondition& cond, std::string& error) {
+    TrimSolverConfig config;
+    config.model = sim.prim.flightModel();
+    TrimResult trim = solveTrim(cond, config);
+    if (!trim.converged) {
+        error = "no thrust setting holds the condition";
+        return false;
+    }
+    if (!checkTrimHolds(cond, trim, config, error)) return false;
+    applyTrim(sim, cond, trim);
+    return true;
+}
+
+// ========== Equilibrium Table ==========
+
+// Index of the grid cell containing v and the interpolation weight inside it
+static void gridCell(const std::vector<float>& axis, float v, int& i0, float& t) {
+    if (axis.size() < 2 || v <= axis.front()) { i0 = 0; t = 0.0f; return; }
+    if (v >= axis.back()) { i0 = (int)axis.size() - 2; t = 1.0f; return; }
+    i0 = (int)(std::upper_bound(axis.begin(), axis.end(), v) - axis.begin()) - 1;
+    t = (v - axis[i0]) / (axis[i0 + 1] - axis[i0]);
+}
+
+TrimResult TrimTable::lookup(const TrimCondition& cond) const {
+    TrimResult out;
+    if (altitudes_ft.empty() || ias_knots.empty()) return out;
+
+    int gear = (cond.gear == GearPosition::UP) ? 0 : 1;
+    int flaps = (int)cond.flaps;
+
+    int a0, s0;
+    float ta, ts;
+    gridCell(altitudes_ft, cond.altitude_ft, a0, ta);
+    gridCell(ias_knots, cond.ias_knots, s0, ts);
+    int a1 = std::min(a0 + 1, (int)altitudes_ft.size() - 1);
+    int s1 = std::min(s0 + 1, (int)ias_knots.size() - 1);
+
+    const TrimResult* c[4] = { &at(gear, flaps, a0, s0), &at(gear, flaps, a0, s1),
+                               &at(gear, flaps, a1, s0), &at(gear, flaps, a1, s1) };
+    float w[4] = { (1 - ta) * (1 - ts), (1 - ta) * ts, ta * (1 - ts), ta * ts };
+
+    out.converged = 1;
+    out.flaps_drag_mult = 0.0f;
+    for (int i = 0; i < 4; ++i) {
+        out.thrust += c[i]->thrust * w[i];
+        out.pitch_deg += c[i]->pitch_deg * w[i];
+        out.aoa_deg += c[i]->aoa_deg * w[i];
+        out.flaps_lift_bonus += c[i]->flaps_lift_bonus * w[i];
+        out.flaps_drag_mult += c[i]->flaps_drag_mult * w[i];
+        out.residual_kt_per_sec = std::max(out.residual_kt_per_sec, std::abs(c[i]->residual_kt_per_sec));
+        out.iterations = std::max(out.iterations, c[i]->iterations);
+        out.converged &= c[i]->converged;
+    }
+    return out;
+}
+
+bool TrimTable::save(const char* path) const {
+    FILE* f = std::fopen(path, "wb");
+    if (!f) return false;
+
+    uint32_t header[5] = { TRIM_TABLE_VERSION, (uint32_t)altitudes_ft.size(), (uint32_t)ias_knots.size(),
+                           (uint32_t)FLAPS_COUNT, (uint32_t)GEAR_COUNT };
+    bool ok = std::fwrite("PTRM", 1, 4, f) == 4;
+    ok = ok && std::fwrite(header, sizeof(header), 1, f) == 1;
+    ok = ok && std::fwrite(altitudes_ft.data(), sizeof(float), altitudes_ft.size(), f) == altitudes_ft.size();
+    ok = ok && std::fwrite(ias_knots.data(), sizeof(float), ias_knots.size(), f) == ias_knots.size();
+    ok = ok && std::fwrite(entries.data(), sizeof(TrimResult), entries.size(), f) == entries.size();
+    ok = (std::fclose(f) == 0) && ok;
+    return ok;
+}
+
+bool TrimTable::load(const char* path) {
+    FILE* f = std::fopen(path, "rb");
+    if (!f) return false;
+
+    char magic[4];
+    uint32_t header[5];
+    bool ok = std::fread(magic, 1, 4, f) == 4 && std::memcmp(magic, "PTRM", 4) == 0;
+    ok = ok && std::fread(header, sizeof(header), 1, f) == 1;
+    ok = ok && header[0] == TRIM_TABLE_VERSION && header[3] == FLAPS_COUNT && header[4] == GEAR_COUNT;
+    ok = ok && header[1] > 0 && header[1] <= 100000 && header[2] > 0 && header[2] <= 100000;
+
+    if (ok) {
+        altitudes_ft.resize(header[1]);
+        ias_knots.resize(header[2]);
+        entries.resize((size_t)GEAR_COUNT * FLAPS_COUNT * header[1] * header[2]);
+        ok = std::fread(altitudes_ft.data(), sizeof(float), altitudes_ft.size(), f) == altitudes_ft.size();
+        ok = ok && std::fread(ias_knots.data(), sizeof(float), ias_knots.size(), f) == ias_knots.size();
+        ok = ok && std::fread(entries.data(), sizeof(TrimResult), entries.size(), f) == entries.size();
+    }
+    std::fclose(f);
+
+    if (!ok) {
+        altitudes_ft.clear();
+        ias_knots.clear();
+        entries.clear();
+    }
+    return ok;
+}
+
+TrimTable buildTrimTable(const std::vector<float>& altitudes_ft, const std::vector<float>& ias_knots,
+                         int threads, const TrimSolverConfig& config) {
+    TrimTable table;
+    table.altitudes_ft = altitudes_ft;
+    table.ias_knots = ias_knots;
+    std::sort(table.altitudes_ft.begin(), table.altitudes_ft.end());
+    std::sort(table.ias_knots.begin(), table.ias_knots.end());
+
+    size_t n_alt = table.altitudes_ft.size();
+    size_t n_ias = table.ias_knots.size();
+    size_t total = (size_t)TrimTable::GEAR_COUNT * TrimTable::FLAPS_COUNT * n_alt * n_ias;
+    table.entries.resize(total);
+    if (total == 0) return table;
+
+    if (threads <= 0) threads = (int)std::thread::hardware_concurrency();
+    threads = std::max(1, std::min(threads, (int)total));
+
+    // Grid points are independent; workers pull the next flat index (same order as at())
+    std::atomic<size_t> next{0};
+    auto worker = [&]() {
+        for (size_t i = next.fetch_add(1); i < total; i = next.fetch_add(1)) {
+            size_t ias = i % n_ias;
+            size_t alt = (i / n_ias) % n_alt;
+            size_t flaps = (i / (n_ias * n_alt)) % TrimTable::FLAPS_COUNT;
+            size_t gear = i / (n_ias * n_alt * TrimTable::FLAPS_COUNT);
+
+            TrimCondition cond;
+            cond.altitude_ft = table.altitudes_ft[alt];
+            cond.ias_knots = table.ias_knots[ias];
+            cond.flaps = (FlapsPosition)flaps;
+            cond.gear = (gear == 0) ? GearPosition::UP : GearPosition::DOWN;
+            TrimResult trim = solveTrim(cond, config);
+            std::string error;
+            if (trim.converged && !checkTrimHolds(cond, trim, config, error)) trim.converged = 0;
+            table.entries[i] = trim;
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (int i = 1; i < threads; ++i) pool.emplace_back(worker);
+    worker();
+    for (auto& th : pool) th.join();
+
+    return table;
+}
@@ -0,0 +1,105 @@
+//
+//
+// Santiago Quintana Moreno A01571222
+// Created on: 18/10/2026.
+#pragma once
+#include "sim_state.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Flight condition to trim for (wings level, no wind, both engines running)
+struct TrimCondition {
+    float altitude_ft = 10000.0f;
+    float ias_knots = 250.0f;
+    FlapsPosition flaps = FlapsPosition::RETRACTED;
+    GearPosition gear = GearPosition::UP;
+    float vs_fpm = 0.0f;   // Target vertical speed, 0 = level flight
+};
+
+// Equilibrium found by solveTrim(). Also the on-disk record of TrimTable, so it is kept
+// trivially copyable with a fixed layout.
+struct TrimResult {
+    float thrust = 0.0f;              // Thrust lever 0..1
+    float pitch_deg = 0.0f;
+    float aoa_deg = 0.0f;             // Settled AoA at the equilibrium
+    float flaps_lift_bonus = 0.0f;    // Settled Sensors::smoothed_flaps_* values
+    float flaps_drag_mult = 1.0f;
+    float residual_kt_per_sec = 0.0f; // Remaining speed rate at the solution
+    uint16_t iterations = 0;
+    uint8_t converged = 0;            // 0 when no thrust in 0..1 holds the condition (in a
+                                      // TrimTable, also when the point fails checkTrimHolds())
+    uint8_t reserved = 0;
+};
+
+static_assert(sizeof(TrimResult) == 28, "TrimResult is written to disk as-is");
+
+struct TrimSolverConfig {
+    int max_iterations = 20;
+    float speed_tolerance = 1e-3f;    // kt/s
+    float vs_tolerance = 0.5f;        // fpm
+    float settle_sec = 30.0f;         // Time the lagged states (AoA, flaps, V/S) get to settle
+    float settle_dt_sec = 0.1f;
+    float hold_sec = 20.0f;           // checkTrimHolds(): time the point is flown through stepSimulation
+    float hold_dt_sec = 0.01f;
+    float hold_ias_knots = 2.0f;      // Largest drift off the condition at the end of the hold
+    float hold_vs_fpm = 100.0f;
+    FlightModel model;                // Aircraft model being trimmed
+};
+
+// Newton iteration on (thrust, pitch) so that the IAS rate and V/S produced by
+// PrimCore::updateFlightDynamics match the condition. The Jacobian is taken by finite
+// differences on the real model, so model changes are picked up automatically.
+TrimResult solveTrim(const TrimCondition& cond, const TrimSolverConfig& config = {});
+
+// Puts the aircraft at 'cond' using a solved trim point (flaps, gear, speeds, Mach, TAT,
+// attitude, thrust)
+void applyTrim(SimState& sim, const TrimCondition& cond, const TrimResult& trim);
+
+// Flies a solved point for hold_sec through stepSimulation(), which adds the control laws and
+// protections that solveTrim() leaves out. False (with the reason in 'error') if alpha
+// protection or alpha floor engages, or IAS / V/S drift off the condition.
+bool checkTrimHolds(const TrimCondition& cond, const TrimResult& trim, const TrimSolverConfig& config,
+                    std::string& error);
+
+// Solves, checks and applies in one go. Returns false, leaving 'sim' untouched, if the
+// condition cannot be trimmed or the trimmed point does not hold.
+bool trimSimulation(SimState& sim, const TrimCondition& cond, std::string& error);
+
+// ========== Equilibrium Table ==========
+// Grid of trim points over altitude x IAS x flaps x gear, level flight.
+//
+// Binary layout (little-endian):
+//   char     magic[4]  "PTRM"
+//   uint32   version   TRIM_TABLE_VERSION
+//   uint32   altitude count, IAS count, flaps count (5), gear count (2)
+//   float    altitudes_ft[altitude count]
+//   float    ias_knots[IAS count]
+//   TrimResult entries[gear][flaps][altitude][ias]   (28 bytes each)
+constexpr uint32_t TRIM_TABLE_VERSION = 1;
+
+class TrimTable {
+public:
+    static constexpr int FLAPS_COUNT = 5;
+    static constexpr int GEAR_COUNT = 2;   // UP, DOWN
+
+    std::vector<float> altitudes_ft;  // Ascending
+    std::vector<float> ias_knots;     // Ascending
+    std::vector<TrimResult> entries;
+
+    const TrimResult& at(int gear, int flaps, int alt, int ias) const {
+        return entries[(((size_t)gear * FLAPS_COUNT + flaps) * altitudes_ft.size() + alt) * ias_knots.size() + ias];
+    }
+
+    // Bilinear in altitude/IAS for the condition's flaps and gear (clamped to the grid).
+    // Not converged if any of the surrounding grid points is not.
+    TrimResult lookup(const TrimCondition& cond) const;
+
+    bool save(const char* path) const;
+    bool load(const char* path);
+};
+
+// Solves and hold-checks every grid point in parallel (threads = 0: one per hardware thread),
+// so an entry is converged only where trimSimulation() would accept it
+TrimTable buildTrimTable(const std::vector<float>& altitudes_ft, const std::vector<float>& ias_knots,
+                         int threads = 0, const TrimSolverConfig& config = {});
@@ -3,11 +3,17 @@
 // Santiago Quintana Moreno A01571222
 // Created on: 24/12/2025.
 #include "ui_panels.h"
+#include "frame_arena.h"
+#include "panel_scheduler.h"
+#include "param_history.h"
+#include "static_layer.h"
+#include "tape_scale.h"
 #include "imgui.h"
 #include <SDL2/SDL.h>
 #include <algorithm>
 #include <cmath>
 #include <cstdio>
+#include <cstring>
 
 // Airbus color palette
 namespace AirbusColors {
@@ -22,6 +28,44 @@ namespace AirbusColors {
 
 static float clampf(float v, float lo, float hi) { return std::max(lo, std::min(hi, v)); }
 
+// Scheduled panels are not submitted on every frame; when one comes back it must not grab
+// focus or jump in front of the window the user is working in
+static const ImGuiWindowFlags PANEL_WINDOW_FLAGS = ImGuiWindowFlags_NoFocusOnAppearing;
+
+// Blink phase from the wall clock rather than summed frame deltas, so it stays right across
+// skipped frames and the panel versions can follow it. True in the first half of each period.
+static const double MASTER_BLINK_SEC = 1.0;
+static const double PULL_UP_BLINK_SEC = 0.5;
+
+static double s_ui_time_sec = -1.0;     // SetUiTime(); < 0: wall clock
+
+void SetUiTime(double now_sec) {
+    s_ui_time_sec = now_sec;
+}
+
+static bool BlinkPhase(double period_sec) {
+    double now = s_ui_time_sec >= 0.0 ? s_ui_time_sec
+                                      : (double)SDL_GetPerformanceCounter() / (double)SDL_GetPerformanceFrequency();
+    return std::fmod(now, period_sec) < period_sec * 0.5;
+}
+
+// Scratch memory for the current UI frame (reset in BeginUiFrame)
+static FrameArena s_frame_arena;
+
+void BeginUiFrame() {
+    s_frame_arena.reset();
+}
+
+// Arena-backed equivalent of AlertManager::getShownSorted for per-frame drawing
+static FrameVector<const Alert*> CollectShown(const AlertManager& alerts, AlertLevel lvl) {
+    FrameVector<const Alert*> out(s_frame_arena);
+    for (const auto& a : alerts.all()) {
+        bool shown = (a.active || a.latched);
+        if (shown && a.level == lvl) out.push_back(&a);
+    }
+    return out;
+}
+
 static ImU32 alertColor(AlertLevel lvl) {
     switch (lvl) {
         case AlertLevel::WARNING: return AirbusColors::RED;
@@ -56,6 +100,34 @@ static void EndAirbusBox() {
     ImGui::EndChild();
 }
 
+// ========== PFD Scales ==========
+// Tick layout of every tape and ladder; labels are formatted and measured once per font size
+static const TapeScale SPEED_SCALE    = {.min_value = 0.0f, .max_value = 400.0f, .tick_step = 10.0f, .major_every = 2, .label_zero = false};
+static const TapeScale ALTITUDE_SCALE = {.min_value = -2000.0f, .max_value = 51000.0f, .tick_step = 100.0f, .major_every = 5, .label_divisor = 100.0f};
+static const TapeScale PITCH_LADDER   = {.min_value = -30.0f, .max_value = 30.0f, .tick_step = 10.0f};
+static const TapeScale BUSS_PITCH     = {.min_value = 0.0f, .max_value = 20.0f, .tick_step = 5.0f, .label_format = "%.0f°"};
+
+// PFD backgrounds painted once per size / BUSS configuration
+static StaticLayer s_pfd_layer;
+
+static uint32_t floatBits(float v) {
+    uint32_t bits;
+    std::memcpy(&bits, &v, sizeof(bits));
+    return bits;
+}
+
+static TapeLabels s_speed_labels;
+static TapeLabels s_altitude_labels;
+static TapeLabels s_buss_pitch_labels;
+
+static float MeasureText(const char* text) { return ImGui::CalcTextSize(text).x; }
+
+static const TapeLabels& CachedLabels(TapeLabels& labels, const TapeScale& scale) {
+    float font_size = ImGui::GetFontSize();
+    if (!labels.builtFor(font_size)) labels.build(scale, MeasureText, font_size);
+    return labels;
+}
+
 // ================================
 // MASTER WARNING/CAUTION Panel
 // ================================
@@ -64,15 +136,13 @@ void DrawMasterPanel(AlertManager& alerts) {
     ImGui::SetNextWindowSize(ImVec2(350, 90), ImGuiCond_Once);
 
     ImGui::PushStyleColor(ImGuiCol_WindowBg, AirbusColors::DARK_BG);
-    ImGui::Begin("MASTER WARNING/CAUTION", nullptr);
+    ImGui::Begin(panelTitle(Panel::MASTER), nullptr, PANEL_WINDOW_FLAGS);
 
     bool mw = alerts.masterWarningOn();
     bool mc = alerts.masterCautionOn();
 
     // Flashing master warning/caution (in real aircraft these flash)
-    static float blink_timer = 0.0f;
-    blink_timer += ImGui::GetIO().DeltaTime;
-    bool blink_on = (fmod(blink_timer, 1.0f) < 0.5f);
+    bool blink_on = BlinkPhase(MASTER_BLINK_SEC);
 
     if (mw && blink_on) {
         ImGui::PushStyleColor(ImGuiCol_Button, AirbusColors::RED);
@@ -108,7 +178,7 @@ void DrawEcamPanel(AlertManager& alerts, Sensors& sensors, PilotInput& pilot, Fa
     ImGui::SetNextWindowSize(ImVec2(350, 480), ImGuiCond_Once);
 
     ImGui::PushStyleColor(ImGuiCol_WindowBg, AirbusColors::DARK_BG);
-    ImGui::Begin("ECAM E/WD", nullptr);
+    ImGui::Begin(panelTitle(Panel::ECAM), nullptr, PANEL_WINDOW_FLAGS);
 
     // Title
     TextCentered("ENGINE / WARNING DISPLAY", AirbusColors::WHITE);
@@ -212,7 +282,7 @@ void DrawEcamPanel(AlertManager& alerts, Sensors& sensors, PilotInput& pilot, Fa
     ImGui::Spacing();
 
     // Warnings section
-    auto warnings = alerts.getShownSorted(AlertLevel::WARNING);
+    auto warnings = CollectShown(alerts, AlertLevel::WARNING);
     if (!warnings.empty()) {
         ImGui::PushStyleColor(ImGuiCol_Text, AirbusColors::RED);
         for (auto* a : warnings) {
@@ -225,7 +295,7 @@ void DrawEcamPanel(AlertManager& alerts, Sensors& sensors, PilotInput& pilot, Fa
     }
 
     // Cautions section
-    auto cautions = alerts.getShownSorted(AlertLevel::CAUTION);
+    auto cautions = CollectShown(alerts, AlertLevel::CAUTION);
     if (!cautions.empty()) {
         ImGui::PushStyleColor(ImGuiCol_Text, AirbusColors::AMBER);
         for (auto* a : cautions) {
@@ -238,7 +308,7 @@ void DrawEcamPanel(AlertManager& alerts, Sensors& sensors, PilotInput& pilot, Fa
     }
 
     // ECAM Actions section (all alerts with actions, stacked)
-    std::vector<const Alert*> alerts_with_actions;
+    FrameVector<const Alert*> alerts_with_actions(s_frame_arena);
 
     // Collect all warnings with actions first (highest priority)
     for (auto* a : warnings) {
@@ -273,7 +343,7 @@ void DrawEcamPanel(AlertManager& alerts, Sensors& sensors, PilotInput& pilot, Fa
 
     // Memos section
     ImGui::PushStyleColor(ImGuiCol_Text, AirbusColors::CYAN);
-    auto memos = alerts.getShownSorted(AlertLevel::MEMO);
+    auto memos = CollectShown(alerts, AlertLevel::MEMO);
     for (auto* a : memos) {
         ImGui::Text("  %s", a->text.c_str());
     }
@@ -283,6 +353,13 @@ void DrawEcamPanel(AlertManager& alerts, Sensors& sensors, PilotInput& pilot, Fa
     ImGui::PopStyleColor();
 }
 
+// Static part of the artificial horizon: the ball background. The roll scale stays dynamic
+// because the sky / ground square is drawn over part of it.
+static void PaintHorizonStatic(ImDrawList* draw_list, ImVec2 center, float radius) {
+    // Draw circle background (clipping region)
+    draw_list->AddCircleFilled(center, radius, IM_COL32(20, 20, 30, 255), 64);
+}
+
 // Helper function to draw artificial horizon
 static void DrawArtificialHorizon(ImVec2 center, float radius, float pitch_deg, float roll_deg) {
     ImDrawList* draw_list = ImGui::GetWindowDrawList();
@@ -299,9 +376,6 @@ static void DrawArtificialHorizon(ImVec2 center, float radius, float pitch_deg,
     float cos_roll = std::cos(roll_rad);
     float sin_roll = std::sin(roll_rad);
 
-    // Draw circle background (clipping region)
-    draw_list->AddCircleFilled(center, radius, IM_COL32(20, 20, 30, 255), 64);
-
     // Push clip rect for horizon
     draw_list->PushClipRect(
         ImVec2(center.x - radius, center.y - radius),
@@ -349,8 +423,11 @@ static void DrawArtificialHorizon(ImVec2 center, float radius, float pitch_deg,
         3.0f
     );
 
-    // Draw pitch ladder
-    for (int pitch_line = -30; pitch_line <= 30; pitch_line += 10) {
+    // Draw pitch ladder: only lines that can reach the clip square at any roll angle
+    float ladder_reach = radius * 1.4143f / pitch_pixels_per_deg;
+    TapeWindow ladder = visibleTicks(PITCH_LADDER, -ladder_reach - pitch_deg, ladder_reach - pitch_deg);
+    for (int i = ladder.first; i <= ladder.last; ++i) {
+        int pitch_line = (int)PITCH_LADDER.tickValue(i);
         if (pitch_line == 0) continue; // Skip horizon line
 
         float line_y = center.y + pitch_offset + pitch_line * pitch_pixels_per_deg;
@@ -397,10 +474,9 @@ static void DrawArtificialHorizon(ImVec2 center, float radius, float pitch_deg,
     draw_list->AddTriangleFilled(tri[0], tri[1], tri[2], IM_COL32(255, 255, 0, 255));
 }
 
-// Helper to draw BUSS (Backup Speed Scale) - Airbus style vertical tape
-static void DrawBUSS(ImVec2 pos, ImVec2 size, const BUSSData& buss, float current_pitch, float current_thrust) {
-    ImDrawList* draw_list = ImGui::GetWindowDrawList();
-
+// BUSS (Backup Speed Scale) - Airbus style vertical tape. Everything but the pitch and thrust
+// indicators depends only on the BUSS targets, so it lives in the PFD static layer.
+static void PaintBUSSStatic(ImDrawList* draw_list, ImVec2 pos, ImVec2 size, const BUSSData& buss) {
     // Background
     draw_list->AddRectFilled(pos, ImVec2(pos.x + size.x, pos.y + size.y), IM_COL32(10, 10, 15, 240));
 
@@ -435,29 +511,18 @@ static void DrawBUSS(ImVec2 pos, ImVec2 size, const BUSSData& buss, float curren
     );
 
     // Draw pitch scale marks
-    for (int pitch = 0; pitch <= 20; pitch += 5) {
-        float y = center_y + (5.0f - pitch) * pitch_pixels_per_deg;
-        if (y >= pos.y && y <= pos.y + size.y) {
-            draw_list->AddLine(ImVec2(pos.x + 5, y), ImVec2(pos.x + 15, y), AirbusColors::WHITE, 1.0f);
-            char pitch_label[8];
-            snprintf(pitch_label, sizeof(pitch_label), "%d°", pitch);
-            draw_list->AddText(ImVec2(pos.x + 18, y - 7), AirbusColors::WHITE, pitch_label);
+    const TapeLabels& pitch_labels = CachedLabels(s_buss_pitch_labels, BUSS_PITCH);
+    TapeWindow marks = visibleTicks(BUSS_PITCH, 5.0f - (pos.y + size.y - center_y) / pitch_pixels_per_deg,
+                                    5.0f + (center_y - pos.y) / pitch_pixels_per_deg);
+    for (int i = marks.first; i <= marks.last; ++i) {
+        float y = center_y + (5.0f - BUSS_PITCH.tickValue(i)) * pitch_pixels_per_deg;
+        draw_list->AddLine(ImVec2(pos.x + 5, y), ImVec2(pos.x + 15, y), AirbusColors::WHITE, 1.0f);
+        const char* end;
+        if (const char* label = pitch_labels.text(i, &end)) {
+            draw_list->AddText(ImVec2(pos.x + 18, y - 7), AirbusColors::WHITE, label, end);
         }
     }
 
-    // Current pitch indicator (large triangle)
-    float current_y = center_y + (5.0f - current_pitch) * pitch_pixels_per_deg;
-    current_y = clampf(current_y, pos.y + 10, pos.y + size.y - 10);
-
-    ImVec2 tri[3] = {
-        ImVec2(pos.x + size.x - 5, current_y),
-        ImVec2(pos.x + size.x - 15, current_y - 6),
-        ImVec2(pos.x + size.x - 15, current_y + 6)
-    };
-    ImU32 pitch_color = (buss.pitch_too_low || buss.pitch_too_high) ? AirbusColors::AMBER : AirbusColors::GREEN;
-    draw_list->AddTriangleFilled(tri[0], tri[1], tri[2], pitch_color);
-    draw_list->AddTriangle(tri[0], tri[1], tri[2], AirbusColors::WHITE, 2.0f);
-
     // Thrust bar on the side (vertical)
     float thrust_bar_x = pos.x + size.x + 5;
     float thrust_bar_height = size.y - 40;
@@ -485,6 +550,38 @@ static void DrawBUSS(ImVec2 pos, ImVec2 size, const BUSSData& buss, float curren
         IM_COL32(0, 150, 0, 150)
     );
 
+    // Labels
+    draw_list->AddText(ImVec2(pos.x + 5, pos.y + 5), AirbusColors::AMBER, "BUSS");
+    draw_list->AddText(ImVec2(thrust_bar_x - 5, thrust_bar_y - 15), AirbusColors::CYAN, "THR");
+
+    // Border
+    draw_list->AddRect(pos, ImVec2(pos.x + size.x, pos.y + size.y), AirbusColors::AMBER, 0.0f, 0, 2.0f);
+}
+
+// Moving part of the BUSS: current pitch and thrust
+static void DrawBUSS(ImVec2 pos, ImVec2 size, const BUSSData& buss, float current_pitch, float current_thrust) {
+    ImDrawList* draw_list = ImGui::GetWindowDrawList();
+
+    float pitch_pixels_per_deg = size.y / 30.0f;
+    float center_y = pos.y + size.y * 0.6f;
+
+    // Current pitch indicator (large triangle)
+    float current_y = center_y + (5.0f - current_pitch) * pitch_pixels_per_deg;
+    current_y = clampf(current_y, pos.y + 10, pos.y + size.y - 10);
+
+    ImVec2 tri[3] = {
+        ImVec2(pos.x + size.x - 5, current_y),
+        ImVec2(pos.x + size.x - 15, current_y - 6),
+        ImVec2(pos.x + size.x - 15, current_y + 6)
+    };
+    ImU32 pitch_color = (buss.pitch_too_low || buss.pitch_too_high) ? AirbusColors::AMBER : AirbusColors::GREEN;
+    draw_list->AddTriangleFilled(tri[0], tri[1], tri[2], pitch_color);
+    draw_list->AddTriangle(tri[0], tri[1], tri[2], AirbusColors::WHITE, 2.0f);
+
+    float thrust_bar_x = pos.x + size.x + 5;
+    float thrust_bar_height = size.y - 40;
+    float thrust_bar_y = pos.y + 20;
+
     // Current thrust indicator
     float current_thrust_y = thrust_bar_y + thrust_bar_height * (1.0f - current_thrust);
     draw_list->AddLine(
@@ -492,15 +589,14 @@ static void DrawBUSS(ImVec2 pos, ImVec2 size, const BUSSData& buss, float curren
         ImVec2(thrust_bar_x + 18, current_thrust_y),
         pitch_color, 3.0f
     );
+}
 
-    // Labels
-    draw_list->AddText(ImVec2(pos.x + 5, pos.y + 5), AirbusColors::AMBER, "BUSS");
-    char thrust_label[16];
-    snprintf(thrust_label, sizeof(thrust_label), "THR");
-    draw_list->AddText(ImVec2(thrust_bar_x - 5, thrust_bar_y - 15), AirbusColors::CYAN, thrust_label);
-
+// Speed tape frame (static layer)
+static void PaintSpeedTapeStatic(ImDrawList* draw_list, ImVec2 pos, ImVec2 size) {
+    // Background
+    draw_list->AddRectFilled(pos, ImVec2(pos.x + size.x, pos.y + size.y), IM_COL32(20, 20, 30, 230));
     // Border
-    draw_list->AddRect(pos, ImVec2(pos.x + size.x, pos.y + size.y), AirbusColors::AMBER, 0.0f, 0, 2.0f);
+    draw_list->AddRect(pos, ImVec2(pos.x + size.x, pos.y + size.y), IM_COL32(100, 100, 100, 255), 0.0f, 0, 2.0f);
 }
 
 // Helper to draw speed tape with V-speeds and colored bands
@@ -513,9 +609,6 @@ static void DrawSpeedTape(ImVec2 pos, ImVec2 size, float speed_knots, const BUSS
 
     ImDrawList* draw_list = ImGui::GetWindowDrawList();
 
-    // Background
-    draw_list->AddRectFilled(pos, ImVec2(pos.x + size.x, pos.y + size.y), IM_COL32(20, 20, 30, 230));
-
     float center_y = pos.y + size.y * 0.5f;
     float pixels_per_knot = 2.0f;
 
@@ -573,12 +666,12 @@ static void DrawSpeedTape(ImVec2 pos, ImVec2 size, float speed_knots, const BUSS
     float center_y_copy = center_y;
     float pixels_per_knot_copy = pixels_per_knot;
 
-    for (int spd = 0; spd <= 400; spd += 10) {
-        float offset_y = center_y + (speed_knots - spd) * pixels_per_knot;
-        if (offset_y < pos.y || offset_y > pos.y + size.y) continue;
-
-        bool major = (spd % 20 == 0);
-        float tick_len = major ? 15.0f : 8.0f;
+    const TapeLabels& speed_labels = CachedLabels(s_speed_labels, SPEED_SCALE);
+    TapeWindow ticks = visibleTicks(SPEED_SCALE, speed_knots - (pos.y + size.y - center_y) / pixels_per_knot,
+                                    speed_knots + (center_y - pos.y) / pixels_per_knot);
+    for (int i = ticks.first; i <= ticks.last; ++i) {
+        float offset_y = center_y + (speed_knots - SPEED_SCALE.tickValue(i)) * pixels_per_knot;
+        float tick_len = SPEED_SCALE.isMajor(i) ? 15.0f : 8.0f;
 
         draw_list->AddLine(
             ImVec2(pos.x + size.x - tick_len, offset_y),
@@ -587,10 +680,9 @@ static void DrawSpeedTape(ImVec2 pos, ImVec2 size, float speed_knots, const BUSS
             1.5f
         );
 
-        if (major && spd > 0) {
-            char label[8];
-            snprintf(label, sizeof(label), "%d", spd);
-            draw_list->AddText(ImVec2(pos.x + 5, offset_y - 7), IM_COL32(255, 255, 255, 255), label);
+        const char* end;
+        if (const char* label = speed_labels.text(i, &end)) {
+            draw_list->AddText(ImVec2(pos.x + 5, offset_y - 7), IM_COL32(255, 255, 255, 255), label, end);
         }
     }
 
@@ -694,9 +786,6 @@ static void DrawSpeedTape(ImVec2 pos, ImVec2 size, float speed_knots, const BUSS
         }
     }
 
-    // Border
-    draw_list->AddRect(pos, ImVec2(pos.x + size.x, pos.y + size.y), IM_COL32(100, 100, 100, 255), 0.0f, 0, 2.0f);
-
     // Current speed box
     ImVec2 box_pos = ImVec2(pos.x + size.x + 5, center_y - 15);
     ImVec2 box_size = ImVec2(60, 30);
@@ -717,24 +806,27 @@ static void DrawSpeedTape(ImVec2 pos, ImVec2 size, float speed_knots, const BUSS
     );
 }
 
-// Helper to draw altitude tape
-static void DrawAltitudeTape(ImVec2 pos, ImVec2 size, float altitude_ft, float vs_fpm) {
-    ImDrawList* draw_list = ImGui::GetWindowDrawList();
-
+// Altitude tape frame (static layer). The readout box overlaps the horizon, so it stays dynamic.
+static void PaintAltitudeTapeStatic(ImDrawList* draw_list, ImVec2 pos, ImVec2 size) {
     // Background
     draw_list->AddRectFilled(pos, ImVec2(pos.x + size.x, pos.y + size.y), IM_COL32(20, 20, 30, 230));
     draw_list->AddRect(pos, ImVec2(pos.x + size.x, pos.y + size.y), IM_COL32(100, 100, 100, 255), 0.0f, 0, 2.0f);
+}
+
+// Helper to draw altitude tape
+static void DrawAltitudeTape(ImVec2 pos, ImVec2 size, float altitude_ft, float vs_fpm) {
+    ImDrawList* draw_list = ImGui::GetWindowDrawList();
 
     // Draw altitude markings
     float center_y = pos.y + size.y * 0.5f;
     float pixels_per_foot = 0.1f;
 
-    for (int alt = 0; alt <= 50000; alt += 100) {
-        float offset_y = center_y + (altitude_ft - alt) * pixels_per_foot;
-        if (offset_y < pos.y || offset_y > pos.y + size.y) continue;
-
-        bool major = (alt % 500 == 0);
-        float tick_len = major ? 15.0f : 8.0f;
+    const TapeLabels& altitude_labels = CachedLabels(s_altitude_labels, ALTITUDE_SCALE);
+    TapeWindow ticks = visibleTicks(ALTITUDE_SCALE, altitude_ft - (pos.y + size.y - center_y) / pixels_per_foot,
+                                    altitude_ft + (center_y - pos.y) / pixels_per_foot);
+    for (int i = ticks.first; i <= ticks.last; ++i) {
+        float offset_y = center_y + (altitude_ft - ALTITUDE_SCALE.tickValue(i)) * pixels_per_foot;
+        float tick_len = ALTITUDE_SCALE.isMajor(i) ? 15.0f : 8.0f;
 
         draw_list->AddLine(
             ImVec2(pos.x, offset_y),
@@ -743,11 +835,10 @@ static void DrawAltitudeTape(ImVec2 pos, ImVec2 size, float altitude_ft, float v
             1.5f
         );
 
-        if (major) {
-            char label[16];
-            snprintf(label, sizeof(label), "%d", alt / 100);
-            ImVec2 text_size = ImGui::CalcTextSize(label);
-            draw_list->AddText(ImVec2(pos.x + size.x - text_size.x - 5, offset_y - 7), IM_COL32(255, 255, 255, 255), label);
+        const char* end;
+        if (const char* label = altitude_labels.text(i, &end)) {
+            float label_x = pos.x + size.x - altitude_labels.width(i) - 5;
+            draw_list->AddText(ImVec2(label_x, offset_y - 7), IM_COL32(255, 255, 255, 255), label, end);
         }
     }
 
@@ -783,7 +874,7 @@ void DrawPFDPanel(const Sensors& sensors, const PrimCore& prim, const PilotInput
     ImGui::SetNextWindowSize(ImVec2(420, 420), ImGuiCond_Once);
 
     ImGui::PushStyleColor(ImGuiCol_WindowBg, AirbusColors::DARK_BG);
-    ImGui::Begin("PRIMARY FLIGHT DISPLAY", nullptr);
+    ImGui::Begin(panelTitle(Panel::PFD), nullptr, PANEL_WINDOW_FLAGS);
 
     const auto& fctl = prim.fctl_status();
     const auto& gpws = prim.gpws_callouts();
@@ -893,8 +984,31 @@ void DrawPFDPanel(const Sensors& sensors, const PrimCore& prim, const PilotInput
         return;
     }
 
-    // Draw artificial horizon in center
     ImVec2 horizon_center = ImVec2(canvas_pos.x + canvas_size.x * 0.5f, canvas_pos.y + canvas_size.y * 0.5f - 20);
+    ImVec2 speed_tape_pos = ImVec2(canvas_pos.x + 10, canvas_pos.y + 40);
+    ImVec2 alt_tape_pos = ImVec2(canvas_pos.x + canvas_size.x - 60, canvas_pos.y + 40);
+    ImVec2 tape_size = ImVec2(50, 300);
+    const BUSSData& buss = prim.buss_data();
+    ImDrawList* draw_list = ImGui::GetWindowDrawList();
+
+    // Static layer: tape frames, horizon ball and, in BUSS mode, the BUSS scales. Repainted only
+    // when the canvas is resized or the BUSS targets change; everything after it moves.
+    uint64_t layer_key = layerKeyMix(0, buss.active ? 1u : 0u);
+    if (buss.active) {
+        layer_key = layerKeyMix(layer_key, floatBits(buss.target_pitch_min));
+        layer_key = layerKeyMix(layer_key, floatBits(buss.target_pitch_max));
+        layer_key = layerKeyMix(layer_key, floatBits(buss.target_thrust_min));
+        layer_key = layerKeyMix(layer_key, floatBits(buss.target_thrust_max));
+    }
+    if (ImDrawList* layer = s_pfd_layer.begin(draw_list, canvas_pos, canvas_size, layer_key, AirbusColors::DARK_BG)) {
+        PaintHorizonStatic(layer, horizon_center, 100.0f);
+        if (buss.active) PaintBUSSStatic(layer, speed_tape_pos, tape_size, buss);
+        else PaintSpeedTapeStatic(layer, speed_tape_pos, tape_size);
+        PaintAltitudeTapeStatic(layer, alt_tape_pos, tape_size);
+    }
+    s_pfd_layer.end(draw_list);
+
+    // Draw artificial horizon in center
     DrawArtificialHorizon(horizon_center, 100.0f, sensors.pitch_deg, sensors.roll_deg);
 
     // ========== Draw Flight Path Vector (FPV) - Green circle showing actual flight path ==========
@@ -912,8 +1026,6 @@ void DrawPFDPanel(const Sensors& sensors, const PrimCore& prim, const PilotInput
 
         // Only draw if on-screen
         if (fpv_center.y >= canvas_pos.y && fpv_center.y <= canvas_pos.y + canvas_size.y) {
-            ImDrawList* draw_list = ImGui::GetWindowDrawList();
-
             // Draw FPV symbol - green circle with horizontal wings
             draw_list->AddCircle(fpv_center, 8.0f, AirbusColors::GREEN, 16, 2.0f);
 
@@ -939,15 +1051,12 @@ void DrawPFDPanel(const Sensors& sensors, const PrimCore& prim, const PilotInput
     }
 
     // Draw speed tape on left (or BUSS if airspeed unreliable)
-    ImVec2 speed_tape_pos = ImVec2(canvas_pos.x + 10, canvas_pos.y + 40);
-    DrawSpeedTape(speed_tape_pos, ImVec2(50, 300), sensors.ias_knots, prim.buss_data(), sensors.pitch_deg, pilot.thrust, prim.vspeeds());
+    DrawSpeedTape(speed_tape_pos, tape_size, sensors.ias_knots, buss, sensors.pitch_deg, pilot.thrust, prim.vspeeds());
 
     // Draw altitude tape on right
-    ImVec2 alt_tape_pos = ImVec2(canvas_pos.x + canvas_size.x - 60, canvas_pos.y + 40);
-    DrawAltitudeTape(alt_tape_pos, ImVec2(50, 300), sensors.altitude_ft, sensors.vs_fpm);
+    DrawAltitudeTape(alt_tape_pos, tape_size, sensors.altitude_ft, sensors.vs_fpm);
 
     // Draw AoA indicator (top right)
-    ImDrawList* draw_list = ImGui::GetWindowDrawList();
     ImVec2 aoa_pos = ImVec2(canvas_pos.x + canvas_size.x - 150, canvas_pos.y + 10);
     char aoa_text[32];
     snprintf(aoa_text, sizeof(aoa_text), "AoA: %.1f°", sensors.aoa_deg);
@@ -979,9 +1088,7 @@ void DrawPFDPanel(const Sensors& sensors, const PrimCore& prim, const PilotInput
             callout_color = AirbusColors::RED;
             font_scale = 2.5f;
             // Flashing effect
-            static float blink_timer = 0.0f;
-            blink_timer += ImGui::GetIO().DeltaTime;
-            if (fmod(blink_timer, 0.5f) < 0.25f) {
+            if (BlinkPhase(PULL_UP_BLINK_SEC)) {
                 callout_color = IM_COL32(0, 0, 0, 0);  // Flash off
             }
         } else if (gpws.current_callout == "WINDSHEAR") {
@@ -1070,7 +1177,7 @@ void DrawFctlPanel(const PrimCore& prim, Faults& faults) {
     ImGui::SetNextWindowSize(ImVec2(420, 150), ImGuiCond_Once);
 
     ImGui::PushStyleColor(ImGuiCol_WindowBg, AirbusColors::DARK_BG);
-    ImGui::Begin("F/CTL STATUS", nullptr);
+    ImGui::Begin(panelTitle(Panel::FCTL), nullptr, PANEL_WINDOW_FLAGS);
 
     const auto& fctl = prim.fctl_status();
 
@@ -1131,7 +1238,7 @@ void DrawControlInputPanel(PilotInput& pilot, Sensors& sensors, Faults& faults,
     ImGui::SetNextWindowSize(ImVec2(280, 580), ImGuiCond_Once);
 
     ImGui::PushStyleColor(ImGuiCol_WindowBg, AirbusColors::DARK_BG);
-    ImGui::Begin("SENSOR OVERRIDE", nullptr);
+    ImGui::Begin(panelTitle(Panel::CONTROL_INPUT), nullptr, PANEL_WINDOW_FLAGS);
 
     TextCentered("MANUAL SENSOR CONTROL", AirbusColors::AMBER);
     ImGui::Separator();
@@ -1209,7 +1316,7 @@ void DrawAutopilotPanel(AutopilotState& ap, const Sensors& sensors) {
     ImGui::SetNextWindowSize(ImVec2(600, 120), ImGuiCond_Once);
 
     ImGui::PushStyleColor(ImGuiCol_WindowBg, AirbusColors::DARK_BG);
-    ImGui::Begin("AUTOPILOT / FCU", nullptr);
+    ImGui::Begin(panelTitle(Panel::AUTOPILOT), nullptr, PANEL_WINDOW_FLAGS);
 
     TextCentered("FCU", AirbusColors::CYAN);
     ImGui::Separator();
@@ -1374,7 +1481,7 @@ void DrawSimOperationPanel(Weather& weather, Faults& faults) {
     ImGui::SetNextWindowSize(ImVec2(350, 480), ImGuiCond_Once);
 
     ImGui::PushStyleColor(ImGuiCol_WindowBg, AirbusColors::DARK_BG);
-    ImGui::Begin("SIM OPERATION", nullptr);
+    ImGui::Begin(panelTitle(Panel::SIM_OPERATION), nullptr, PANEL_WINDOW_FLAGS);
 
     TextCentered("SIMULATION CONTROLS", AirbusColors::AMBER);
     ImGui::Separator();
@@ -1496,14 +1603,14 @@ void DrawSimOperationPanel(Weather& weather, Faults& faults) {
 // Aircraft Systems and Control Panel
 // ================================
 void DrawAircraftSystemsPanel(PilotInput& pilot, FlapsPosition& flaps, TrimSystem& trim,
-                               Speedbrakes& speedbrakes, LandingGear& gear,
+                               Speedbrakes& speedbrakes, LandingGear& gear, TimerWheel& timers,
                                HydraulicSystem& hydraulics, EngineState& engines, APUState& apu,
                                AlertManager& alerts, const AutopilotState& ap) {
     ImGui::SetNextWindowPos(ImVec2(1090, 500), ImGuiCond_Once);
     ImGui::SetNextWindowSize(ImVec2(350, 240), ImGuiCond_Once);
 
     ImGui::PushStyleColor(ImGuiCol_WindowBg, AirbusColors::DARK_BG);
-    ImGui::Begin("AIRCRAFT SYSTEMS AND CONTROL", nullptr);
+    ImGui::Begin(panelTitle(Panel::AIRCRAFT_SYSTEMS), nullptr, PANEL_WINDOW_FLAGS);
 
     TextCentered("FLIGHT CONTROLS & SYSTEMS", AirbusColors::GREEN);
     ImGui::Separator();
@@ -1594,21 +1701,17 @@ void DrawAircraftSystemsPanel(PilotInput& pilot, FlapsPosition& flaps, TrimSyste
     ImU32 gear_color = (gear.position == GearPosition::DOWN) ? AirbusColors::GREEN :
                        (gear.position == GearPosition::UP) ? AirbusColors::AMBER : AirbusColors::RED;
     ImGui::TextColored(ImColor(gear_color), "%s", gear_pos_names[(int)gear.position]);
+    if (gear.position == GearPosition::TRANSIT) {
+        ImGui::SameLine();
+        ImGui::Text("%.1fs", timers.remaining(gear.transit_timer));
+    }
 
     if (ImGui::Button("DN", ImVec2(55, 20))) {
-        if (gear.position == GearPosition::UP || gear.position == GearPosition::TRANSIT) {
-            gear.target_position = GearPosition::DOWN;
-            gear.position = GearPosition::TRANSIT;
-            gear.transit_timer = 0.0f;
-        }
+        commandGear(gear, GearPosition::DOWN, timers);
     }
     ImGui::SameLine();
     if (ImGui::Button("UP", ImVec2(55, 20))) {
-        if ((gear.position == GearPosition::DOWN || gear.position == GearPosition::TRANSIT) && !gear.weight_on_wheels) {
-            gear.target_position = GearPosition::UP;
-            gear.position = GearPosition::TRANSIT;
-            gear.transit_timer = 0.0f;
-        }
+        commandGear(gear, GearPosition::UP, timers);
     }
     ImGui::Text("WOW: %s", gear.weight_on_wheels ? "Y" : "N");
 
@@ -1726,7 +1829,183 @@ void DrawAircraftSystemsPanel(PilotInput& pilot, FlapsPosition& flaps, TrimSyste
     ImGui::PopStyleColor();
 }
 
-void DrawSystemsPanel(TrimSystem& trim, Speedbrakes& speedbrakes, LandingGear& gear, FlightPhase phase,
+// ================================
+// Scenario Script Panel
+// ================================
+bool DrawScenarioPanel(const ScenarioRunner& runner, double sim_time_sec) {
+    const Scenario* sc = runner.scenario();
+    if (!sc) return false;
+
+    ImGui::SetNextWindowPos(ImVec2(620, 600), ImGuiCond_Once);
+    ImGui::SetNextWindowSize(ImVec2(300, 120), ImGuiCond_Once);
+
+    ImGui::PushStyleColor(ImGuiCol_WindowBg, AirbusColors::DARK_BG);
+    ImGui::Begin(panelTitle(Panel::SCENARIO), nullptr, PANEL_WINDOW_FLAGS);
+
+    ImGui::TextColored(ImColor(AirbusColors::CYAN), "%s", sc->name.c_str());
+    ImGui::Text("T+%.1f s   dt %.3f s", sim_time_sec, sc->dt_sec);
+    ImGui::Text("EVENTS: %zu / %zu", runner.eventsFired(), sc->events.size());
+
+    if (runner.finished()) {
+        ImGui::TextColored(ImColor(AirbusColors::AMBER), "SCRIPT ENDED - MANUAL CONTROL");
+    } else {
+        ImGui::TextColored(ImColor(AirbusColors::GREEN), "RUNNING");
+    }
+
+    bool restart = ImGui::Button("RESTART", ImVec2(100, 20));
+
+    ImGui::End();
+    ImGui::PopStyleColor();
+    return restart;
+}
+
+// ================================
+// Rate Group Executive Panel
+// ================================
+void DrawExecutivePanel(const RateExecutive& executive, const RateGroupStats& display, const char* rt_status,
+                        const DeadlineStats* deadlines) {
+    ImGui::SetNextWindowPos(ImVec2(620, 600), ImGuiCond_Once);
+    ImGui::SetNextWindowSize(ImVec2(460, rt_status ? 165.0f : 130.0f), ImGuiCond_Once);
+
+    ImGui::PushStyleColor(ImGuiCol_WindowBg, AirbusColors::DARK_BG);
+    ImGui::Begin(panelTitle(Panel::EXECUTIVE), nullptr, PANEL_WINDOW_FLAGS);
+
+    ImGui::TextColored(ImColor(AirbusColors::CYAN), "%-9s %6s %9s %9s %6s %8s", "GROUP", "HZ", "MEAN US", "MAX US", "LOAD", "OVERRUN");
+    const RateGroupStats* groups[] = { &executive.stats(RateGroupId::DYNAMICS), &executive.stats(RateGroupId::PRIM),
+                                       &executive.stats(RateGroupId::MONITOR), &display };
+    for (const RateGroupStats* g : groups) {
+        ImU32 color = g->overruns > 0 ? AirbusColors::AMBER : AirbusColors::GREEN;
+        ImGui::TextColored(ImColor(color), "%-9s %6.0f %9.1f %9.1f %5.1f%% %8llu", g->name, g->rate_hz, g->meanMicros(),
+                           g->max_us, g->loadPercent(), (unsigned long long)g->overruns);
+    }
+
+    if (executive.droppedFrames() > 0) {
+        ImGui::TextColored(ImColor(AirbusColors::AMBER), "CATCH-UP LIMIT: %llu FRAMES DROPPED",
+                           (unsigned long long)executive.droppedFrames());
+    }
+
+    if (rt_status && deadlines) {
+        ImU32 color = deadlines->misses > 0 ? AirbusColors::AMBER : AirbusColors::GREEN;
+        ImGui::TextColored(ImColor(AirbusColors::CYAN), "%s", rt_status);
+        ImGui::TextColored(ImColor(color), "DEADLINE MISSES %llu / %llu   WORST %.0f US LATE   WAKE MAX %.0f US",
+                           (unsigned long long)deadlines->misses, (unsigned long long)deadlines->frames,
+                           deadlines->max_late_ns / 1000.0, deadlines->max_wake_ns / 1000.0);
+    }
+
+    ImGui::End();
+    ImGui::PopStyleColor();
+}
+
+// ================================
+// Parameter History (strip charts)
+// ================================
+static const float HISTORY_WINDOWS_MIN[] = {1.0f, 5.0f, 10.0f, 30.0f};
+static const char* const HISTORY_WINDOW_NAMES[] = {"1 MIN", "5 MIN", "10 MIN", "30 MIN"};
+
+void DrawHistoryPanel(const ParamHistory& history) {
+    ImGui::SetNextWindowPos(ImVec2(370, 595), ImGuiCond_Once);
+    ImGui::SetNextWindowSize(ImVec2(700, 320), ImGuiCond_Once);
+    ImGui::SetNextWindowCollapsed(true, ImGuiCond_Once);
+
+    ImGui::PushStyleColor(ImGuiCol_WindowBg, AirbusColors::DARK_BG);
+    ImGui::Begin(panelTitle(Panel::HISTORY), nullptr, PANEL_WINDOW_FLAGS);
+
+    static bool shown[(int)HistoryChannel::COUNT] = {true, true, true, true, true};
+    static int window_index = 3;
+
+    for (int c = 0; c < (int)HistoryChannel::COUNT; ++c) {
+        if (c > 0) ImGui::SameLine();
+        ImGui::Checkbox(historyChannelName((HistoryChannel)c), &shown[c]);
+    }
+    ImGui::SameLine();
+    ImGui::PushItemWidth(90);
+    ImGui::Combo("##window", &window_index, HISTORY_WINDOW_NAMES, IM_ARRAYSIZE(HISTORY_WINDOW_NAMES));
+    ImGui::PopItemWidth();
+
+    // Never wider than what the rings hold
+    float window_sec = std::min(HISTORY_WINDOWS_MIN[window_index], history.config().span_min) * 60.0f;
+
+    int shown_count = 0;
+    for (bool on : shown) shown_count += on ? 1 : 0;
+
+    ImVec2 origin = ImGui::GetCursorScreenPos();
+    ImVec2 avail = ImGui::GetContentRegionAvail();
+    const float label_width = 110.0f;
+    int columns = (int)(avail.x - label_width);
+    if (shown_count == 0 || columns < 8 || avail.y < 20.0f * shown_count) {
+        ImGui::End();
+        ImGui::PopStyleColor();
+        return;
+    }
+
+    // One [min, max] per pixel column, whatever the window length
+    HistoryRange* ranges = s_frame_arena.allocArray<HistoryRange>((size_t)columns);
+    ImDrawList* draw_list = ImGui::GetWindowDrawList();
+    float strip_height = avail.y / shown_count;
+    float y = origin.y;
+
+    for (int c = 0; c < (int)HistoryChannel::COUNT; ++c) {
+        if (!shown[c]) continue;
+        HistoryChannel channel = (HistoryChannel)c;
+        history.envelope(channel, window_sec, columns, ranges);
+
+        float lo = 0.0f, hi = 0.0f;
+        bool any = false;
+        for (int i = 0; i < columns; ++i) {
+            if (!ranges[i].valid) continue;
+            lo = any ? std::min(lo, ranges[i].min) : ranges[i].min;
+            hi = any ? std::max(hi, ranges[i].max) : ranges[i].max;
+            any = true;
+        }
+        float pad = std::max((hi - lo) * 0.1f, 0.5f);
+        lo -= pad;
+        hi += pad;
+
+        ImVec2 plot_min(origin.x + label_width, y + 2.0f);
+        ImVec2 plot_max(origin.x + label_width + columns, y + strip_height - 2.0f);
+        float plot_h = plot_max.y - plot_min.y;
+
+        char text[48];
+        draw_list->AddText(ImVec2(origin.x, y + 2.0f), AirbusColors::CYAN, historyChannelName(channel));
+        if (history.samples() > 0) {
+            std::snprintf(text, sizeof(text), "%.1f %s", history.channel(channel).latest(), historyChannelUnit(channel));
+            draw_list->AddText(ImVec2(origin.x, y + 18.0f), AirbusColors::GREEN, text);
+        }
+        if (any) {
+            std::snprintf(text, sizeof(text), (hi - lo) < 20.0f ? "%.1f..%.1f" : "%.0f..%.0f", lo + pad, hi - pad);
+            draw_list->AddText(ImVec2(origin.x, y + 34.0f), AirbusColors::WHITE, text);
+        }
+
+        draw_list->AddRectFilled(plot_min, plot_max, IM_COL32(20, 20, 30, 255));
+        draw_list->AddRect(plot_min, plot_max, IM_COL32(60, 60, 70, 255));
+        for (int i = 0; i < columns; ++i) {
+            if (!ranges[i].valid) continue;
+            float top = plot_max.y - (ranges[i].max - lo) / (hi - lo) * plot_h;
+            float bottom = plot_max.y - (ranges[i].min - lo) / (hi - lo) * plot_h;
+            float x = plot_min.x + i;
+            draw_list->AddRectFilled(ImVec2(x, top), ImVec2(x + 1.0f, std::max(bottom, top + 1.0f)), AirbusColors::GREEN);
+        }
+        y += strip_height;
+    }
+    ImGui::Dummy(avail);
+
+    ImGui::End();
+    ImGui::PopStyleColor();
+}
+
+void DrawPausedBanner() {
+    const ImGuiViewport* viewport = ImGui::GetMainViewport();
+    const char* text = "SIM PAUSED  (PAUSE / P)";
+    ImVec2 size = ImGui::CalcTextSize(text);
+    ImVec2 pos(viewport->Pos.x + (viewport->Size.x - size.x) * 0.5f, viewport->Pos.y + 8.0f);
+
+    ImDrawList* draw_list = ImGui::GetForegroundDrawList();
+    draw_list->AddRectFilled(ImVec2(pos.x - 12, pos.y - 4), ImVec2(pos.x + size.x + 12, pos.y + size.y + 4), AirbusColors::DARK_BG);
+    draw_list->AddRect(ImVec2(pos.x - 12, pos.y - 4), ImVec2(pos.x + size.x + 12, pos.y + size.y + 4), AirbusColors::AMBER);
+    draw_list->AddText(pos, AirbusColors::AMBER, text);
+}
+
+void DrawSystemsPanel(TrimSystem& trim, Speedbrakes& speedbrakes, LandingGear& gear, TimerWheel& timers, FlightPhase phase,
                       HydraulicSystem& hydraulics, EngineState& engines, Weather& weather, Faults& faults) {
     ImGui::PushStyleColor(ImGuiCol_WindowBg, IM_COL32(20, 20, 20, 255));
     ImGui::SetNextWindowSize(ImVec2(350, 580), ImGuiCond_Once);
@@ -1769,21 +2048,17 @@ void DrawSystemsPanel(TrimSystem& trim, Speedbrakes& speedbrakes, LandingGear& g
                        (gear.position == GearPosition::UP) ? AirbusColors::AMBER :
                        AirbusColors::RED;
     ImGui::TextColored(ImColor(gear_color), "Position: %s", gear_pos_names[(int)gear.position]);
+    if (gear.position == GearPosition::TRANSIT) {
+        ImGui::SameLine();
+        ImGui::Text("(%.1f s)", timers.remaining(gear.transit_timer));
+    }
 
     if (ImGui::Button("GEAR DOWN", ImVec2(100, 25))) {
-        if (gear.position == GearPosition::UP || gear.position == GearPosition::TRANSIT) {
-            gear.target_position = GearPosition::DOWN;
-            gear.position = GearPosition::TRANSIT;
-            gear.transit_timer = 0.0f;
-        }
+        commandGear(gear, GearPosition::DOWN, timers);
     }
     ImGui::SameLine();
     if (ImGui::Button("GEAR UP", ImVec2(100, 25))) {
-        if ((gear.position == GearPosition::DOWN || gear.position == GearPosition::TRANSIT) && !gear.weight_on_wheels) {
-            gear.target_position = GearPosition::UP;
-            gear.position = GearPosition::TRANSIT;
-            gear.transit_timer = 0.0f;
-        }
+        commandGear(gear, GearPosition::UP, timers);
     }
     ImGui::Text("Weight on Wheels: %s", gear.weight_on_wheels ? "YES" : "NO");
 
@@ -1853,3 +2128,56 @@ void DrawSystemsPanel(TrimSystem& trim, Speedbrakes& speedbrakes, LandingGear& g
     ImGui::End();
     ImGui::PopStyleColor();
 }
+
+// ========== Panel Versions ==========
+// What each scheduled panel shows, at the precision it prints it
+
+static void AddShownAlerts(PanelVersion& version, const AlertManager& alerts) {
+    for (const auto& a : alerts.all()) {
+        if (!(a.active || a.latched)) continue;
+        version.add((uint64_t)a.id).add((uint64_t)a.level).add(a.text.c_str()).add((uint64_t)a.ecam_actions.size());
+    }
+}
+
+uint64_t MasterPanelVersion(const AlertManager& alerts) {
+    bool mw = alerts.masterWarningOn();
+    bool mc = alerts.masterCautionOn();
+    PanelVersion version;
+    version.add((uint64_t)mw).add((uint64_t)mc);
+    if (mw || mc) version.add((uint64_t)BlinkPhase(MASTER_BLINK_SEC));
+    return version.value();
+}
+
+uint64_t EcamPanelVersion(const AlertManager& alerts, const PrimCore& prim, FlapsPosition flaps,
+                          const EngineState& engines, const APUState& apu) {
+    const auto& eng = prim.engine_data();
+    PanelVersion version;
+    version.add(eng.n1_percent, 0.1f).add(eng.n2_percent, 0.1f).add(eng.egt_c, 1.0f).add(eng.fuel_flow, 1.0f);
+    version.add((uint64_t)engines.engine1_fire).add((uint64_t)engines.engine2_fire).add((uint64_t)apu.fire);
+    version.add((uint64_t)engines.engine1_squib_released).add((uint64_t)engines.engine2_squib_released).add((uint64_t)apu.squib_released);
+    version.add((uint64_t)flaps);
+    AddShownAlerts(version, alerts);
+    return version.value();
+}
+
+uint64_t FctlPanelVersion(const PrimCore& prim, const Faults& faults) {
+    const auto& fctl = prim.fctl_status();
+    const auto& surf = prim.surfaces();
+    PanelVersion version;
+    version.add((uint64_t)fctl.law).add((uint64_t)fctl.elac1_avail).add((uint64_t)fctl.elac2_avail).add((uint64_t)fctl.sec1_avail);
+    version.add((uint64_t)fctl.alpha_prot).add((uint64_t)fctl.alpha_floor).add((uint64_t)fctl.high_speed_prot);
+    version.add(surf.elevator_deg, 0.1f).add(surf.aileron_deg, 0.1f);
+    version.add((uint64_t)faults.elevator_jam).add((uint64_t)faults.aileron_jam);
+    return version.value();
+}
+
+uint64_t PFDPanelVersion(const Sensors& sensors, const PrimCore& prim, const PilotInput& pilot, const AutopilotState& ap,
+                         const Faults& faults) {
+    const auto& gpws = prim.gpws_callouts();
+    PanelVersion version;
+    version.addBytes(sensors).addBytes(pilot).addBytes(ap).addBytes(faults);
+    version.addBytes(prim.fctl_status()).addBytes(prim.buss_data()).addBytes(prim.vspeeds());
+    version.add(gpws.current_callout.c_str());
+    if (gpws.current_callout == "PULL UP") version.add((uint64_t)BlinkPhase(PULL_UP_BLINK_SEC));
+    return version.value();
+}
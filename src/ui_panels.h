@@ -6,6 +6,16 @@
 #include "alerts.h"
 #include "sim_types.h"
 #include "prim_core.h"
+#include "scenario.h"
+#include "realtime.h"
+
+class ParamHistory;
+
+// Call once per frame right after ImGui::NewFrame() (resets per-frame UI scratch memory)
+void BeginUiFrame();
+// Clock for blinking elements. Offline renders pass sim time so every frame is reproducible;
+// a negative value (the default) goes back to the wall clock.
+void SetUiTime(double now_sec);
 
 void DrawMasterPanel(AlertManager& alerts);
 void DrawEcamPanel(AlertManager& alerts, Sensors& sensors, PilotInput& pilot, Faults& faults, const PrimCore& prim, FlapsPosition flaps, EngineState& engines, APUState& apu);
@@ -15,9 +25,28 @@ void DrawControlInputPanel(PilotInput& pilot, Sensors& sensors, Faults& faults,
 void DrawAutopilotPanel(AutopilotState& ap, const Sensors& sensors);
 void DrawSimOperationPanel(Weather& weather, Faults& faults);
 void DrawAircraftSystemsPanel(PilotInput& pilot, FlapsPosition& flaps, TrimSystem& trim,
-                               Speedbrakes& speedbrakes, LandingGear& gear,
+                               Speedbrakes& speedbrakes, LandingGear& gear, TimerWheel& timers,
                                HydraulicSystem& hydraulics, EngineState& engines, APUState& apu,
                                AlertManager& alerts, const AutopilotState& ap);
+// Scenario script progress; returns true when RESTART is pressed
+bool DrawScenarioPanel(const ScenarioRunner& runner, double sim_time_sec);
+// Per rate group timing and overruns, plus the UI's own frame against the display refresh.
+// In real-time mode also the RT setup and frame deadline misses (both nullptr otherwise).
+void DrawExecutivePanel(const RateExecutive& executive, const RateGroupStats& display, const char* rt_status,
+                        const DeadlineStats* deadlines);
+// Strip charts of the recorded parameter history (any window, drawn per pixel column)
+void DrawHistoryPanel(const ParamHistory& history);
+// Foreground notice while the sim is paused
+void DrawPausedBanner();
+
+// Data versions for the panel scheduler: each changes whenever what the panel shows changes
+uint64_t MasterPanelVersion(const AlertManager& alerts);
+uint64_t EcamPanelVersion(const AlertManager& alerts, const PrimCore& prim, FlapsPosition flaps,
+                          const EngineState& engines, const APUState& apu);
+uint64_t FctlPanelVersion(const PrimCore& prim, const Faults& faults);
+uint64_t PFDPanelVersion(const Sensors& sensors, const PrimCore& prim, const PilotInput& pilot, const AutopilotState& ap,
+                         const Faults& faults);
+
 // Deprecated - use DrawSimOperationPanel and DrawAircraftSystemsPanel instead
-void DrawSystemsPanel(TrimSystem& trim, Speedbrakes& speedbrakes, LandingGear& gear, FlightPhase phase,
+void DrawSystemsPanel(TrimSystem& trim, Speedbrakes& speedbrakes, LandingGear& gear, TimerWheel& timers, FlightPhase phase,
                       HydraulicSystem& hydraulics, EngineState& engines, Weather& weather, Faults& faults);
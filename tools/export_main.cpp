@@ -0,0 +1,237 @@
+//
+//
+// Santiago Quintana Moreno A01571222
+// Created on: 18/10/2026.
+//
+// PRIM_export - offscreen frame export.
+// Replays a scenario script and renders the display panels at a fixed frame rate through
+// SDL's software renderer into a memory surface: no window, display or GPU involved, so it
+// runs on a headless CI box. Each frame is read back and handed to a pool of encoder threads
+// that write numbered PNG or QOI files, e.g. for a debrief video:
+//
+//   ffmpeg -framerate 30 -i out/frame_%06d.png -pix_fmt yuv420p debrief.mp4
+//
+// UI time follows sim time (blinking warnings included), so the same script gives the same
+// frames on every run.
+#include <SDL2/SDL.h>
+#include "imgui.h"
+#include "backends/imgui_impl_sdlrenderer2.h"
+#include "frame_export.h"
+#include "scenario.h"
+#include "sim_state.h"
+#include "static_layer.h"
+#include "ui_panels.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+static void printUsage() {
+    std::fprintf(stderr,
+        "usage: PRIM_export <scenario.scn> --out DIR [options]\n"
+        "  --out DIR         output directory (created if missing)\n"
+        "  --format F        qoi or png (default png)\n"
+        "  --fps HZ          frames per second of sim time (default 30)\n"
+        "  --duration SEC    stop after SEC of sim time (default: end of the script)\n"
+        "  --panels LIST     comma list of master,ecam,pfd,fctl (default pfd,ecam,master)\n"
+        "  --size WxH        frame size (default 1300x730, the sim window)\n"
+        "  --threads N       encoder threads (default: cores - 1)\n"
+        "  --queue N         frames in flight before replay waits (default threads + 1)\n");
+}
+
+enum ExportPanel : uint32_t {
+    EXPORT_MASTER = 1u << 0,
+    EXPORT_ECAM = 1u << 1,
+    EXPORT_PFD = 1u << 2,
+    EXPORT_FCTL = 1u << 3,
+};
+
+static bool parsePanels(const char* spec, uint32_t& mask) {
+    static const struct { const char* name; uint32_t bit; } NAMES[] = {
+        {"master", EXPORT_MASTER}, {"ecam", EXPORT_ECAM}, {"pfd", EXPORT_PFD}, {"fctl", EXPORT_FCTL},
+    };
+    mask = 0;
+    std::string list = spec;
+    size_t start = 0;
+    while (start <= list.size()) {
+        size_t end = list.find(',', start);
+        if (end == std::string::npos) end = list.size();
+        std::string name = list.substr(start, end - start);
+        bool known = false;
+        for (const auto& n : NAMES) {
+            if (name == n.name) {
+                mask |= n.bit;
+                known = true;
+            }
+        }
+        if (!known) return false;
+        start = end + 1;
+    }
+    return mask != 0;
+}
+
+int main(int argc, char** argv) {
+    const char* scenario_path = nullptr;
+    const char* out_dir = nullptr;
+    ImageFormat format = ImageFormat::PNG;
+    double fps = 30.0;
+    double duration_sec = -1.0;
+    uint32_t panels = EXPORT_PFD | EXPORT_ECAM | EXPORT_MASTER;
+    int width = 1300;
+    int height = 730;
+    int threads = 0;
+    int queue = 0;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        if (std::strcmp(arg, "--help") == 0) { printUsage(); return 0; }
+        if (std::strncmp(arg, "--", 2) != 0) {
+            scenario_path = arg;
+            continue;
+        }
+
+        const char* val = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (!val) { printUsage(); return 1; }
+
+        if (std::strcmp(arg, "--out") == 0) {
+            out_dir = val;
+        } else if (std::strcmp(arg, "--format") == 0) {
+            if (!parseImageFormat(val, format)) { printUsage(); return 1; }
+        } else if (std::strcmp(arg, "--fps") == 0) {
+            fps = std::max(1.0, std::atof(val));
+        } else if (std::strcmp(arg, "--duration") == 0) {
+            duration_sec = std::atof(val);
+        } else if (std::strcmp(arg, "--panels") == 0) {
+            if (!parsePanels(val, panels)) { printUsage(); return 1; }
+        } else if (std::strcmp(arg, "--size") == 0) {
+            if (std::sscanf(val, "%dx%d", &width, &height) != 2 || width < 320 || height < 240) { printUsage(); return 1; }
+        } else if (std::strcmp(arg, "--threads") == 0) {
+            threads = std::atoi(val);
+        } else if (std::strcmp(arg, "--queue") == 0) {
+            queue = std::max(1, std::atoi(val));
+        } else {
+            printUsage();
+            return 1;
+        }
+        ++i;
+    }
+    if (!scenario_path || !out_dir) {
+        printUsage();
+        return 1;
+    }
+
+    Scenario script;
+    std::string error;
+    if (!loadScenarioFile(scenario_path, script, error)) {
+        std::fprintf(stderr, "%s\n", error.c_str());
+        return 1;
+    }
+
+    SimState sim;
+    ScenarioRunner runner;
+    if (!runner.start(script, sim, error)) {
+        std::fprintf(stderr, "PRIM_export: %s\n", error.c_str());
+        return 1;
+    }
+
+    FrameEncoderPool encoders;
+    if (!encoders.start(out_dir, format, width, height, threads, queue, error)) {
+        std::fprintf(stderr, "PRIM_export: %s\n", error.c_str());
+        return 1;
+    }
+
+    // No subsystems: the software renderer only needs a surface to draw into
+    if (SDL_Init(0) != 0) {
+        std::fprintf(stderr, "PRIM_export: SDL_Init: %s\n", SDL_GetError());
+        return 1;
+    }
+    SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormat(0, width, height, 32, SDL_PIXELFORMAT_RGBA32);
+    SDL_Renderer* renderer = surface ? SDL_CreateSoftwareRenderer(surface) : nullptr;
+    if (!renderer) {
+        std::fprintf(stderr, "PRIM_export: software renderer: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    IMGUI_CHECKVERSION();
+    ImGui::CreateContext();
+    ImGui::StyleColorsDark();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = nullptr;
+    io.DisplaySize = ImVec2((float)width, (float)height);
+    io.DeltaTime = (float)(1.0 / fps);
+    ImGui_ImplSDLRenderer2_Init(renderer);
+    SetStaticLayerRenderer(renderer);
+
+    const double frame_sec = 1.0 / fps;
+    const double start_sec = sim.time_sec;
+    const double end_sec = duration_sec >= 0.0 ? start_sec + duration_sec : 1e300;
+
+    auto wall_start = std::chrono::steady_clock::now();
+    uint64_t frame = 0;
+    bool more = true;
+    bool read_failed = false;
+    while (more) {
+        // Sim up to this frame's time at the script's own dt, as PRIM_run and PRIM_sim do
+        double frame_time = start_sec + (double)frame * frame_sec;
+        if (frame_time > end_sec) break;
+        while (sim.time_sec + script.dt_sec * 0.5 < frame_time) {
+            if (!runner.step(sim)) {
+                more = false;
+                break;
+            }
+        }
+
+        SetUiTime(sim.time_sec);
+        ImGui_ImplSDLRenderer2_NewFrame();
+        ImGui::NewFrame();
+        BeginUiFrame();
+        if (panels & EXPORT_MASTER) DrawMasterPanel(sim.alerts);
+        if (panels & EXPORT_ECAM) DrawEcamPanel(sim.alerts, sim.sensors, sim.pilot, sim.faults, sim.prim, sim.flaps, sim.engines, sim.apu);
+        if (panels & EXPORT_PFD) DrawPFDPanel(sim.sensors, sim.prim, sim.pilot, sim.autopilot, sim.faults);
+        if (panels & EXPORT_FCTL) DrawFctlPanel(sim.prim, sim.faults);
+        ImGui::Render();
+
+        SDL_SetRenderDrawColor(renderer, 12, 12, 12, 255);
+        SDL_RenderClear(renderer);
+        ImGui_ImplSDLRenderer2_RenderDrawData(ImGui::GetDrawData(), renderer);
+
+        // Read back into a pool buffer and move on; encoding overlaps the next frames
+        uint8_t* pixels = encoders.acquire();
+        if (SDL_RenderReadPixels(renderer, nullptr, SDL_PIXELFORMAT_RGBA32, pixels, width * 4) != 0) {
+            std::fprintf(stderr, "PRIM_export: read back: %s\n", SDL_GetError());
+            encoders.release(pixels);
+            read_failed = true;
+            break;
+        }
+        encoders.submit(pixels, frame);
+        ++frame;
+    }
+    double replay_sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - wall_start).count();
+
+    encoders.finish();
+    double total_sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - wall_start).count();
+    ExportStats stats = encoders.stats();
+
+    std::printf("%llu frames (%.1f s of sim time at %.0f fps), %dx%d %s -> %s\n", (unsigned long long)stats.frames,
+                (double)frame * frame_sec, fps, width, height, imageExtension(format), out_dir);
+    std::printf("replay %.2f s (%.0f frames/s), total %.2f s, %.1f MB written\n", replay_sec,
+                replay_sec > 0.0 ? (double)frame / replay_sec : 0.0, total_sec, (double)stats.bytes / (1024.0 * 1024.0));
+    std::printf("encoders: %d threads, %.1f ms/frame, replay waited for a buffer %llu times\n", encoders.threads(),
+                stats.frames ? stats.encode_sec * 1000.0 / (double)stats.frames : 0.0, (unsigned long long)stats.producer_waits);
+
+    ReleaseStaticLayers();
+    ImGui_ImplSDLRenderer2_Shutdown();
+    ImGui::DestroyContext();
+    SDL_DestroyRenderer(renderer);
+    SDL_FreeSurface(surface);
+    SDL_Quit();
+
+    if (stats.write_errors) {
+        std::fprintf(stderr, "PRIM_export: %llu frames could not be written\n", (unsigned long long)stats.write_errors);
+        return 1;
+    }
+    return read_failed ? 1 : 0;
+}
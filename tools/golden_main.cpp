@@ -0,0 +1,183 @@
+//
+//
+// Santiago Quintana Moreno A01571222
+// Created on: 18/10/2026.
+//
+// PRIM_golden - golden-trajectory regression suite.
+// Replays every scenario with a golden trace in parallel and fails on the first channel that
+// leaves its tolerance. --update re-records the traces after an intended behaviour change;
+// --record adds a new one.
+#include "golden_trace.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+static void printUsage() {
+    std::fprintf(stderr,
+        "usage: PRIM_golden [file.golden...] [options]\n"
+        "  --dir DIR          check every *.golden in DIR (default scenarios/golden, used without files)\n"
+        "  --update           re-record the golden traces instead of checking them\n"
+        "  --record SCN OUT   record a new golden trace OUT for scenario SCN\n"
+        "  --every N          sample spacing in steps for --record (default 25)\n"
+        "  --duration SEC     simulated seconds for --record (default 300)\n"
+        "  --threads N        worker threads (default: hardware threads)\n");
+}
+
+static int recordNew(const char* scenario_path, const char* out_path, int every, float duration) {
+    std::string error;
+    Scenario scenario;
+    if (!loadScenarioFile(scenario_path, scenario, error)) {
+        std::fprintf(stderr, "%s\n", error.c_str());
+        return 1;
+    }
+
+    GoldenTrace trace;
+    namespace fs = std::filesystem;
+    fs::path out_dir = fs::absolute(out_path).parent_path();
+    trace.scenario_path = fs::relative(fs::absolute(scenario_path), out_dir).generic_string();
+    trace.every = every;
+    trace.duration_sec = duration;
+    if (!recordGoldenTrace(scenario, trace, error) || !saveGoldenTrace(out_path, trace, error)) {
+        std::fprintf(stderr, "%s\n", error.c_str());
+        return 1;
+    }
+    std::printf("recorded %s: %zu samples, %.2f s\n", out_path, trace.samples.size(),
+                trace.samples.empty() ? 0.0 : trace.samples.back().time_sec);
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    std::vector<std::string> paths;
+    const char* dir = "scenarios/golden";
+    bool update = false;
+    const char* record_scenario = nullptr;
+    const char* record_out = nullptr;
+    int every = 25;
+    float duration = 300.0f;
+    int threads = 0;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        if (std::strcmp(arg, "--help") == 0) { printUsage(); return 0; }
+        if (std::strcmp(arg, "--update") == 0) { update = true; continue; }
+        if (std::strncmp(arg, "--", 2) != 0) {
+            paths.push_back(arg);
+            continue;
+        }
+
+        const char* val = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (!val) { printUsage(); return 1; }
+
+        if (std::strcmp(arg, "--record") == 0) {
+            if (i + 2 >= argc) { printUsage(); return 1; }
+            record_scenario = val;
+            record_out = argv[i + 2];
+            i += 2;
+            continue;
+        }
+
+        if (std::strcmp(arg, "--dir") == 0) {
+            dir = val;
+        } else if (std::strcmp(arg, "--every") == 0) {
+            every = std::max(1, std::atoi(val));
+        } else if (std::strcmp(arg, "--duration") == 0) {
+            duration = (float)std::atof(val);
+        } else if (std::strcmp(arg, "--threads") == 0) {
+            threads = std::atoi(val);
+        } else {
+            printUsage();
+            return 1;
+        }
+        ++i;
+    }
+
+    if (record_scenario) return recordNew(record_scenario, record_out, every, duration);
+
+    if (paths.empty()) {
+        std::error_code ec;
+        for (const auto& entry : std::filesystem::directory_iterator(dir, ec)) {
+            if (entry.path().extension() == ".golden") paths.push_back(entry.path().string());
+        }
+        if (ec) {
+            std::fprintf(stderr, "cannot list %s: %s\n", dir, ec.message().c_str());
+            return 1;
+        }
+        std::sort(paths.begin(), paths.end());
+    }
+    if (paths.empty()) {
+        std::fprintf(stderr, "no golden traces found\n");
+        return 1;
+    }
+
+    std::vector<GoldenCase> cases(paths.size());
+    for (size_t i = 0; i < paths.size(); ++i) {
+        std::string error;
+        if (!loadGoldenCase(paths[i].c_str(), cases[i], error)) {
+            std::fprintf(stderr, "%s\n", error.c_str());
+            return 1;
+        }
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<GoldenResult> results = runGoldenSuite(cases, threads);
+    double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    int failed = 0;
+    for (size_t i = 0; i < cases.size(); ++i) {
+        const GoldenCase& c = cases[i];
+        const GoldenResult& r = results[i];
+
+        if (!r.error.empty()) {
+            ++failed;
+            std::printf("FAIL  %-36s %s\n", c.scenario.name.c_str(), r.error.c_str());
+            continue;
+        }
+
+        if (update) {
+            std::string error;
+            if (!saveGoldenTrace(c.golden_path.c_str(), r.actual, error)) {
+                std::fprintf(stderr, "%s\n", error.c_str());
+                return 1;
+            }
+            std::printf("UPDATED %-36s %5zu samples%s\n", c.golden_path.c_str(), r.actual.samples.size(),
+                        r.comparison.passed ? " (unchanged within tolerance)" : "");
+            continue;
+        }
+
+        const GoldenComparison& cmp = r.comparison;
+        if (cmp.passed) {
+            std::printf("PASS  %-36s %5zu samples  %6.2f s\n", c.scenario.name.c_str(), cmp.samples_compared, r.wall_sec);
+            continue;
+        }
+
+        ++failed;
+        std::printf("FAIL  %-36s first divergence at step %ld (t=%.2f s): %s ", c.scenario.name.c_str(), cmp.step,
+                    cmp.time_sec, goldenChannelName(cmp.channel));
+        if (cmp.channel == GoldenChannel::ALERTS) {
+            std::printf("expected %016llx got %016llx\n", (unsigned long long)cmp.expected, (unsigned long long)cmp.actual);
+        } else if (cmp.channel == GoldenChannel::LENGTH) {
+            std::printf("golden ends at step %.0f, run ends at step %.0f\n", cmp.expected, cmp.actual);
+        } else if (cmp.channel == GoldenChannel::LAW) {
+            std::printf("expected %.0f got %.0f\n", cmp.expected, cmp.actual);
+        } else {
+            std::printf("expected %.6g got %.6g (tol %g)\n", cmp.expected, cmp.actual, c.golden.tolerance[(int)cmp.channel]);
+        }
+        std::printf("      %zu of %zu samples out of tolerance; max error:", cmp.samples_diverged, cmp.samples_compared);
+        for (int ch = 0; ch < GOLDEN_NUMERIC_CHANNELS; ++ch) {
+            if (cmp.max_error[ch] > c.golden.tolerance[ch]) std::printf(" %s %.4g", goldenChannelName((GoldenChannel)ch), cmp.max_error[ch]);
+        }
+        std::printf("\n");
+    }
+
+    if (!update) {
+        std::printf("%zu scenarios, %d failed, %.2f s\n", cases.size(), failed, wall);
+    } else if (failed) {
+        std::printf("%d scenarios could not start and were not updated\n", failed);
+    }
+    return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,248 @@
+//
+//
+// Santiago Quintana Moreno A01571222
+// Created on: 18/10/2026.
+//
+// PRIM_inject - stand-in for hardware-in-the-loop input devices.
+// Feeds the sim's input injection ring and, with the live state export, measures
+// input-to-apply and input-to-surface latency. Needs only PRIM_live.
+#include "input_ring.h"
+#include "live_state.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+static void printUsage() {
+    std::fprintf(stderr,
+        "usage: PRIM_inject [mode] [options]\n"
+        "modes:\n"
+        "  --steps N          send N alternating pitch steps and report latency (default mode, N=20)\n"
+        "  --stream HZ        stream a sinusoidal stick input at HZ commands per second\n"
+        "  --fault NAME on|off   toggle one fault and exit\n"
+        "  --fcu FIELD VALUE  set one FCU value and exit (spd hdg alt vs spd_mode hdg_mode alt_mode\n"
+        "                     vs_mode athr; modes take 0/1)\n"
+        "options:\n"
+        "  --ring NAME        input ring (default /prim_input)\n"
+        "  --shm NAME         live state export to watch (default /prim_live)\n"
+        "  --period MS        time between pitch steps (default 500)\n"
+        "  --amplitude A      stick deflection for steps / stream (default 0.3)\n"
+        "  --thrust T         thrust lever sent with stick commands (default 0.6)\n"
+        "  --duration SEC     stream length (default 10)\n"
+        "  --threshold DEG    elevator movement that counts as a surface response (default 0.2)\n");
+}
+
+static bool fcuFieldFromName(const char* name, FcuField& out) {
+    static const struct { const char* name; FcuField field; } fields[] = {
+        { "spd", FcuField::SPEED_KNOTS }, { "hdg", FcuField::HEADING_DEG },
+        { "alt", FcuField::ALTITUDE_FT }, { "vs", FcuField::VS_FPM },
+        { "spd_mode", FcuField::SPD_MODE }, { "hdg_mode", FcuField::HDG_MODE },
+        { "alt_mode", FcuField::ALT_MODE }, { "vs_mode", FcuField::VS_MODE },
+        { "athr", FcuField::AUTOTHRUST },
+    };
+    for (const auto& f : fields) {
+        if (std::strcmp(f.name, name) == 0) {
+            out = f.field;
+            return true;
+        }
+    }
+    return false;
+}
+
+static double usec(uint64_t from_ns, uint64_t to_ns) {
+    return to_ns >= from_ns ? (double)(to_ns - from_ns) / 1000.0 : 0.0;
+}
+
+static void printLatency(const char* label, std::vector<double>& v) {
+    if (v.empty()) {
+        std::printf("%-20s no samples\n", label);
+        return;
+    }
+    std::sort(v.begin(), v.end());
+    std::printf("%-20s n=%-4zu min %9.1f us   p50 %9.1f us   max %9.1f us\n",
+                label, v.size(), v.front(), v[v.size() / 2], v.back());
+}
+
+// Alternating pitch steps; waits for each to show up on the elevator before sending the next
+static int runSteps(InputRingProducer& ring, LiveStateReader& live, int steps, int period_ms,
+                    float amplitude, float thrust, float threshold_deg) {
+    std::vector<double> apply_us, publish_us, surface_us;
+    LiveStateFrame f;
+
+    for (int i = 0; i < steps; ++i) {
+        float elevator_before = live.read(f) ? f.surfaces.elevator_deg : 0.0f;
+
+        InputCommand cmd;
+        cmd.type = InputCommandType::PILOT;
+        cmd.values[0] = (i % 2 == 0) ? amplitude : -amplitude;
+        cmd.values[2] = thrust;
+        if (!ring.push(cmd)) {
+            std::fprintf(stderr, "PRIM_inject: ring full\n");
+            return 1;
+        }
+
+        bool applied = false;
+        bool moved = false;
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+        while (!(applied && moved) && std::chrono::steady_clock::now() < deadline) {
+            if (live.read(f) && f.input_seq >= cmd.seq) {
+                if (!applied) {
+                    applied = true;
+                    apply_us.push_back(usec(cmd.sent_ns, f.input_applied_ns));
+                    publish_us.push_back(usec(cmd.sent_ns, f.published_ns));
+                }
+                if (std::fabs(f.surfaces.elevator_deg - elevator_before) >= threshold_deg) {
+                    moved = true;
+                    surface_us.push_back(usec(cmd.sent_ns, f.published_ns));
+                }
+            }
+            if (!(applied && moved)) std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }
+        if (!applied) std::fprintf(stderr, "PRIM_inject: command %llu never applied\n", (unsigned long long)cmd.seq);
+        else if (!moved) std::fprintf(stderr, "PRIM_inject: command %llu moved no surface\n", (unsigned long long)cmd.seq);
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(period_ms));
+    }
+
+    std::printf("latency from send (monotonic clock, same host):\n");
+    printLatency("  applied by sim", apply_us);
+    printLatency("  published", publish_us);
+    printLatency("  elevator moved", surface_us);
+    return 0;
+}
+
+static int runStream(InputRingProducer& ring, double hz, double duration_sec, float amplitude, float thrust) {
+    const auto period = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(1.0 / hz));
+    const long count = (long)(hz * duration_sec);
+
+    long rejected = 0;
+    auto start = std::chrono::steady_clock::now();
+    auto next = start;
+    for (long i = 0; i < count; ++i) {
+        double t = (double)i / hz;
+        InputCommand cmd;
+        cmd.type = InputCommandType::PILOT;
+        cmd.values[0] = amplitude * (float)std::sin(2.0 * 3.14159265358979 * 0.2 * t);
+        cmd.values[1] = 0.5f * amplitude * (float)std::sin(2.0 * 3.14159265358979 * 0.13 * t);
+        cmd.values[2] = thrust;
+        if (!ring.push(cmd)) ++rejected;
+
+        next += period;
+        std::this_thread::sleep_until(next);
+    }
+
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::printf("sent %ld commands in %.2f s (%.0f/s), %ld rejected (ring full)\n",
+                count - rejected, elapsed, (double)count / elapsed, rejected);
+    return rejected == 0 ? 0 : 1;
+}
+
+int main(int argc, char** argv) {
+    const char* ring_name = INPUT_RING_DEFAULT_NAME;
+    const char* shm_name = LIVE_STATE_DEFAULT_NAME;
+    int steps = 20;
+    double stream_hz = 0.0;
+    const char* fault_name = nullptr;
+    const char* fault_state = nullptr;
+    const char* fcu_name = nullptr;
+    float fcu_value = 0.0f;
+    int period_ms = 500;
+    float amplitude = 0.3f;
+    float thrust = 0.6f;
+    double duration = 10.0;
+    float threshold = 0.2f;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const char* val = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (std::strcmp(arg, "--help") == 0) { printUsage(); return 0; }
+        if (!val) { printUsage(); return 1; }
+
+        if (std::strcmp(arg, "--fault") == 0 || std::strcmp(arg, "--fcu") == 0) {
+            if (i + 2 >= argc) { printUsage(); return 1; }
+            if (std::strcmp(arg, "--fault") == 0) {
+                fault_name = val;
+                fault_state = argv[i + 2];
+            } else {
+                fcu_name = val;
+                fcu_value = (float)std::atof(argv[i + 2]);
+            }
+            i += 2;
+            continue;
+        }
+
+        if (std::strcmp(arg, "--steps") == 0) {
+            steps = std::atoi(val);
+        } else if (std::strcmp(arg, "--stream") == 0) {
+            stream_hz = std::atof(val);
+        } else if (std::strcmp(arg, "--ring") == 0) {
+            ring_name = val;
+        } else if (std::strcmp(arg, "--shm") == 0) {
+            shm_name = val;
+        } else if (std::strcmp(arg, "--period") == 0) {
+            period_ms = std::max(0, std::atoi(val));
+        } else if (std::strcmp(arg, "--amplitude") == 0) {
+            amplitude = (float)std::atof(val);
+        } else if (std::strcmp(arg, "--thrust") == 0) {
+            thrust = (float)std::atof(val);
+        } else if (std::strcmp(arg, "--duration") == 0) {
+            duration = std::atof(val);
+        } else if (std::strcmp(arg, "--threshold") == 0) {
+            threshold = (float)std::atof(val);
+        } else {
+            printUsage();
+            return 1;
+        }
+        ++i;
+    }
+
+    InputRingProducer ring;
+    std::string error;
+    if (!ring.open(ring_name, error)) {
+        std::fprintf(stderr, "PRIM_inject: %s\n", error.c_str());
+        return 1;
+    }
+
+    // One-shot commands
+    if (fault_name || fcu_name) {
+        InputCommand cmd;
+        if (fault_name) {
+            FaultId id;
+            if (!faultFromName(fault_name, id)) {
+                std::fprintf(stderr, "PRIM_inject: unknown fault '%s'\n", fault_name);
+                return 1;
+            }
+            cmd.type = InputCommandType::FAULT;
+            cmd.index = (uint16_t)id;
+            cmd.values[0] = std::strcmp(fault_state, "on") == 0 ? 1.0f : 0.0f;
+        } else {
+            FcuField field;
+            if (!fcuFieldFromName(fcu_name, field)) {
+                std::fprintf(stderr, "PRIM_inject: unknown FCU field '%s'\n", fcu_name);
+                return 1;
+            }
+            cmd.type = InputCommandType::FCU;
+            cmd.index = (uint16_t)field;
+            cmd.values[0] = fcu_value;
+        }
+        if (!ring.push(cmd)) {
+            std::fprintf(stderr, "PRIM_inject: ring full\n");
+            return 1;
+        }
+        return 0;
+    }
+
+    if (stream_hz > 0.0) return runStream(ring, stream_hz, duration, amplitude, thrust);
+
+    LiveStateReader live;
+    if (!live.open(shm_name, error)) {
+        std::fprintf(stderr, "PRIM_inject: latency probe needs the live state export: %s\n", error.c_str());
+        return 1;
+    }
+    return runSteps(ring, live, steps, period_ms, amplitude, thrust, threshold);
+}
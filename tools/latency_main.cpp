@@ -0,0 +1,185 @@
+//
+//
+// Santiago Quintana Moreno A01571222
+// Created on: 18/10/2026.
+//
+// PRIM_latency - worst-case step latency harness.
+// Plays scenarios headless for millions of steps, records every PrimCore::update and every
+// full step (phase, PRIM, dynamics, GPWS, timers) in HDR-style histograms and reports tail
+// percentiles. Any step over the deadline is flagged and fails the run, so it can serve as a
+// WCET acceptance gate (run it with --rt on an isolated core).
+#include "scenario.h"
+#include "rate_executive.h"
+#include "latency_histogram.h"
+#include "realtime.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+static void printUsage() {
+    std::fprintf(stderr,
+        "usage: PRIM_latency <scenario.scn>... [options]\n"
+        "  --steps N          timed steps per scenario (default 1000000)\n"
+        "  --warmup N         untimed steps before measuring (default 2000)\n"
+        "  --deadline-us US   flag steps that take longer (default 500)\n"
+        "  --duration SEC     restart a scenario after SEC simulated seconds (default 600)\n"
+        "  --max-flags N      list at most N flagged steps (default 10)\n"
+        "  --rt CPU           real-time mode: pin to CPU, SCHED_FIFO, mlockall, prefault (-1 = no pinning)\n"
+        "  --rt-prio N        SCHED_FIFO priority for --rt (default 80)\n");
+}
+
+struct FlaggedStep {
+    const char* scenario;
+    long step;
+    double sim_time_sec;
+    double latency_us;
+};
+
+// 'over_deadline' is only meaningful for whole steps; parts of a step pass nullptr
+static void printRow(const char* label, const LatencyHistogram& h, const uint64_t* over_deadline) {
+    char over[24] = "-";
+    if (over_deadline) std::snprintf(over, sizeof(over), "%llu", (unsigned long long)*over_deadline);
+    std::printf("%-34s %9llu %8.2f %8.2f %8.2f %8.2f %9.2f %9s\n", label, (unsigned long long)h.count(),
+                h.mean() / 1000.0, h.valueAtPercentile(50.0) / 1000.0, h.valueAtPercentile(99.0) / 1000.0,
+                h.valueAtPercentile(99.9) / 1000.0, h.max() / 1000.0, over);
+}
+
+int main(int argc, char** argv) {
+    std::vector<const char*> paths;
+    long steps = 1000000;
+    long warmup = 2000;
+    double deadline_us = 500.0;
+    double max_duration = 600.0;
+    size_t max_flags = 10;
+    RealtimeConfig rt_config;
+    bool realtime = false;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        if (std::strcmp(arg, "--help") == 0) { printUsage(); return 0; }
+        if (std::strncmp(arg, "--", 2) != 0) {
+            paths.push_back(arg);
+            continue;
+        }
+
+        const char* val = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (!val) { printUsage(); return 1; }
+
+        if (std::strcmp(arg, "--steps") == 0) {
+            steps = std::max(1L, std::atol(val));
+        } else if (std::strcmp(arg, "--warmup") == 0) {
+            warmup = std::max(0L, std::atol(val));
+        } else if (std::strcmp(arg, "--deadline-us") == 0) {
+            deadline_us = std::atof(val);
+        } else if (std::strcmp(arg, "--duration") == 0) {
+            max_duration = std::atof(val);
+        } else if (std::strcmp(arg, "--max-flags") == 0) {
+            max_flags = (size_t)std::max(0, std::atoi(val));
+        } else if (std::strcmp(arg, "--rt") == 0) {
+            rt_config.cpu = std::atoi(val);
+            realtime = true;
+        } else if (std::strcmp(arg, "--rt-prio") == 0) {
+            rt_config.priority = std::atoi(val);
+        } else {
+            printUsage();
+            return 1;
+        }
+        ++i;
+    }
+    if (paths.empty()) {
+        printUsage();
+        return 1;
+    }
+
+    std::vector<Scenario> scenarios(paths.size());
+    for (size_t i = 0; i < paths.size(); ++i) {
+        std::string error;
+        if (!loadScenarioFile(paths[i], scenarios[i], error)) {
+            std::fprintf(stderr, "%s\n", error.c_str());
+            return 1;
+        }
+    }
+
+    std::string rt_line = "RT off";
+    if (realtime) {
+        RealtimeStatus rt_status;
+        std::string error;
+        if (!enterRealtime(rt_config, rt_status, error)) std::fprintf(stderr, "PRIM_latency: real-time setup incomplete: %s\n", error.c_str());
+        rt_line = describeRealtime(rt_status);
+    }
+
+    std::printf("deadline %.1f us, %ld steps per scenario, %s, latencies in us\n", deadline_us, steps, rt_line.c_str());
+    std::printf("%-34s %9s %8s %8s %8s %8s %9s %9s\n", "scenario / part", "steps", "mean", "p50", "p99", "p99.9", "max", ">deadline");
+
+    LatencyHistogram all_steps;
+    uint64_t all_misses = 0;
+    std::vector<FlaggedStep> flagged;
+
+    for (const Scenario& scenario : scenarios) {
+        // Single-rate executive: the same pieces as stepSimulation(), timed individually
+        RateConfig config;
+        config.dynamics_hz = config.prim_hz = config.monitor_hz = 1.0f / scenario.dt_sec;
+        RateExecutive rates;
+        std::string error;
+        if (!rates.configure(config, error)) {
+            std::fprintf(stderr, "%s: %s\n", scenario.name.c_str(), error.c_str());
+            return 1;
+        }
+
+        SimState sim;
+        ScenarioRunner runner;
+        if (!runner.start(scenario, sim, error)) {
+            std::fprintf(stderr, "PRIM_latency: %s\n", error.c_str());
+            return 1;
+        }
+
+        LatencyHistogram step_hist, prim_hist, dynamics_hist;
+        auto attach = [&]() {
+            rates.setFrameHistogram(&step_hist);
+            rates.setHistogram(RateGroupId::PRIM, &prim_hist);
+            rates.setHistogram(RateGroupId::DYNAMICS, &dynamics_hist);
+        };
+        if (warmup == 0) attach();
+
+        uint64_t misses = 0;
+        for (long n = 0; n < warmup + steps;) {
+            // Scenario ends restart from the top; the trim at start() is not timed
+            if (sim.time_sec >= max_duration || !runner.step(sim, &rates)) {
+                runner.start(scenario, sim, error);     // Started once above, so it trims again
+                rates.reset();
+                continue;
+            }
+            if (++n <= warmup) {
+                if (n == warmup) attach();
+                continue;
+            }
+
+            double us = rates.frameStats().last_us;
+            if (us > deadline_us) {
+                ++misses;
+                if (flagged.size() < max_flags) flagged.push_back({ scenario.name.c_str(), n - warmup, sim.time_sec, us });
+            }
+        }
+
+        printRow(scenario.name.c_str(), step_hist, &misses);
+        printRow("  PrimCore::update", prim_hist, nullptr);
+        printRow("  updateFlightDynamics", dynamics_hist, nullptr);
+        all_steps.merge(step_hist);
+        all_misses += misses;
+    }
+
+    if (scenarios.size() > 1) printRow("ALL", all_steps, &all_misses);
+
+    for (const FlaggedStep& f : flagged) {
+        std::printf("OVER DEADLINE: %s step %ld (t=%.2f s) took %.2f us\n", f.scenario, f.step, f.sim_time_sec, f.latency_us);
+    }
+    if (all_misses > flagged.size()) {
+        std::printf("... %llu more\n", (unsigned long long)(all_misses - flagged.size()));
+    }
+    std::printf("%s: %llu of %llu steps over %.1f us\n", all_misses == 0 ? "PASS" : "FAIL",
+                (unsigned long long)all_misses, (unsigned long long)all_steps.count(), deadline_us);
+    return all_misses == 0 ? 0 : 1;
+}
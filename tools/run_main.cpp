@@ -0,0 +1,256 @@
+//
+//
+// Santiago Quintana Moreno A01571222
+// Created on: 18/10/2026.
+//
+// PRIM_run - plays a scenario script headless and prints a CSV trace of the flight.
+#include "scenario.h"
+#include "live_state.h"
+#include "input_ring.h"
+#include "telemetry.h"
+#include "realtime.h"
+#include "latency_histogram.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+static void printUsage() {
+    std::fprintf(stderr,
+        "usage: PRIM_run <scenario.scn> [options]\n"
+        "  --duration SEC     stop after SEC simulated seconds if the script has not ended (default 600)\n"
+        "  --every N          trace every Nth step (default 10)\n"
+        "  --trace FILE       write the trace to FILE instead of stdout\n"
+        "  --shm NAME         publish every step to a live state export (e.g. /prim_live)\n"
+        "  --inject NAME      apply commands from an input injection ring (e.g. /prim_input)\n"
+        "  --udp HOST:PORT    stream telemetry datagrams (format in src/telemetry.h)\n"
+        "  --udp-every N      one datagram every N steps (default 1)\n"
+        "  --pace X           run at X times real time on absolute deadlines (default: as fast as possible)\n"
+        "  --rt CPU           real-time mode: pin to CPU, SCHED_FIFO, mlockall, prefault (-1 = no pinning)\n"
+        "  --rt-prio N        SCHED_FIFO priority for --rt (default 80)\n"
+        "  --rates D,P,M      multi-rate executive: dynamics, PRIM and monitor rates in Hz\n"
+        "                     (e.g. 400,100,20; default: everything once per scenario step)\n"
+        "  --dynamics M       point or 6dof, overriding the script's 'dynamics' line\n"
+        "  --adaptive TOL     fast-time variable step with error control and event location, error\n"
+        "                     limits scaled by TOL (1 = default); not with --rates, --pace or --rt\n");
+}
+
+static const char* lawName(ControlLaw law) {
+    switch (law) {
+        case ControlLaw::NORMAL:    return "NORMAL";
+        case ControlLaw::ALTERNATE: return "ALTN";
+        case ControlLaw::DIRECT:    return "DIRECT";
+    }
+    return "?";
+}
+
+static void writeTraceRow(FILE* out, const SimState& sim) {
+    const Sensors& s = sim.sensors;
+    std::fprintf(out, "%.3f,%.2f,%.2f,%.1f,%.3f,%.3f,%.3f,%.2f,%.4f,%.3f,%s,%016llx\n",
+                 sim.time_sec, s.altitude_ft, s.ias_knots, s.vs_fpm, s.pitch_deg, s.roll_deg, s.aoa_deg,
+                 s.heading_deg, s.mach, sim.pilot.thrust, lawName(sim.prim.fctl_status().law),
+                 (unsigned long long)sim.alerts.shownMask());
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2 || std::strcmp(argv[1], "--help") == 0) {
+        printUsage();
+        return argc < 2 ? 1 : 0;
+    }
+
+    const char* script_path = argv[1];
+    float max_duration = 600.0f;
+    int every = 10;
+    const char* trace_path = nullptr;
+    const char* shm_name = nullptr;
+    const char* inject_name = nullptr;
+    TelemetryConfig telemetry_config;
+    bool want_telemetry = false;
+    std::string error;
+    double pace = 0.0;
+    RateConfig rate_config;
+    bool multirate = false;
+    RealtimeConfig rt_config;
+    bool realtime = false;
+    const char* dynamics_name = nullptr;
+    AdaptiveStepConfig adaptive_config;
+    bool adaptive = false;
+
+    for (int i = 2; i < argc; ++i) {
+        const char* arg = argv[i];
+        const char* val = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (!val) { printUsage(); return 1; }
+
+        if (std::strcmp(arg, "--duration") == 0) {
+            max_duration = (float)std::atof(val);
+        } else if (std::strcmp(arg, "--every") == 0) {
+            every = std::max(1, std::atoi(val));
+        } else if (std::strcmp(arg, "--trace") == 0) {
+            trace_path = val;
+        } else if (std::strcmp(arg, "--shm") == 0) {
+            shm_name = val;
+        } else if (std::strcmp(arg, "--inject") == 0) {
+            inject_name = val;
+        } else if (std::strcmp(arg, "--udp") == 0) {
+            if (!parseTelemetryTarget(val, telemetry_config, error)) {
+                std::fprintf(stderr, "%s\n", error.c_str());
+                return 1;
+            }
+            want_telemetry = true;
+        } else if (std::strcmp(arg, "--udp-every") == 0) {
+            telemetry_config.decimation = std::max(1, std::atoi(val));
+        } else if (std::strcmp(arg, "--pace") == 0) {
+            pace = std::atof(val);
+        } else if (std::strcmp(arg, "--rt") == 0) {
+            rt_config.cpu = std::atoi(val);
+            realtime = true;
+        } else if (std::strcmp(arg, "--rt-prio") == 0) {
+            rt_config.priority = std::atoi(val);
+        } else if (std::strcmp(arg, "--rates") == 0) {
+            if (!parseRateConfig(val, rate_config, error)) {
+                std::fprintf(stderr, "%s\n", error.c_str());
+                return 1;
+            }
+            multirate = true;
+        } else if (std::strcmp(arg, "--dynamics") == 0) {
+            dynamics_name = val;
+        } else if (std::strcmp(arg, "--adaptive") == 0) {
+            adaptive_config.tolerance = (float)std::atof(val);
+            adaptive = adaptive_config.tolerance > 0.0f;
+            if (!adaptive) { printUsage(); return 1; }
+        } else {
+            printUsage();
+            return 1;
+        }
+        ++i;
+    }
+
+    if (adaptive && (multirate || pace > 0.0 || realtime)) {
+        std::fprintf(stderr, "PRIM_run: --adaptive cannot be combined with --rates, --pace or --rt\n");
+        return 1;
+    }
+
+    Scenario scenario;
+    if (!loadScenarioFile(script_path, scenario, error)) {
+        std::fprintf(stderr, "%s\n", error.c_str());
+        return 1;
+    }
+    if (dynamics_name && !parseDynamicsModel(dynamics_name, scenario.dynamics)) {
+        printUsage();
+        return 1;
+    }
+
+    FILE* out = trace_path ? std::fopen(trace_path, "w") : stdout;
+    if (!out) {
+        std::fprintf(stderr, "cannot open %s\n", trace_path);
+        return 1;
+    }
+
+    LiveStateWriter live_export;
+    if (shm_name && !live_export.open(shm_name, error)) {
+        std::fprintf(stderr, "%s\n", error.c_str());
+        return 1;
+    }
+    InputRingConsumer input_ring;
+    if (inject_name && !input_ring.open(inject_name, error)) {
+        std::fprintf(stderr, "%s\n", error.c_str());
+        return 1;
+    }
+    TelemetryStreamer telemetry;
+    if (want_telemetry && !telemetry.start(telemetry_config, error)) {
+        std::fprintf(stderr, "%s\n", error.c_str());
+        return 1;
+    }
+
+    RateExecutive rates;
+    if (multirate && !rates.configure(rate_config, error)) {
+        std::fprintf(stderr, "%s\n", error.c_str());
+        return 1;
+    }
+
+    SimState sim;
+    ScenarioRunner runner;
+    if (!runner.start(scenario, sim, error)) {
+        std::fprintf(stderr, "PRIM_run: %s\n", error.c_str());
+        return 1;
+    }
+    AdaptiveStepper stepper;
+    stepper.configure(adaptive_config);
+
+    if (realtime) {
+        RealtimeStatus rt_status;
+        if (!enterRealtime(rt_config, rt_status, error)) std::fprintf(stderr, "PRIM_run: real-time setup incomplete: %s\n", error.c_str());
+        std::fprintf(stderr, "PRIM_run: %s\n", describeRealtime(rt_status).c_str());
+    }
+
+    std::fprintf(out, "t,alt_ft,ias_kt,vs_fpm,pitch_deg,roll_deg,aoa_deg,hdg_deg,mach,thrust,law,alerts\n");
+    writeTraceRow(out, sim);
+
+    // Paced runs sleep to absolute deadlines, one scenario step apart at the requested speed
+    DeadlineClock pacer;
+    LatencyHistogram wake_hist;
+    pacer.setWakeHistogram(&wake_hist);
+    if (pace > 0.0) pacer.start((uint64_t)(scenario.dt_sec / pace * 1e9));
+    const uint64_t max_logged_misses = 10;
+
+    long step = 0;
+    while (sim.time_sec < max_duration) {
+        drainInputCommands(input_ring, sim);
+        bool stepped = adaptive ? runner.stepAdaptive(sim, stepper, max_duration)
+                                : runner.step(sim, multirate ? &rates : nullptr);
+        if (!stepped) break;
+        publishLiveState(sim, live_export, telemetry);
+        if (++step % every == 0) writeTraceRow(out, sim);
+        uint64_t late_ns = 0;
+        if (pace > 0.0 && !pacer.wait(&late_ns) && pacer.stats().misses <= max_logged_misses) {
+            std::fprintf(stderr, "PRIM_run: deadline miss at step %ld (t=%.2f s), %.1f us late%s\n", step, sim.time_sec,
+                         late_ns / 1000.0, pacer.stats().misses == max_logged_misses ? " (further misses not logged)" : "");
+        }
+    }
+    if (step % every != 0) writeTraceRow(out, sim);
+
+    if (out != stdout) std::fclose(out);
+
+    if (telemetry.isRunning()) {
+        telemetry.stop();
+        TelemetryStats ts = telemetry.stats();
+        std::fprintf(stderr, "PRIM_run: telemetry %llu datagrams sent, %llu overruns, %llu send errors\n",
+                     (unsigned long long)ts.sent, (unsigned long long)ts.overruns, (unsigned long long)ts.send_errors);
+    }
+
+    if (pace > 0.0) {
+        const DeadlineStats& ds = pacer.stats();
+        std::fprintf(stderr, "PRIM_run: paced %llu frames of %.1f us: %llu deadline misses (%llu periods skipped), "
+                             "worst %.1f us late; wake-up p50 %.1f us, p99 %.1f us, max %.1f us\n",
+                     (unsigned long long)ds.frames, pacer.period() / 1000.0, (unsigned long long)ds.misses,
+                     (unsigned long long)ds.skipped_periods, ds.max_late_ns / 1000.0,
+                     wake_hist.valueAtPercentile(50.0) / 1000.0, wake_hist.valueAtPercentile(99.0) / 1000.0,
+                     wake_hist.max() / 1000.0);
+    }
+
+    if (multirate) {
+        std::fprintf(stderr, "PRIM_run: %-8s %7s %10s %9s %9s %7s %9s\n",
+                     "group", "Hz", "runs", "mean_us", "max_us", "load%", "overruns");
+        const RateGroupStats* groups[] = { &rates.stats(RateGroupId::DYNAMICS), &rates.stats(RateGroupId::PRIM),
+                                           &rates.stats(RateGroupId::MONITOR), &rates.frameStats() };
+        for (const RateGroupStats* g : groups) {
+            std::fprintf(stderr, "PRIM_run: %-8s %7.1f %10llu %9.2f %9.2f %7.2f %9llu\n",
+                         g->name, g->rate_hz, (unsigned long long)g->runs, g->meanMicros(), g->max_us,
+                         g->loadPercent(), (unsigned long long)g->overruns);
+        }
+    }
+
+    if (adaptive) {
+        const AdaptiveStepStats& as = stepper.stats();
+        std::fprintf(stderr, "PRIM_run: adaptive %llu steps of %.4f .. %.3f s, %llu rejected, %llu landed on thresholds, "
+                             "%llu model steps\n",
+                     (unsigned long long)as.steps, as.min_dt_sec, as.max_dt_sec, (unsigned long long)as.rejected,
+                     (unsigned long long)as.located, (unsigned long long)as.model_steps);
+    }
+
+    std::fprintf(stderr, "PRIM_run: %s - %ld steps, %.2f s simulated, %zu/%zu timed events%s\n",
+                 scenario.name.c_str(), step, sim.time_sec, runner.eventsFired(), scenario.events.size(),
+                 runner.finished() ? ", ended by script" : "");
+    return 0;
+}
@@ -0,0 +1,129 @@
+//
+//
+// Santiago Quintana Moreno A01571222
+// Created on: 18/10/2026.
+//
+// PRIM_script - runs coroutine training scripts in batch mode.
+// Each aircraft runs the same engine-failure-with-windshear script with a different
+// trigger altitude, then the final states are summarised.
+#include "sim_script.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+// Emergency descent from 10,000 ft, lose ENG 2 at a per-aircraft altitude, windshear 5 s
+// later, then go around at TOGA once below 1000 ft.
+static ScriptTask engineFailureWindshear(ScriptScheduler& sim, int index) {
+    SimState& s = sim.state();
+    float fail_alt = 2000.0f + 5.0f * (float)(index % 400);
+
+    s.pilot.thrust = 0.2f;
+    s.pilot.pitch = -0.05f;
+    co_await sim.until(sim.pitch < -12.0f);
+    s.pilot.pitch = 0.0f;
+
+    co_await sim.until(sim.altitude < fail_alt);
+    s.engines.engine2_running = false;
+
+    co_await sim.seconds(5);
+    s.weather.windshear_intensity = 0.8f;
+
+    co_await sim.until(sim.altitude < 1000.0f);
+    s.pilot.thrust = 1.0f;
+    s.pilot.pitch = 0.1f;
+
+    // Any callable works as a wait condition
+    co_await sim.until([&s] { return s.sensors.pitch_deg > 8.0f || s.sensors.altitude_ft <= 0.0f; });
+    s.pilot.pitch = 0.0f;
+
+    co_await sim.seconds(30);
+}
+
+static void printUsage() {
+    std::fprintf(stderr,
+        "usage: PRIM_script [options]\n"
+        "  --count N          aircraft to run (default 1000)\n"
+        "  --duration SEC     per-aircraft limit in simulated seconds (default 400)\n"
+        "  --dt SEC           step size (default 0.01)\n"
+        "  --threads N        worker threads (default: hardware threads)\n"
+        "  --aero FILE        fly an aero database model instead of the built-in one\n"
+        "  --dynamics M       point or 6dof (default point)\n");
+}
+
+int main(int argc, char** argv) {
+    int count = 1000;
+    ScriptBatchConfig config;
+    config.duration_sec = 400.0f;
+    const char* aero_path = nullptr;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const char* val = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (std::strcmp(arg, "--help") == 0) { printUsage(); return 0; }
+        if (!val) { printUsage(); return 1; }
+
+        if (std::strcmp(arg, "--count") == 0) {
+            count = std::atoi(val);
+        } else if (std::strcmp(arg, "--duration") == 0) {
+            config.duration_sec = (float)std::atof(val);
+        } else if (std::strcmp(arg, "--dt") == 0) {
+            config.dt_sec = (float)std::atof(val);
+        } else if (std::strcmp(arg, "--threads") == 0) {
+            config.threads = std::atoi(val);
+        } else if (std::strcmp(arg, "--aero") == 0) {
+            aero_path = val;
+        } else if (std::strcmp(arg, "--dynamics") == 0) {
+            if (!parseDynamicsModel(val, config.model.dynamics)) { printUsage(); return 1; }
+        } else {
+            printUsage();
+            return 1;
+        }
+        ++i;
+    }
+
+    if (count <= 0 || config.dt_sec <= 0.0f) {
+        printUsage();
+        return 1;
+    }
+
+    // Every aircraft shares the database read-only; each core keeps its own lookup cursor
+    AeroDatabase aero;
+    if (aero_path) {
+        std::string error;
+        if (!aero.load(aero_path, error)) {
+            std::fprintf(stderr, "%s\n", error.c_str());
+            return 1;
+        }
+        config.model.aero = &aero;
+    }
+
+    auto t0 = std::chrono::steady_clock::now();
+    std::vector<ScriptBatchResult> results = runScriptBatch(count, engineFailureWindshear, config);
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    int not_started = 0;
+    int finished = 0;
+    int ground_contact = 0;
+    double sim_seconds = 0.0;
+    for (const auto& r : results) {
+        if (!r.started) {
+            if (not_started++ == 0) std::fprintf(stderr, "PRIM_script: start cannot be trimmed: %s\n", r.error.c_str());
+            continue;
+        }
+        finished += r.script_finished;
+        ground_contact += (r.final_sensors.altitude_ft <= 0.0f);
+        sim_seconds += r.end_time_sec;
+    }
+
+    std::printf("aircraft:        %d\n", count);
+    std::printf("scripts done:    %d\n", finished);
+    std::printf("ground contact:  %d\n", ground_contact);
+    std::printf("simulated time:  %.0f s total in %.2f s wall (%.0fx real time)\n",
+                sim_seconds, elapsed, elapsed > 0.0 ? sim_seconds / elapsed : 0.0);
+    if (not_started > 0) {
+        std::fprintf(stderr, "PRIM_script: %d aircraft not flown\n", not_started);
+        return 1;
+    }
+    return 0;
+}
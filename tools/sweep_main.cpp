@@ -0,0 +1,125 @@
+//
+//
+// Santiago Quintana Moreno A01571222
+// Created on: 18/10/2026.
+//
+// PRIM_sweep - headless fault-combination sweep.
+// Runs every combination (or a covering array) of faults from each start condition
+// and prints the outcome matrix as CSV.
+#include "fault_sweep.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+static void printUsage() {
+    std::fprintf(stderr,
+        "usage: PRIM_sweep [options]\n"
+        "  --order N          all combinations of 1..N faults (default 2)\n"
+        "  --covering T       T-way covering array instead of exhaustive combinations (T = 2 or 3)\n"
+        "  --faults a,b,...   restrict the sweep to these Faults fields (default: all)\n"
+        "  --start NAME       cruise10k | cruise37k | approach | all (default all)\n"
+        "  --duration SEC     simulated seconds per case (default 60)\n"
+        "  --dt SEC           step size (default 0.01)\n"
+        "  --threads N        worker threads (default: hardware threads)\n"
+        "  --out FILE         write the matrix to FILE instead of stdout\n");
+}
+
+static bool parseFaultList(const char* list, FaultSet& out) {
+    std::string all(list);
+    size_t pos = 0;
+    while (pos <= all.size()) {
+        size_t comma = all.find(',', pos);
+        std::string name = all.substr(pos, comma == std::string::npos ? std::string::npos : comma - pos);
+        FaultId id;
+        if (!faultFromName(name.c_str(), id)) {
+            std::fprintf(stderr, "unknown fault '%s'\n", name.c_str());
+            return false;
+        }
+        out.set(id);
+        if (comma == std::string::npos) break;
+        pos = comma + 1;
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    int order = 2;
+    int covering = 0;
+    FaultSet candidates;
+    for (int i = 0; i < (int)FaultId::COUNT; ++i) candidates.set((FaultId)i);
+    std::vector<SweepStart> starts = { SweepStart::CRUISE_10000FT, SweepStart::CRUISE_37000FT, SweepStart::APPROACH };
+    SweepConfig config;
+    const char* out_path = nullptr;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const char* val = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (std::strcmp(arg, "--help") == 0) { printUsage(); return 0; }
+        if (!val) { printUsage(); return 1; }
+
+        if (std::strcmp(arg, "--order") == 0) {
+            order = std::atoi(val);
+        } else if (std::strcmp(arg, "--covering") == 0) {
+            covering = std::atoi(val);
+        } else if (std::strcmp(arg, "--faults") == 0) {
+            candidates = FaultSet{};
+            if (!parseFaultList(val, candidates)) return 1;
+        } else if (std::strcmp(arg, "--start") == 0) {
+            SweepStart s;
+            if (std::strcmp(val, "all") == 0) {
+                // keep the default list
+            } else if (sweepStartFromName(val, s)) {
+                starts = { s };
+            } else {
+                std::fprintf(stderr, "unknown start '%s'\n", val);
+                return 1;
+            }
+        } else if (std::strcmp(arg, "--duration") == 0) {
+            config.duration_sec = (float)std::atof(val);
+        } else if (std::strcmp(arg, "--dt") == 0) {
+            config.dt_sec = (float)std::atof(val);
+        } else if (std::strcmp(arg, "--threads") == 0) {
+            config.threads = std::atoi(val);
+        } else if (std::strcmp(arg, "--out") == 0) {
+            out_path = val;
+        } else {
+            printUsage();
+            return 1;
+        }
+        ++i;
+    }
+
+    if (config.dt_sec <= 0.0f || config.duration_sec <= 0.0f) {
+        std::fprintf(stderr, "--dt and --duration must be positive\n");
+        return 1;
+    }
+
+    std::vector<FaultSet> combos = (covering > 0) ? buildCoveringArray(candidates, covering)
+                                                  : enumerateFaultCombinations(candidates, order);
+
+    std::vector<SweepCase> cases;
+    cases.reserve(combos.size() * starts.size());
+    for (SweepStart start : starts) {
+        for (const FaultSet& set : combos) cases.push_back(SweepCase{ start, set });
+    }
+
+    std::fprintf(stderr, "PRIM_sweep: %zu fault sets x %zu starts = %zu cases, %.0f s each\n",
+                 combos.size(), starts.size(), cases.size(), config.duration_sec);
+
+    auto t0 = std::chrono::steady_clock::now();
+    std::vector<SweepOutcome> outcomes = runFaultSweep(cases, config);
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    FILE* out = out_path ? std::fopen(out_path, "w") : stdout;
+    if (!out) {
+        std::fprintf(stderr, "cannot open %s\n", out_path);
+        return 1;
+    }
+    writeOutcomeMatrix(out, outcomes);
+    if (out != stdout) std::fclose(out);
+
+    std::fprintf(stderr, "PRIM_sweep: done in %.1f s\n", elapsed);
+    return 0;
+}
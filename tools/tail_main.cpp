@@ -0,0 +1,117 @@
+//
+//
+// Santiago Quintana Moreno A01571222
+// Created on: 18/10/2026.
+//
+// PRIM_tail - prints live values from a running sim's shared-memory export.
+// Needs only the reader library (PRIM_live), not the sim core.
+#include "live_state.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+
+static void printUsage() {
+    std::fprintf(stderr,
+        "usage: PRIM_tail [options]\n"
+        "  --name NAME        shared-memory object (default /prim_live)\n"
+        "  --hz N             lines per second (default 10)\n"
+        "  --count N          stop after N lines (default: until the sim exits)\n"
+        "  --wait             keep retrying until the sim starts exporting\n");
+}
+
+static const char* lawName(ControlLaw law) {
+    switch (law) {
+        case ControlLaw::NORMAL:    return "NORMAL";
+        case ControlLaw::ALTERNATE: return "ALTN";
+        case ControlLaw::DIRECT:    return "DIRECT";
+    }
+    return "?";
+}
+
+int main(int argc, char** argv) {
+    const char* name = LIVE_STATE_DEFAULT_NAME;
+    double hz = 10.0;
+    long count = 0;
+    bool wait = false;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        if (std::strcmp(arg, "--help") == 0) { printUsage(); return 0; }
+        if (std::strcmp(arg, "--wait") == 0) { wait = true; continue; }
+
+        const char* val = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (!val) { printUsage(); return 1; }
+
+        if (std::strcmp(arg, "--name") == 0) {
+            name = val;
+        } else if (std::strcmp(arg, "--hz") == 0) {
+            hz = std::atof(val);
+        } else if (std::strcmp(arg, "--count") == 0) {
+            count = std::atol(val);
+        } else {
+            printUsage();
+            return 1;
+        }
+        ++i;
+    }
+
+    if (hz <= 0.0) {
+        printUsage();
+        return 1;
+    }
+    const auto period = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(1.0 / hz));
+
+    LiveStateReader reader;
+    std::string error;
+    while (!reader.open(name, error)) {
+        if (!wait) {
+            std::fprintf(stderr, "PRIM_tail: %s\n", error.c_str());
+            return 1;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    }
+
+    std::printf("%9s %8s %6s %7s %6s %6s %6s %5s %6s %6s %6s %-6s %5s %-5s %16s %10s\n",
+                "t", "alt_ft", "ias_kt", "vs_fpm", "pitch", "roll", "aoa", "hdg", "mach",
+                "elev", "ail", "law", "n1", "ap", "alerts", "frames");
+
+    uint32_t writer = reader.writerPid();
+    LiveStateFrame f;
+    auto next = std::chrono::steady_clock::now();
+    for (long lines = 0; count <= 0 || lines < count; ++lines) {
+        std::this_thread::sleep_until(next);
+        next += period;
+
+        // A restarted sim recreates the object; our mapping would keep showing the old one
+        LiveStateReader probe;
+        if (!probe.open(name, error) || probe.writerPid() != writer) {
+            std::fprintf(stderr, "PRIM_tail: writer %u went away\n", writer);
+            return 0;
+        }
+
+        if (!reader.read(f)) {
+            std::printf("%9s (no consistent frame yet)\n", "-");
+            continue;
+        }
+
+        const Sensors& s = f.sensors;
+        char ap[6] = "-----";
+        if (f.autopilot.spd_mode) ap[0] = 'S';
+        if (f.autopilot.hdg_mode) ap[1] = 'H';
+        if (f.autopilot.alt_mode) ap[2] = 'A';
+        if (f.autopilot.vs_mode) ap[3] = 'V';
+        if (f.autopilot.autothrust) ap[4] = 'T';
+
+        std::printf("%9.2f %8.0f %6.1f %7.0f %6.2f %6.2f %6.2f %5.0f %6.3f %6.2f %6.2f %-6s %5.1f %-5s %016llx %10llu%s\n",
+                    f.time_sec, s.altitude_ft, s.ias_knots, s.vs_fpm, s.pitch_deg, s.roll_deg, s.aoa_deg,
+                    s.heading_deg, s.mach, f.surfaces.elevator_deg, f.surfaces.aileron_deg, lawName(f.fctl.law),
+                    f.engine.n1_percent, ap, (unsigned long long)f.alerts_shown,
+                    (unsigned long long)reader.framesPublished(),
+                    f.master_warning ? " MW" : (f.master_caution ? " MC" : ""));
+        std::fflush(stdout);
+    }
+    return 0;
+}
@@ -0,0 +1,240 @@
+//
+//
+// Santiago Quintana Moreno A01571222
+// Created on: 18/10/2026.
+//
+// PRIM_telemetry - UDP telemetry receiver and loopback check.
+//   --listen: decode datagrams from a running sim, report rate, gaps and latency.
+//   --loopback: drive a TelemetryStreamer at a fixed rate into a local receiver and fail
+//               on any lost, duplicated or reordered datagram.
+#include "telemetry.h"
+#include "input_ring.h"
+#include <algorithm>
+#include <arpa/inet.h>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+static void printUsage() {
+    std::fprintf(stderr,
+        "usage: PRIM_telemetry [--listen PORT | --loopback SEC] [options]\n"
+        "  --listen PORT      receive from a sim (default mode, port 49100)\n"
+        "  --loopback SEC     self-test: stream synthetic frames to a local receiver for SEC seconds\n"
+        "  --rate HZ          loopback publish rate (default 1000)\n"
+        "  --every N          loopback decimation (default 1)\n"
+        "  --duration SEC     stop listening after SEC seconds (default: run until killed)\n");
+}
+
+struct ReceiveStats {
+    uint64_t received = 0;
+    uint64_t lost = 0;               // Sequence gaps
+    uint64_t out_of_order = 0;       // Sequence went backwards (duplicate or reordered)
+    uint64_t malformed = 0;
+    uint64_t next_seq = 0;
+    std::vector<double> latency_us;
+};
+
+static int openReceiver(uint16_t port, uint16_t& bound_port) {
+    int fd = socket(AF_INET, SOCK_DGRAM, 0);
+    if (fd < 0) return -1;
+
+    // Room for bursts while this thread is descheduled
+    int rcvbuf = 4 << 20;
+    setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &rcvbuf, sizeof(rcvbuf));
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+        close(fd);
+        return -1;
+    }
+    socklen_t len = sizeof(addr);
+    getsockname(fd, reinterpret_cast<sockaddr*>(&addr), &len);
+    bound_port = ntohs(addr.sin_port);
+    return fd;
+}
+
+// Waits up to timeout_ms for one datagram. Returns false on timeout.
+static bool receiveOne(int fd, int timeout_ms, ReceiveStats& stats, TelemetryHeader& header, LiveStateFrame& frame) {
+    pollfd pfd{ fd, POLLIN, 0 };
+    if (poll(&pfd, 1, timeout_ms) <= 0) return false;
+
+    unsigned char buf[2048];
+    ssize_t n = recv(fd, buf, sizeof(buf), 0);
+    uint64_t now_ns = monotonicNanos();
+    if (n != (ssize_t)TELEMETRY_PACKET_SIZE) {
+        ++stats.malformed;
+        return true;
+    }
+
+    std::memcpy(&header, buf, sizeof(TelemetryHeader));
+    if (std::memcmp(header.magic, TELEMETRY_MAGIC, sizeof(TELEMETRY_MAGIC)) != 0 ||
+        header.version != TELEMETRY_VERSION || header.header_size != sizeof(TelemetryHeader) ||
+        header.payload_size != sizeof(LiveStateFrame)) {
+        ++stats.malformed;
+        return true;
+    }
+    std::memcpy(&frame, buf + sizeof(TelemetryHeader), sizeof(LiveStateFrame));
+
+    ++stats.received;
+    if (header.packet_seq > stats.next_seq) stats.lost += header.packet_seq - stats.next_seq;
+    if (header.packet_seq < stats.next_seq) ++stats.out_of_order;
+    else stats.next_seq = header.packet_seq + 1;
+    stats.latency_us.push_back(now_ns >= header.send_ns ? (double)(now_ns - header.send_ns) / 1000.0 : 0.0);
+    return true;
+}
+
+static void printStats(const char* label, ReceiveStats& stats) {
+    std::vector<double>& v = stats.latency_us;
+    std::sort(v.begin(), v.end());
+    auto pct = [&v](double p) { return v.empty() ? 0.0 : v[std::min(v.size() - 1, (size_t)(p * (double)v.size()))]; };
+    std::printf("%s: %llu received, %llu lost, %llu out of order, %llu malformed; "
+                "send->recv p50 %.1f us, p99 %.1f us, max %.1f us\n",
+                label, (unsigned long long)stats.received, (unsigned long long)stats.lost,
+                (unsigned long long)stats.out_of_order, (unsigned long long)stats.malformed,
+                pct(0.50), pct(0.99), v.empty() ? 0.0 : v.back());
+}
+
+static int runListen(uint16_t port, double duration_sec) {
+    uint16_t bound = 0;
+    int fd = openReceiver(port, bound);
+    if (fd < 0) {
+        std::fprintf(stderr, "PRIM_telemetry: cannot bind 127.0.0.1:%u: %s\n", port, std::strerror(errno));
+        return 1;
+    }
+    std::printf("listening on 127.0.0.1:%u\n", bound);
+
+    ReceiveStats stats;
+    TelemetryHeader header{};
+    LiveStateFrame frame{};
+    auto start = std::chrono::steady_clock::now();
+    auto next_report = start + std::chrono::seconds(1);
+    for (;;) {
+        auto now = std::chrono::steady_clock::now();
+        if (duration_sec > 0.0 && std::chrono::duration<double>(now - start).count() >= duration_sec) break;
+
+        receiveOne(fd, 100, stats, header, frame);
+
+        if (std::chrono::steady_clock::now() >= next_report && stats.received > 0) {
+            next_report += std::chrono::seconds(1);
+            std::printf("t=%.2f alt=%.0f ias=%.1f pitch=%.2f elev=%.2f law=%d | %llu received, %llu lost\n",
+                        frame.time_sec, frame.sensors.altitude_ft, frame.sensors.ias_knots, frame.sensors.pitch_deg,
+                        frame.surfaces.elevator_deg, (int)frame.fctl.law,
+                        (unsigned long long)stats.received, (unsigned long long)stats.lost);
+            std::fflush(stdout);
+        }
+    }
+
+    close(fd);
+    printStats("listen", stats);
+    return 0;
+}
+
+static int runLoopback(double seconds, double rate_hz, int every) {
+    uint16_t port = 0;
+    int fd = openReceiver(0, port);
+    if (fd < 0) {
+        std::fprintf(stderr, "PRIM_telemetry: cannot bind a loopback port: %s\n", std::strerror(errno));
+        return 1;
+    }
+
+    TelemetryConfig config;
+    config.port = port;
+    config.decimation = every;
+    TelemetryStreamer streamer;
+    std::string error;
+    if (!streamer.start(config, error)) {
+        std::fprintf(stderr, "PRIM_telemetry: %s\n", error.c_str());
+        close(fd);
+        return 1;
+    }
+
+    // Stand-in for the sim thread: publish synthetic frames on a fixed schedule
+    const long frames = (long)(seconds * rate_hz);
+    std::thread producer([&]() {
+        const auto period = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(1.0 / rate_hz));
+        auto next = std::chrono::steady_clock::now();
+        LiveStateFrame f;
+        for (long i = 0; i < frames; ++i) {
+            f.time_sec = (double)i / rate_hz;
+            f.sensors.altitude_ft = (float)i;
+            f.published_ns = monotonicNanos();
+            streamer.publish(f);
+            next += period;
+            std::this_thread::sleep_until(next);
+        }
+    });
+
+    const uint64_t expected = (uint64_t)((frames + every - 1) / every);
+    ReceiveStats stats;
+    uint64_t payload_errors = 0;
+    TelemetryHeader header{};
+    LiveStateFrame frame{};
+    while (stats.received + stats.malformed < expected) {
+        if (!receiveOne(fd, 500, stats, header, frame)) break;     // Stream stalled or finished short
+        if (frame.sensors.altitude_ft != (float)header.frame_index) ++payload_errors;
+    }
+
+    producer.join();
+    streamer.stop();
+    close(fd);
+
+    TelemetryStats ts = streamer.stats();
+    std::printf("loopback %.0f Hz for %.1f s, every %d: %llu sent, %llu overruns, %llu send errors\n",
+                rate_hz, seconds, every, (unsigned long long)ts.sent, (unsigned long long)ts.overruns,
+                (unsigned long long)ts.send_errors);
+    printStats("receiver", stats);
+
+    bool pass = stats.received == expected && stats.lost == 0 && stats.out_of_order == 0 &&
+                stats.malformed == 0 && payload_errors == 0 && ts.overruns == 0;
+    std::printf("%s (expected %llu datagrams)\n", pass ? "PASS" : "FAIL", (unsigned long long)expected);
+    return pass ? 0 : 1;
+}
+
+int main(int argc, char** argv) {
+    uint16_t port = TELEMETRY_DEFAULT_PORT;
+    double loopback_sec = 0.0;
+    double rate = 1000.0;
+    int every = 1;
+    double duration = 0.0;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const char* val = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (std::strcmp(arg, "--help") == 0) { printUsage(); return 0; }
+        if (!val) { printUsage(); return 1; }
+
+        if (std::strcmp(arg, "--listen") == 0) {
+            port = (uint16_t)std::atoi(val);
+        } else if (std::strcmp(arg, "--loopback") == 0) {
+            loopback_sec = std::atof(val);
+        } else if (std::strcmp(arg, "--rate") == 0) {
+            rate = std::atof(val);
+        } else if (std::strcmp(arg, "--every") == 0) {
+            every = std::max(1, std::atoi(val));
+        } else if (std::strcmp(arg, "--duration") == 0) {
+            duration = std::atof(val);
+        } else {
+            printUsage();
+            return 1;
+        }
+        ++i;
+    }
+
+    if (rate <= 0.0) {
+        printUsage();
+        return 1;
+    }
+    if (loopback_sec > 0.0) return runLoopback(loopback_sec, rate, every);
+    return runListen(port, duration);
+}
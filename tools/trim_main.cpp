@@ -0,0 +1,145 @@
+//
+//
+// Santiago Quintana Moreno A01571222
+// Created on: 18/10/2026.
+//
+// PRIM_trim - builds the level-flight equilibrium table (altitude x IAS x flaps x gear)
+// with the trim solver and writes it in the binary format described in trim_solver.h.
+#include "trim_solver.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+static void printUsage() {
+    std::fprintf(stderr,
+        "usage: PRIM_trim [options]\n"
+        "  --alt LO:HI:STEP   altitude axis in ft (default 0:41000:1000)\n"
+        "  --ias LO:HI:STEP   IAS axis in kt (default 120:340:5)\n"
+        "  --threads N        worker threads (default: hardware threads)\n"
+        "  --out FILE         binary table to write (default trim_table.bin)\n"
+        "  --load FILE        read an existing table instead of solving\n"
+        "  --csv FILE         also dump the table as CSV\n"
+        "  --aero FILE        trim an aero database model instead of the built-in one\n"
+        "  --dynamics M       point or 6dof (default point)\n");
+}
+
+static bool parseAxis(const char* spec, std::vector<float>& out) {
+    float lo, hi, step;
+    if (std::sscanf(spec, "%f:%f:%f", &lo, &hi, &step) != 3 || step <= 0.0f || hi < lo) return false;
+    out.clear();
+    int count = (int)((hi - lo) / step + 0.5f) + 1;
+    for (int i = 0; i < count; ++i) out.push_back(lo + step * (float)i);
+    return true;
+}
+
+static const char* flapsName(int flaps) {
+    static const char* const names[] = { "0", "1", "2", "3", "FULL" };
+    return names[flaps];
+}
+
+static void writeCsv(FILE* out, const TrimTable& table) {
+    std::fprintf(out, "gear,flaps,alt_ft,ias_kt,thrust,pitch_deg,aoa_deg,residual,iterations,converged\n");
+    for (int g = 0; g < TrimTable::GEAR_COUNT; ++g) {
+        for (int fl = 0; fl < TrimTable::FLAPS_COUNT; ++fl) {
+            for (size_t a = 0; a < table.altitudes_ft.size(); ++a) {
+                for (size_t s = 0; s < table.ias_knots.size(); ++s) {
+                    const TrimResult& r = table.at(g, fl, (int)a, (int)s);
+                    std::fprintf(out, "%s,%s,%.0f,%.0f,%.4f,%.3f,%.3f,%.5f,%d,%d\n",
+                                 g == 0 ? "UP" : "DOWN", flapsName(fl), table.altitudes_ft[a], table.ias_knots[s],
+                                 r.thrust, r.pitch_deg, r.aoa_deg, r.residual_kt_per_sec, r.iterations, r.converged);
+                }
+            }
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    std::vector<float> altitudes;
+    std::vector<float> speeds;
+    parseAxis("0:41000:1000", altitudes);
+    parseAxis("120:340:5", speeds);
+    int threads = 0;
+    const char* out_path = "trim_table.bin";
+    const char* load_path = nullptr;
+    const char* csv_path = nullptr;
+    const char* aero_path = nullptr;
+    DynamicsModel dynamics = DynamicsModel::POINT_MASS;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const char* val = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (std::strcmp(arg, "--help") == 0) { printUsage(); return 0; }
+        if (!val) { printUsage(); return 1; }
+
+        if (std::strcmp(arg, "--alt") == 0) {
+            if (!parseAxis(val, altitudes)) { std::fprintf(stderr, "bad --alt '%s'\n", val); return 1; }
+        } else if (std::strcmp(arg, "--ias") == 0) {
+            if (!parseAxis(val, speeds)) { std::fprintf(stderr, "bad --ias '%s'\n", val); return 1; }
+        } else if (std::strcmp(arg, "--threads") == 0) {
+            threads = std::atoi(val);
+        } else if (std::strcmp(arg, "--out") == 0) {
+            out_path = val;
+        } else if (std::strcmp(arg, "--load") == 0) {
+            load_path = val;
+        } else if (std::strcmp(arg, "--csv") == 0) {
+            csv_path = val;
+        } else if (std::strcmp(arg, "--aero") == 0) {
+            aero_path = val;
+        } else if (std::strcmp(arg, "--dynamics") == 0) {
+            if (!parseDynamicsModel(val, dynamics)) { printUsage(); return 1; }
+        } else {
+            printUsage();
+            return 1;
+        }
+        ++i;
+    }
+
+    TrimTable table;
+    if (load_path) {
+        if (!table.load(load_path)) {
+            std::fprintf(stderr, "cannot read trim table %s\n", load_path);
+            return 1;
+        }
+    } else {
+        size_t points = altitudes.size() * speeds.size() * TrimTable::FLAPS_COUNT * TrimTable::GEAR_COUNT;
+        std::fprintf(stderr, "PRIM_trim: solving %zu grid points\n", points);
+
+        auto t0 = std::chrono::steady_clock::now();
+        // Workers share the database read-only; each solve keeps its own lookup cursor
+        AeroDatabase aero;
+        TrimSolverConfig config;
+        config.model.dynamics = dynamics;
+        if (aero_path) {
+            std::string error;
+            if (!aero.load(aero_path, error)) {
+                std::fprintf(stderr, "%s\n", error.c_str());
+                return 1;
+            }
+            config.model.aero = &aero;
+        }
+        table = buildTrimTable(altitudes, speeds, threads, config);
+        double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+        size_t converged = 0;
+        for (const auto& r : table.entries) converged += r.converged;
+        std::fprintf(stderr, "PRIM_trim: %zu/%zu converged in %.1f s\n", converged, points, elapsed);
+
+        if (!table.save(out_path)) {
+            std::fprintf(stderr, "cannot write %s\n", out_path);
+            return 1;
+        }
+    }
+
+    if (csv_path) {
+        FILE* csv = std::fopen(csv_path, "w");
+        if (!csv) {
+            std::fprintf(stderr, "cannot open %s\n", csv_path);
+            return 1;
+        }
+        writeCsv(csv, table);
+        std::fclose(csv);
+    }
+    return 0;
+}
@@ -0,0 +1,319 @@
+//
+//
+// Santiago Quintana Moreno A01571222
+// Created on: 18/10/2026.
+//
+// PRIM_uibench - null-backend UI benchmark.
+// Builds every panel of ui_panels.cpp in an ImGui context with no platform or renderer backend,
+// over sim states played from scenario scripts, and reports per panel the CPU time to build it
+// and what it hands the renderer (vertices, indices, draw commands). --csv appends one row per
+// panel so the numbers can be tracked from commit to commit.
+#include "imgui.h"
+#include "latency_histogram.h"
+#include "panel_scheduler.h"
+#include "param_history.h"
+#include "rate_executive.h"
+#include "scenario.h"
+#include "sim_state.h"
+#include "ui_panels.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+static void printUsage() {
+    std::fprintf(stderr,
+        "usage: PRIM_uibench [scenario.scn...] [options]\n"
+        "  --frames N        measured frames (default 5000)\n"
+        "  --warmup N        untimed frames first (default 120)\n"
+        "  --fps HZ          sim time per frame (default 60)\n"
+        "  --width W         display size (default 1440x900)\n"
+        "  --height H\n"
+        "  --csv FILE        append one row per panel (header written for a new file)\n"
+        "  --label TEXT      first CSV column, e.g. the commit (default \"local\")\n"
+        "Without scenario files the three startup scenarios fly free on the rate executive.\n");
+}
+
+struct BenchPanel {
+    BenchPanel(const char* name, const char* title) : name(name), title(title) {}
+
+    const char* name;                   // Row label
+    const char* title;                  // ImGui window title, for draw list attribution
+    LatencyHistogram build_ns;          // Draw*Panel call, per frame
+    uint64_t frames = 0;                // Frames the panel was drawn in
+    uint64_t vtx = 0;
+    uint64_t idx = 0;
+    uint64_t cmds = 0;
+    uint64_t lists = 0;
+    uint32_t max_vtx = 0;
+};
+
+// Sim states for the benchmark: scripted scenarios in turn, restarted when they end
+struct StateSource {
+    std::vector<Scenario> scripts;
+    size_t current = 0;
+    ScenarioRunner runner;
+    RateExecutive executive;
+    double accum_sec = 0.0;
+    int startup = 0;                    // Next startup scenario when there are no scripts
+    double free_flight_sec = 0.0;
+
+    void start(SimState& sim) {
+        accum_sec = 0.0;
+        if (!scripts.empty()) {
+            std::string error;
+            runner.start(scripts[current], sim, error);     // Every script was started once when loaded
+            current = (current + 1) % scripts.size();
+            return;
+        }
+        static const StartupScenario STARTUPS[] = {StartupScenario::GROUND_PARKED, StartupScenario::CRUISE_10000FT,
+                                                   StartupScenario::CRUISE_37000FT};
+        initSimulation(sim, STARTUPS[startup]);
+        startup = (startup + 1) % 3;
+        executive.reset();
+        free_flight_sec = 0.0;
+    }
+
+    void advance(SimState& sim, double frame_sec) {
+        if (!scripts.empty()) {
+            accum_sec += frame_sec;
+            const Scenario* sc = runner.scenario();
+            while (accum_sec >= sc->dt_sec) {
+                if (!runner.step(sim)) {
+                    start(sim);
+                    return;
+                }
+                accum_sec -= sc->dt_sec;
+            }
+            return;
+        }
+        executive.advance(sim, (float)frame_sec);
+        free_flight_sec += frame_sec;
+        if (free_flight_sec > 120.0) start(sim);
+    }
+};
+
+static double elapsedNs(std::chrono::steady_clock::time_point since) {
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - since).count();
+}
+
+static void printRow(const char* label, const LatencyHistogram& h, uint64_t frames, double vtx, double idx, double cmds, uint32_t max_vtx) {
+    std::printf("%-30s %7llu %8.2f %8.2f %8.2f %8.2f %9.0f %9.0f %6.1f %8u\n", label, (unsigned long long)frames,
+                h.mean() / 1000.0, h.valueAtPercentile(50.0) / 1000.0, h.valueAtPercentile(99.0) / 1000.0,
+                h.max() / 1000.0, vtx, idx, cmds, max_vtx);
+}
+
+int main(int argc, char** argv) {
+    std::vector<const char*> paths;
+    long frames = 5000;
+    long warmup = 120;
+    double fps = 60.0;
+    float width = 1440.0f;
+    float height = 900.0f;
+    const char* csv_path = nullptr;
+    const char* label = "local";
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        if (std::strcmp(arg, "--help") == 0) { printUsage(); return 0; }
+        if (std::strncmp(arg, "--", 2) != 0) {
+            paths.push_back(arg);
+            continue;
+        }
+
+        const char* val = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (!val) { printUsage(); return 1; }
+
+        if (std::strcmp(arg, "--frames") == 0) {
+            frames = std::max(1L, std::atol(val));
+        } else if (std::strcmp(arg, "--warmup") == 0) {
+            warmup = std::max(0L, std::atol(val));
+        } else if (std::strcmp(arg, "--fps") == 0) {
+            fps = std::max(1.0, std::atof(val));
+        } else if (std::strcmp(arg, "--width") == 0) {
+            width = std::max(320.0f, (float)std::atof(val));
+        } else if (std::strcmp(arg, "--height") == 0) {
+            height = std::max(240.0f, (float)std::atof(val));
+        } else if (std::strcmp(arg, "--csv") == 0) {
+            csv_path = val;
+        } else if (std::strcmp(arg, "--label") == 0) {
+            label = val;
+        } else {
+            printUsage();
+            return 1;
+        }
+        ++i;
+    }
+
+    StateSource source;
+    source.scripts.resize(paths.size());
+    for (size_t i = 0; i < paths.size(); ++i) {
+        std::string error;
+        SimState probe;
+        ScenarioRunner check;
+        if (!loadScenarioFile(paths[i], source.scripts[i], error) || !check.start(source.scripts[i], probe, error)) {
+            std::fprintf(stderr, "%s\n", error.c_str());
+            return 1;
+        }
+    }
+    {
+        // Same executive setup as PRIM_sim's free flight
+        RateConfig config;
+        config.max_catchup_sec = 0.05f;
+        std::string error;
+        if (!source.executive.configure(config, error)) {
+            std::fprintf(stderr, "%s\n", error.c_str());
+            return 1;
+        }
+    }
+
+    // ImGui with no backend: fixed display size and time step, font atlas built here. Nothing
+    // is rendered; the draw data is only counted.
+    IMGUI_CHECKVERSION();
+    ImGui::CreateContext();
+    ImGui::StyleColorsDark();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = nullptr;
+    io.DisplaySize = ImVec2(width, height);
+    io.DeltaTime = (float)(1.0 / fps);
+    unsigned char* pixels = nullptr;
+    int atlas_w = 0, atlas_h = 0;
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &atlas_w, &atlas_h);
+    io.Fonts->SetTexID((ImTextureID)(intptr_t)1);
+
+    std::vector<BenchPanel> panels = {
+        {"MASTER WARNING/CAUTION", panelTitle(Panel::MASTER)},
+        {"ECAM E/WD", panelTitle(Panel::ECAM)},
+        {"PFD", panelTitle(Panel::PFD)},
+        {"F/CTL STATUS", panelTitle(Panel::FCTL)},
+        {"SENSOR OVERRIDE", panelTitle(Panel::CONTROL_INPUT)},
+        {"AUTOPILOT / FCU", panelTitle(Panel::AUTOPILOT)},
+        {"SIM OPERATION", panelTitle(Panel::SIM_OPERATION)},
+        {"AIRCRAFT SYSTEMS AND CONTROL", panelTitle(Panel::AIRCRAFT_SYSTEMS)},
+        {"SCENARIO", panelTitle(Panel::SCENARIO)},
+        {"EXECUTIVE", panelTitle(Panel::EXECUTIVE)},
+        {"PARAMETER HISTORY", panelTitle(Panel::HISTORY)},
+        {"AIRCRAFT SYSTEMS (deprecated)", "AIRCRAFT SYSTEMS"},
+    };
+    enum { MASTER, ECAM, PFD, FCTL, CONTROLS, AUTOPILOT, SIM_OP, SYSTEMS, SCENARIO, EXECUTIVE, HISTORY, SYSTEMS_OLD };
+
+    SimState sim;
+    source.start(sim);
+    ParamHistory history;
+    RateGroupStats frame_stats;
+    frame_stats.name = "DISPLAY";
+    frame_stats.rate_hz = (float)fps;
+
+    LatencyHistogram frame_ns;          // NewFrame .. Render, everything included
+    LatencyHistogram overhead_ns;       // NewFrame + Render alone
+    uint64_t total_vtx = 0, total_idx = 0, total_cmds = 0;
+    const double frame_sec = 1.0 / fps;
+
+    for (long n = 0; n < warmup + frames; ++n) {
+        bool measure = n >= warmup;
+        source.advance(sim, frame_sec);
+        history.record(sim);
+
+        auto frame_start = std::chrono::steady_clock::now();
+        ImGui::NewFrame();
+        BeginUiFrame();
+        double overhead = elapsedNs(frame_start);
+        // The history panel starts collapsed; measure it open
+        ImGui::SetWindowCollapsed(panelTitle(Panel::HISTORY), false);
+
+        auto timed = [&](int index, auto&& draw) {
+            auto start = std::chrono::steady_clock::now();
+            draw();
+            if (measure) {
+                panels[index].build_ns.record((uint64_t)elapsedNs(start));
+                ++panels[index].frames;
+            }
+        };
+        timed(MASTER, [&] { DrawMasterPanel(sim.alerts); });
+        timed(ECAM, [&] { DrawEcamPanel(sim.alerts, sim.sensors, sim.pilot, sim.faults, sim.prim, sim.flaps, sim.engines, sim.apu); });
+        timed(PFD, [&] { DrawPFDPanel(sim.sensors, sim.prim, sim.pilot, sim.autopilot, sim.faults); });
+        timed(FCTL, [&] { DrawFctlPanel(sim.prim, sim.faults); });
+        timed(CONTROLS, [&] { DrawControlInputPanel(sim.pilot, sim.sensors, sim.faults, sim.settings, sim.flaps); });
+        timed(AUTOPILOT, [&] { DrawAutopilotPanel(sim.autopilot, sim.sensors); });
+        timed(SIM_OP, [&] { DrawSimOperationPanel(sim.weather, sim.faults); });
+        timed(SYSTEMS, [&] {
+            DrawAircraftSystemsPanel(sim.pilot, sim.flaps, sim.trim, sim.speedbrakes, sim.gear, sim.timers, sim.hydraulics,
+                                     sim.engines, sim.apu, sim.alerts, sim.autopilot);
+        });
+        if (source.runner.active()) timed(SCENARIO, [&] { DrawScenarioPanel(source.runner, sim.time_sec); });
+        timed(EXECUTIVE, [&] { DrawExecutivePanel(source.executive, frame_stats, nullptr, nullptr); });
+        timed(HISTORY, [&] { DrawHistoryPanel(history); });
+        timed(SYSTEMS_OLD, [&] {
+            DrawSystemsPanel(sim.trim, sim.speedbrakes, sim.gear, sim.timers, sim.flight_phase, sim.hydraulics, sim.engines,
+                             sim.weather, sim.faults);
+        });
+
+        auto render_start = std::chrono::steady_clock::now();
+        ImGui::Render();
+        overhead += elapsedNs(render_start);
+        double frame_total = elapsedNs(frame_start);
+        frame_stats.record(frame_total * 1e-9);
+        if (!measure) continue;
+
+        frame_ns.record((uint64_t)frame_total);
+        overhead_ns.record((uint64_t)overhead);
+
+        // Attribute every draw list to the panel that owns it (child windows included)
+        const ImDrawData* draw_data = ImGui::GetDrawData();
+        total_vtx += (uint64_t)draw_data->TotalVtxCount;
+        total_idx += (uint64_t)draw_data->TotalIdxCount;
+        for (const ImDrawList* list : draw_data->CmdLists) {
+            total_cmds += (uint64_t)list->CmdBuffer.Size;
+            for (BenchPanel& panel : panels) {
+                if (!drawListOwnedBy(list, panel.title)) continue;
+                panel.vtx += (uint64_t)list->VtxBuffer.Size;
+                panel.idx += (uint64_t)list->IdxBuffer.Size;
+                panel.cmds += (uint64_t)list->CmdBuffer.Size;
+                panel.lists += 1;
+                panel.max_vtx = std::max(panel.max_vtx, (uint32_t)list->VtxBuffer.Size);
+                break;
+            }
+        }
+    }
+
+    std::printf("%ld frames at %.0f Hz sim time, %.0fx%.0f, %s; build time in us, counts per frame\n", frames, fps, width, height,
+                source.scripts.empty() ? "startup scenarios" : "scenario scripts");
+    std::printf("%-30s %7s %8s %8s %8s %8s %9s %9s %6s %8s\n", "panel", "frames", "mean", "p50", "p99", "max", "vtx", "idx", "cmds", "max vtx");
+    for (const BenchPanel& panel : panels) {
+        double per = panel.frames ? 1.0 / (double)panel.frames : 0.0;
+        printRow(panel.name, panel.build_ns, panel.frames, panel.vtx * per, panel.idx * per, panel.cmds * per, panel.max_vtx);
+    }
+    double per_frame = 1.0 / (double)frames;
+    printRow("ImGui NewFrame + Render", overhead_ns, (uint64_t)frames, 0.0, 0.0, 0.0, 0);
+    printRow("FRAME", frame_ns, (uint64_t)frames, total_vtx * per_frame, total_idx * per_frame, total_cmds * per_frame, 0);
+
+    if (csv_path) {
+        FILE* probe = std::fopen(csv_path, "r");
+        bool fresh = !probe;
+        if (probe) std::fclose(probe);
+        FILE* csv = std::fopen(csv_path, "a");
+        if (!csv) {
+            std::fprintf(stderr, "PRIM_uibench: cannot write %s\n", csv_path);
+            return 1;
+        }
+        if (fresh) std::fprintf(csv, "label,panel,frames,mean_us,p50_us,p99_us,max_us,vtx,idx,cmds\n");
+        auto row = [&](const char* name, const LatencyHistogram& h, uint64_t n, double vtx, double idx, double cmds) {
+            std::fprintf(csv, "%s,%s,%llu,%.3f,%.3f,%.3f,%.3f,%.1f,%.1f,%.2f\n", label, name, (unsigned long long)n,
+                         h.mean() / 1000.0, h.valueAtPercentile(50.0) / 1000.0, h.valueAtPercentile(99.0) / 1000.0,
+                         h.max() / 1000.0, vtx, idx, cmds);
+        };
+        for (const BenchPanel& panel : panels) {
+            double per = panel.frames ? 1.0 / (double)panel.frames : 0.0;
+            row(panel.name, panel.build_ns, panel.frames, panel.vtx * per, panel.idx * per, panel.cmds * per);
+        }
+        row("FRAME", frame_ns, (uint64_t)frames, total_vtx * per_frame, total_idx * per_frame, total_cmds * per_frame);
+        std::fclose(csv);
+    }
+
+    ImGui::DestroyContext();
+    return 0;
+}